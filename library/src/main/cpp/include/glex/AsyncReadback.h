@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * @file AsyncReadback.h
+ * @brief 基于 PBO 环与栅栏的异步帧缓冲回读
+ *
+ * glReadPixels 直接读到客户端内存时，驱动必须等 GPU 完成之前所有绘制，渲染线程会卡住数帧。
+ * AsyncReadback 把读取目标换成像素打包缓冲（GL_PIXEL_PACK_BUFFER）：
+ *   - request：在当前帧绘制完成后、交换前发起 glReadPixels 到空闲 PBO，并插入栅栏，立即返回
+ *   - poll：之后的帧上非阻塞检查栅栏，已完成的 PBO 才映射，拷入独立内存后立即解除映射
+ * 拷贝时同时把行序翻转为自上而下，结果内存可直接交给外部（如 NAPI 外部 ArrayBuffer）而无需再次拷贝。
+ *
+ * 所有方法须在持有 GL 上下文的线程调用。
+ *
+ * 用法（渲染线程）：
+ *   readback.poll(done);                      // 每帧调用，取回已完成的读取
+ *   ... 绘制 ...
+ *   readback.request(id, x, y, w, h);         // 环满时返回 false，下一帧再试
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+namespace glex {
+
+/**
+ * 一次回读的结果（RGBA8，行自上而下紧密排列）
+ */
+struct ReadbackImage {
+    uint64_t id = 0;
+    int width = 0;
+    int height = 0;
+    std::unique_ptr<uint8_t[]> pixels;   // 失败时为空
+
+    size_t byteLength() const { return static_cast<size_t>(width) * static_cast<size_t>(height) * 4; }
+};
+
+class AsyncReadback {
+public:
+    /** 默认 PBO 环大小 */
+    static constexpr size_t kDefaultSlots = 3;
+
+    explicit AsyncReadback(size_t slots = kDefaultSlots);
+    ~AsyncReadback() = default;
+
+    // 禁止拷贝
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+    /**
+     * 从当前绑定的读帧缓冲发起异步读取（GL 窗口坐标）
+     * @return 没有空闲 PBO 或区域无效时返回 false
+     */
+    bool request(uint64_t id, int x, int y, int width, int height);
+
+    /**
+     * 非阻塞取回已完成的读取（按发起顺序追加到 out）
+     * @return 本次取回的数量
+     */
+    size_t poll(std::vector<ReadbackImage>& out);
+
+    /** 是否有空闲 PBO */
+    bool hasFreeSlot() const;
+
+    /** 进行中的读取数 */
+    size_t getInFlightCount() const;
+
+    /** 删除全部 PBO 与栅栏（上下文销毁前调用；进行中的读取被丢弃） */
+    void release();
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        size_t capacity = 0;
+        uint64_t id = 0;
+        uint64_t order = 0;
+        int width = 0;
+        int height = 0;
+        bool busy = false;
+    };
+
+    bool resolve(Slot& slot, ReadbackImage& image);
+
+    std::vector<Slot> slots_;
+    uint64_t nextOrder_ = 0;
+};
+
+} // namespace glex
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file DamageRegion.h
+ * @brief 帧损坏区域
+ *
+ * 损坏区域描述本帧与上一帧画面不同的部分，用于局部呈现：
+ *   - RenderPass 上报自己的损坏矩形（RenderPass::collectDamage）
+ *   - RenderPipeline 合并为少量矩形（RenderPipeline::collectDamage）
+ *   - GLContext 结合缓冲区年龄计算需要重绘的区域，并以 swap-with-damage 呈现
+ *
+ * 坐标与 glScissor / EGL 损坏矩形一致：GL 窗口坐标，原点在左下角，单位像素。
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace glex {
+
+struct DamageRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool isEmpty() const { return width <= 0 || height <= 0; }
+};
+
+/** 两个矩形的包围盒（空矩形不参与） */
+DamageRect UnionDamage(const DamageRect& a, const DamageRect& b);
+
+/** 所有矩形的包围盒 */
+DamageRect BoundingDamage(const std::vector<DamageRect>& rects);
+
+/** 裁剪到 [0, width) x [0, height) */
+DamageRect ClipDamage(const DamageRect& rect, int width, int height);
+
+/**
+ * 裁剪并合并矩形：去掉空矩形，合并相交矩形，
+ * 仍超过 maxRects 时反复合并包围盒面积增量最小的一对
+ */
+void MergeDamage(std::vector<DamageRect>& rects, int width, int height, size_t maxRects);
+
+} // namespace glex
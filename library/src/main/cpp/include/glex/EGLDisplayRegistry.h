@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file EGLDisplayRegistry.h
+ * @brief 进程级 EGLDisplay 引用计数与 EGLConfig 缓存
+ *
+ * EGLDisplay 是进程级对象：同一进程内多个 GLContext 拿到的是同一个句柄，
+ * 任一实例 eglTerminate 都会让其他实例的上下文失效。注册表统一管理：
+ *   - acquire：首次使用时 eglInitialize，之后只增加引用计数
+ *   - release：只减少引用计数；计数归零后 Display 仍保持初始化，
+ *     页面返回后重建 Surface 时无需再次 eglInitialize
+ *   - chooseConfig：按属性列表缓存 eglChooseConfig 的结果
+ *   - terminateIdle：显式终止引用计数为 0 的 Display（如应用退到后台释放内存时）
+ *
+ * 所有方法线程安全。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <EGL/egl.h>
+
+namespace glex {
+
+/**
+ * 注册表统计
+ */
+struct EGLDisplayStats {
+    uint64_t initializations = 0;   // eglInitialize 次数
+    uint64_t terminations = 0;      // eglTerminate 次数
+    uint64_t configHits = 0;        // EGLConfig 缓存命中次数
+    uint64_t configMisses = 0;      // 实际调用 eglChooseConfig 的次数
+    int activeDisplays = 0;         // 引用计数大于 0 的 Display 数
+};
+
+class EGLDisplayRegistry {
+public:
+    static EGLDisplayRegistry& Get();
+
+    // 禁止拷贝
+    EGLDisplayRegistry(const EGLDisplayRegistry&) = delete;
+    EGLDisplayRegistry& operator=(const EGLDisplayRegistry&) = delete;
+
+    /**
+     * 增加 Display 引用（首次使用时 eglInitialize）
+     * @return 初始化失败返回 false，此时不持有引用
+     */
+    bool acquire(EGLDisplay display);
+
+    /** 释放 acquire 获得的引用（不会 eglTerminate） */
+    void release(EGLDisplay display);
+
+    /**
+     * 按属性列表选择配置（结果按 Display + 属性缓存；需先 acquire）
+     * @param attribs 以 EGL_NONE 结尾的属性列表
+     */
+    bool chooseConfig(EGLDisplay display, const EGLint* attribs, EGLConfig* config);
+
+    /**
+     * 终止引用计数为 0 的 Display 并清除其配置缓存
+     * @return 终止的 Display 数
+     */
+    int terminateIdle();
+
+    /** Display 当前引用计数 */
+    int getRefCount(EGLDisplay display) const;
+
+    EGLDisplayStats getStats() const;
+
+private:
+    EGLDisplayRegistry() = default;
+
+    struct Entry {
+        int refs = 0;
+        std::map<std::vector<EGLint>, EGLConfig> configs;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<EGLDisplay, Entry> displays_;
+    EGLDisplayStats stats_;
+};
+
+} // namespace glex
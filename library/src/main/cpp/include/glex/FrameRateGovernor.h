@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * @file FrameRateGovernor.h
+ * @brief 自适应帧率调节器
+ *
+ * 设备无法维持目标帧率时，与其每帧都迟到，不如稳定地降一档。
+ * 调节器按窗口（默认 60 帧）统计超预算比例与工作耗时 p90：
+ *   - 超预算帧占比达到阈值 → 沿阶梯降一档（如 120 → 90 → 60 → 45 → 30）
+ *   - 连续若干窗口 p90 远低于上一档预算且无迟到 → 升一档
+ * 降档后有冷却期；升档后很快又降档视为振荡，升档所需的稳定窗口数翻倍。
+ *
+ * onFrame() 仅在渲染线程调用；配置与档位记录可在任意线程读写。
+ *
+ * 用法（渲染线程）：
+ *   int fps = governor.onFrame(userTargetFps, workTime, missedDeadline);
+ *   scheduler.setTargetFPS(fps);
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace glex {
+
+/**
+ * 一次档位切换记录
+ */
+struct FrameRateStep {
+    int64_t timeMs = 0;            // 距调节器启用的毫秒数
+    int fromFps = 0;
+    int toFps = 0;
+    float workP90Ms = 0.0f;        // 触发切换的窗口内工作耗时 p90
+    float overBudgetRatio = 0.0f;  // 触发切换的窗口内超预算帧占比
+};
+
+class FrameRateGovernor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** 最多保留的档位切换记录数 */
+    static constexpr size_t kMaxSteps = 64;
+
+    struct Config {
+        std::vector<int> ladder{ 120, 90, 60, 45, 30 };  // 降序帧率阶梯
+        int windowFrames = 60;            // 统计窗口帧数
+        float downOverBudgetRatio = 0.2f; // 超预算帧占比 >= 此值时降档
+        float upHeadroom = 0.7f;          // p90 < 上一档预算 * 此值时视为稳定
+        int upStableWindows = 3;          // 升档所需连续稳定窗口数
+        int maxStableWindows = 24;        // 振荡退避的上限
+        std::chrono::milliseconds downCooldown{ 2000 };  // 降档后禁止升档的时间
+    };
+
+    FrameRateGovernor() = default;
+
+    // 禁止拷贝
+    FrameRateGovernor(const FrameRateGovernor&) = delete;
+    FrameRateGovernor& operator=(const FrameRateGovernor&) = delete;
+
+    /** 启用/禁用（重新启用时从用户目标帧率重新开始） */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /** 更新配置（阶梯会被排序去重；下一帧生效） */
+    void configure(const Config& config);
+    Config getConfig() const;
+
+    /**
+     * 报告一帧结果并返回接下来应使用的帧率（渲染线程）
+     * @param ceilingFps 用户设置的目标帧率（上限）
+     * @param workTime 本帧工作耗时（不含帧间等待）
+     * @param missedDeadline 本帧是否错过截止时间
+     */
+    int onFrame(int ceilingFps, Clock::duration workTime, bool missedDeadline);
+
+    /** 当前生效帧率（未启用或尚未运行时为 0） */
+    int getCurrentFPS() const { return currentFps_.load(std::memory_order_relaxed); }
+
+    /** 档位切换记录（按时间先后） */
+    std::vector<FrameRateStep> getSteps() const;
+
+private:
+    void restart(int ceilingFps, bool newSession);
+    void buildLevels(int ceilingFps);
+    void evaluateWindow();
+    void recordStep(int fromFps, int toFps, float p90Ms, float ratio);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<bool> restartPending_{false};
+    std::atomic<bool> configDirty_{false};
+    std::atomic<int> currentFps_{0};
+
+    mutable std::mutex configMutex_;
+    Config config_;
+
+    mutable std::mutex stepsMutex_;
+    std::vector<FrameRateStep> steps_;
+
+    // 仅渲染线程访问
+    Config active_;
+    std::vector<int> levels_;  // 不超过上限的可用档位（降序）
+    int ceilingFps_ = 0;
+    size_t level_ = 0;
+    std::vector<float> windowWorkMs_;
+    int windowOverBudget_ = 0;
+    int windowMissed_ = 0;
+    int stableWindows_ = 0;
+    int requiredStableWindows_ = 0;
+    Clock::time_point startTime_{};
+    Clock::time_point lastDownTime_{};
+    Clock::time_point lastUpTime_{};
+};
+
+} // namespace glex
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file FrameScheduler.h
+ * @brief 基于绝对截止时间的帧调度器
+ *
+ * 以纳秒精度的帧周期推进截止时间，避免 1000 / fps 取整带来的漂移。
+ * 配置了 VsyncSource 时对齐到 vsync 节拍，否则使用 sleep_until + 自旋收尾。
+ *
+ * 用法：
+ *   FrameScheduler scheduler;
+ *   scheduler.setTargetFPS(60);
+ *   scheduler.reset(FrameScheduler::Clock::now());
+ *   while (running) {
+ *       auto frameStart = scheduler.waitForNextFrame();
+ *       // ... 渲染一帧 ...
+ *   }
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "glex/VsyncSource.h"
+
+namespace glex {
+
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** sleep_until 提前醒来的自旋收尾时长 */
+    static constexpr std::chrono::microseconds kSpinTail{1000};
+
+    FrameScheduler() = default;
+
+    // 禁止拷贝
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /** 设置 vsync 源（nullptr 表示纯计时调度） */
+    void setVsyncSource(std::shared_ptr<VsyncSource> source) { vsync_ = std::move(source); }
+
+    const std::shared_ptr<VsyncSource>& getVsyncSource() const { return vsync_; }
+
+    /** 设置目标帧率（周期以纳秒计算，不取整到毫秒） */
+    void setTargetFPS(int fps);
+
+    /** 以给定时间作为第一帧的起点重新锚定截止时间，清零错帧计数并清除 vsync 源残留的中断 */
+    void reset(Clock::time_point now);
+
+    /** 以给定时间重新对齐截止时间（线程挂起后恢复时调用），保留错帧计数 */
+    void resync(Clock::time_point now) { deadline_ = now + period_; }
+
+    /**
+     * 等待到下一帧的截止时间
+     * @return 下一帧的起始时间（对齐到 vsync 时为 vsync 时间戳）
+     */
+    Clock::time_point waitForNextFrame();
+
+    /** 累计错过的截止时间数 */
+    uint64_t getMissedFrames() const { return missedFrames_.load(std::memory_order_relaxed); }
+
+    /** 当前帧周期 */
+    Clock::duration getPeriod() const { return period_; }
+
+    /** 高精度等待：sleep_until 到截止时间前 kSpinTail，剩余部分自旋 */
+    static void SleepUntil(Clock::time_point deadline);
+
+private:
+    Clock::time_point waitForVsyncAligned(Clock::time_point deadline);
+
+    std::shared_ptr<VsyncSource> vsync_;
+    Clock::duration period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(16666667));
+    int fps_ = 60;
+    Clock::time_point deadline_{};
+    std::atomic<uint64_t> missedFrames_{0};
+};
+
+} // namespace glex
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file FrameStats.h
+ * @brief 逐帧分阶段耗时统计
+ *
+ * 渲染线程将每帧各阶段耗时写入无锁环形缓冲区（单写者），
+ * 任意线程可随时汇总最近若干帧的 p50/p90/p99/max，用于发现被平均 FPS 掩盖的卡顿。
+ *
+ * 用法（渲染线程）：
+ *   recorder.beginFrame();
+ *   {
+ *       ScopedFramePhase phase(recorder, FramePhase::Update);
+ *       pipeline.update(dt);
+ *   }
+ *   recorder.endFrame();
+ *
+ * 用法（其他线程）：
+ *   FrameStatsSummary summary = recorder.summarize();
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace glex {
+
+/**
+ * 帧阶段
+ */
+enum class FramePhase : int {
+    TaskDrain = 0,  // 执行投递到渲染线程的任务
+    PassChanges,    // 应用 Pass / Shader / Uniform / 尺寸 / 触摸变更
+    Update,         // RenderPipeline::update
+    Render,         // 清屏 + RenderPipeline::render
+    Swap,           // eglSwapBuffers
+    GpuWait,        // 等待帧在途栅栏（GLContext::waitForFrameSlot）
+    Count
+};
+
+constexpr int kFramePhaseCount = static_cast<int>(FramePhase::Count);
+
+/** 阶段名称（用于导出） */
+const char* GetFramePhaseName(FramePhase phase);
+
+/**
+ * 单个阶段的分位统计（毫秒）
+ */
+struct PhaseStats {
+    float p50Ms = 0.0f;
+    float p90Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+};
+
+/**
+ * 最近若干帧的汇总
+ */
+struct FrameStatsSummary {
+    int sampleCount = 0;
+    PhaseStats phases[kFramePhaseCount];
+    PhaseStats frame;  // 整帧工作耗时（不含帧间等待）
+};
+
+class FrameStatsRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** 环形缓冲区容量（帧数，2 的幂） */
+    static constexpr size_t kCapacity = 512;
+
+    FrameStatsRecorder() = default;
+
+    // 禁止拷贝
+    FrameStatsRecorder(const FrameStatsRecorder&) = delete;
+    FrameStatsRecorder& operator=(const FrameStatsRecorder&) = delete;
+
+    /** 开始记录新的一帧（渲染线程） */
+    void beginFrame();
+
+    /** 累加某阶段耗时（渲染线程） */
+    void addPhase(FramePhase phase, Clock::duration duration);
+
+    /** 结束当前帧并发布到环形缓冲区（渲染线程） */
+    void endFrame();
+
+    /** 汇总最近的帧（任意线程） */
+    FrameStatsSummary summarize() const;
+
+    /** 清空统计（仅在渲染线程未运行时调用） */
+    void reset();
+
+private:
+    static constexpr int kValueCount = kFramePhaseCount + 1;
+
+    struct Slot {
+        std::atomic<uint32_t> seq{0};
+        std::atomic<float> valuesMs[kValueCount] = {};
+    };
+
+    Slot slots_[kCapacity];
+    std::atomic<uint64_t> published_{0};
+
+    // 仅渲染线程访问
+    Clock::time_point frameStart_{};
+    Clock::duration current_[kFramePhaseCount] = {};
+};
+
+/**
+ * RAII 阶段计时：析构时把耗时累加到 recorder
+ */
+class ScopedFramePhase {
+public:
+    ScopedFramePhase(FrameStatsRecorder& recorder, FramePhase phase)
+        : recorder_(recorder), phase_(phase), start_(FrameStatsRecorder::Clock::now()) {}
+
+    ~ScopedFramePhase()
+    {
+        recorder_.addPhase(phase_, FrameStatsRecorder::Clock::now() - start_);
+    }
+
+    ScopedFramePhase(const ScopedFramePhase&) = delete;
+    ScopedFramePhase& operator=(const ScopedFramePhase&) = delete;
+
+private:
+    FrameStatsRecorder& recorder_;
+    FramePhase phase_;
+    FrameStatsRecorder::Clock::time_point start_;
+};
+
+} // namespace glex
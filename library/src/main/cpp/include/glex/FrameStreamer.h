@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file FrameStreamer.h
+ * @brief 连续帧流式采集（录屏）
+ *
+ * 每帧在绘制完成、交换之前：
+ *   1. 以 glBlitFramebuffer（线性过滤）把当前画面缩放到配置尺寸的离屏 FBO（GPU 上完成）
+ *   2. 经 AsyncReadback 的 PBO 环异步读取，之后的帧上取回（不等待 GPU）
+ *   3. 取回的帧推入有界无锁 SPSC 队列，由工作线程交给消费回调
+ * 渲染线程从不阻塞：PBO 全部在途时本帧不采集（droppedGpuBusy），队列满时丢弃该帧
+ * （droppedQueueFull），消费回调拒收时计入 droppedByConsumer。
+ *
+ * 用法：
+ *   streamer.start(config, [](StreamFrame&& frame) { encode(frame); return true; });  // 任意线程
+ *   streamer.captureFrame(width, height);    // 渲染线程，每帧绘制后
+ *   streamer.releaseGpu();                   // 渲染线程，停止前
+ *   streamer.stop();                         // 任意线程（非渲染线程），等待工作线程退出
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <GLES3/gl3.h>
+
+#include "glex/AsyncReadback.h"
+#include "glex/SpscRing.h"
+
+namespace glex {
+
+/**
+ * 采集配置
+ */
+struct StreamConfig {
+    int width = 0;              // 输出宽度，0 表示按高度等比或与画面相同
+    int height = 0;             // 输出高度，0 表示按宽度等比或与画面相同
+    size_t queueCapacity = 8;   // 待消费帧队列容量（恰好容纳这么多帧，超出即计入 droppedQueueFull）
+    size_t readbackSlots = 4;   // PBO 环大小（在途帧上限）
+};
+
+/**
+ * 一帧采集结果（RGBA8，行自上而下紧密排列）
+ */
+struct StreamFrame {
+    uint64_t seq = 0;
+    int64_t timestampNs = 0;    // 采集时刻（steady_clock）
+    int width = 0;
+    int height = 0;
+    std::unique_ptr<uint8_t[]> pixels;
+
+    size_t byteLength() const { return static_cast<size_t>(width) * static_cast<size_t>(height) * 4; }
+};
+
+/**
+ * 采集统计（累计）
+ */
+struct StreamStats {
+    uint64_t captured = 0;           // 发起读取的帧数
+    uint64_t delivered = 0;          // 消费回调接收的帧数
+    uint64_t droppedGpuBusy = 0;     // PBO 全部在途而未采集的帧数
+    uint64_t droppedQueueFull = 0;   // 队列满而丢弃的帧数
+    uint64_t droppedByConsumer = 0;  // 消费回调拒收的帧数
+
+    uint64_t dropped() const { return droppedGpuBusy + droppedQueueFull + droppedByConsumer; }
+};
+
+class FrameStreamer {
+public:
+    /** 消费回调（工作线程）；返回 false 表示拒收（计入 droppedByConsumer） */
+    using Consumer = std::function<bool(StreamFrame&& frame)>;
+
+    FrameStreamer() = default;
+    ~FrameStreamer();
+
+    // 禁止拷贝
+    FrameStreamer(const FrameStreamer&) = delete;
+    FrameStreamer& operator=(const FrameStreamer&) = delete;
+
+    /** 启动工作线程（已在运行时返回 false） */
+    bool start(const StreamConfig& config, Consumer consumer);
+
+    /** 停止并等待工作线程退出，队列中未消费的帧被丢弃（不能在消费回调中调用） */
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * 采集当前读帧缓冲（渲染线程，绘制完成后、交换之前）
+     * @param sourceWidth / sourceHeight 当前画面尺寸
+     */
+    void captureFrame(int sourceWidth, int sourceHeight);
+
+    /** 删除 FBO 与 PBO（渲染线程；在途帧被丢弃） */
+    void releaseGpu();
+
+    StreamStats getStats() const;
+
+private:
+    void computeOutputSize(int sourceWidth, int sourceHeight, int* width, int* height) const;
+    bool ensureTarget(int width, int height);
+    void collect();
+    void workerLoop();
+
+    StreamConfig config_;
+    Consumer consumer_;
+    std::atomic<bool> running_{false};
+
+    // 渲染线程
+    std::unique_ptr<AsyncReadback> readback_;
+    std::deque<std::pair<uint64_t, int64_t>> inFlight_;   // 在途帧的序号与时间戳（按发起顺序）
+    GLuint fbo_ = 0;
+    GLuint colorRb_ = 0;
+    int targetWidth_ = 0;
+    int targetHeight_ = 0;
+    uint64_t nextSeq_ = 0;
+
+    // 渲染线程 -> 工作线程
+    std::unique_ptr<SpscRing<StreamFrame>> queue_;
+    std::thread worker_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    bool stopRequested_ = false;
+
+    std::atomic<uint64_t> captured_{0};
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> droppedGpuBusy_{0};
+    std::atomic<uint64_t> droppedQueueFull_{0};
+    std::atomic<uint64_t> droppedByConsumer_{0};
+};
+
+} // namespace glex
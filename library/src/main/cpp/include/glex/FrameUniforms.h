@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file FrameUniforms.h
+ * @brief 每个实例自有的逐帧 uniform 缓冲（UBO）
+ *
+ * 共享组中的程序对象被多个实例（可能在不同线程的上下文上）同时使用，而普通 uniform 的值
+ * 属于程序对象：即便持有 lockForDraw()，释放锁后另一上下文改写的值是否影响已提交但尚未执行的
+ * 绘制，取决于驱动是否在绘制时快照 uniform。逐实例变化的值（投影、时间、插值系数）因此改放到
+ * uniform 块 GlexFrame 中：
+ *   - 程序只记录块到绑定点 kBinding 的映射（所有实例写入同一个值，只在初始化时设置一次）
+ *   - 每个实例各自持有一个 UBO，绘制前写入并绑定到当前上下文的 kBinding
+ * 绑定点属于上下文状态，缓冲属于实例，不再有跨上下文共享的可变状态。
+ *
+ * 着色器中声明（std140 布局，与 FrameUniformData 一致）：
+ *   layout(std140) uniform GlexFrame {
+ *       mat4 u_projection;
+ *       float u_time;
+ *       float u_alpha;
+ *   };
+ *
+ * 所有方法须在持有 GL 上下文的线程调用。
+ */
+
+#include <GLES3/gl3.h>
+
+#include "glex/ShaderProgram.h"
+
+namespace glex {
+
+/** GlexFrame 块的 std140 内存布局 */
+struct FrameUniformData {
+    float projection[16] = {};
+    float time = 0.0f;
+    float alpha = 1.0f;
+    float padding[2] = {};
+};
+
+class FrameUniforms {
+public:
+    /** GlexFrame 块使用的绑定点 */
+    static constexpr GLuint kBinding = 0;
+
+    /** uniform 块名 */
+    static constexpr const char* kBlockName = "GlexFrame";
+
+    FrameUniforms() = default;
+    ~FrameUniforms() = default;
+
+    // 禁止拷贝
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    /** 把程序中的 GlexFrame 块映射到 kBinding（程序不含该块时返回 false） */
+    static bool BindProgram(const ShaderProgram& program);
+
+    /** 创建 UBO */
+    bool initialize();
+
+    /** 写入本帧的值并绑定到当前上下文的 kBinding */
+    void upload(const FrameUniformData& data);
+
+    /** 删除 UBO */
+    void release();
+
+private:
+    GLuint ubo_ = 0;
+};
+
+} // namespace glex
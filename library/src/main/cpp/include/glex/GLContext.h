@@ -12,16 +12,58 @@
  *   ctx.initialize(nativeWindow);
  *   // ... 渲染循环 ...
  *   ctx.destroy();
+ *
+ * 更换窗口（旋转、多窗口、页面重新显示）时无需重建上下文：
+ *   ctx.releaseSurface();          // 旧窗口销毁时（可选）
+ *   ctx.replaceSurface(newWindow); // 只重建 EGLSurface，GL 对象全部保留
+ *
+ * 局部呈现（绘制前声明本帧损坏区域，见 DamageRegion.h）：
+ *   DamageRect repaint;
+ *   if (ctx.beginFrame(&damage, &repaint)) { glScissor(repaint...); }   // 只重绘 repaint
+ *   ... 绘制 ...
+ *   ctx.swapBuffers();   // 支持时以 eglSwapBuffersWithDamage 呈现；损坏为空时跳过交换
+ * 需要 EGL_EXT_buffer_age 才能只重绘部分区域；另外支持时使用
+ * EGL_KHR_swap_buffers_with_damage（或 EXT）与 EGL_KHR_partial_update，不支持时整帧重绘。
+ *
+ * 帧在途上限（限制 CPU 领先 GPU 的帧数，缩短输入到显示的延迟）：
+ *   ctx.setMaxFramesInFlight(2);   // 1 - 3，0 表示不限制（默认）
+ *   ctx.waitForFrameSlot();        // 帧开始、读取输入前：等待 N 帧前插入的栅栏
+ *   ... 绘制 ...
+ *   ctx.swapBuffers();             // 交换前为本帧插入 glFenceSync
+ * N 越小延迟越低，但 CPU 与 GPU 重叠越少、吞吐越低。
+ *
+ * 离屏模式（无窗口，用于 Linux 上的 Pass 回归与帧耗时基准）：
+ *   GLContext ctx;
+ *   ctx.initializeOffscreen(1280, 720);   // pbuffer，失败时回退 surfaceless（Mesa llvmpipe 可用）
+ *   // ... 与窗口模式相同的渲染循环，绘制结果落在离屏 FBO 中 ...
+ *   ctx.readPixels(rgba);
+ *
+ * 离屏模式下 makeCurrent 会绑定离屏 FBO，swapBuffers 只做 glFlush；
+ * Pass 只要不显式绑定 0 号 framebuffer 即可无修改运行。
+ *
+ * EGLDisplay 与 EGLConfig 由 EGLDisplayRegistry 在进程内引用计数与缓存：
+ * destroy() 只释放引用而不 eglTerminate，避免影响同进程的其他实例。
+ *
+ * 共享组：config.shareGroup 非空时使用共享组的 Display，并以其根上下文为 share_context
+ * 创建上下文，着色器程序 / 缓冲 / 纹理在组内可见（见 ShareGroup.h）。
  */
 
 #include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 #include <GLES3/gl3.h>
 
+#include "glex/DamageRegion.h"
+
 namespace glex {
 
+class ShareGroup;
+
 /**
  * EGL 配置选项
  */
@@ -33,6 +75,7 @@ struct GLContextConfig {
     int depthSize = 16;
     int stencilSize = 0;
     bool vsyncEnabled = true;
+    std::shared_ptr<ShareGroup> shareGroup;   // 非空时加入该共享组
 };
 
 class GLContext {
@@ -52,6 +95,14 @@ public:
      */
     bool initialize(EGLNativeWindowType window, const GLContextConfig& config = {});
 
+    /**
+     * 初始化离屏上下文（pbuffer 或 surfaceless EGL + FBO，要求 ES 3.0+）
+     * @param width 离屏渲染目标宽度（像素）
+     * @param height 离屏渲染目标高度（像素）
+     * @return 成功返回 true，初始化后上下文在调用线程上处于绑定状态
+     */
+    bool initializeOffscreen(int width, int height, const GLContextConfig& config = {});
+
     /**
      * 销毁 EGL 上下文和所有资源
      */
@@ -60,12 +111,96 @@ public:
     /** 绑定当前线程的 EGL 上下文 */
     bool makeCurrent();
 
+    /**
+     * 为新窗口创建 EGLSurface 并替换当前 Surface，上下文与 GL 对象保持不变
+     * 需在上下文绑定的线程调用，或上下文未在任何线程绑定时调用；
+     * 调用前已绑定则替换后仍绑定，否则替换后解绑
+     * @return 新窗口与当前配置不兼容等失败时返回 false，原 Surface 保持不变
+     */
+    bool replaceSurface(EGLNativeWindowType window);
+
+    /**
+     * 销毁窗口 Surface 但保留上下文（窗口已销毁、新窗口尚未到来时调用）
+     * 之后 makeCurrent 失败，直到 replaceSurface
+     */
+    void releaseSurface();
+
+    /** 是否有可绘制的目标（窗口 Surface 或离屏 FBO） */
+    bool hasSurface() const { return offscreen_ || surface_ != EGL_NO_SURFACE; }
+
     /** 解绑当前线程的 EGL 上下文 */
     void clearCurrent();
 
-    /** 交换前后缓冲区 */
+    /** 交换前后缓冲区（本帧经 beginFrame 声明了损坏区域时按局部呈现） */
     bool swapBuffers();
 
+    /**
+     * 声明本帧损坏区域（需在上下文绑定后、绘制前调用；不调用时整帧呈现）
+     * @param damage 与上一帧不同的区域（GL 窗口坐标），nullptr 表示整帧
+     * @param repaint 输出本帧需要重绘的区域：按缓冲区年龄并入此前几帧的损坏；
+     *                为空表示画面无变化，无需绘制（swapBuffers 将跳过交换）
+     * @return true 表示只需重绘 repaint 区域；false 表示需要整帧重绘
+     */
+    bool beginFrame(const std::vector<DamageRect>* damage, DamageRect* repaint);
+
+    /** 局部呈现相关扩展（initialize 后有效） */
+    bool isBufferAgeSupported() const { return bufferAgeSupported_; }
+    bool isSwapWithDamageSupported() const { return swapWithDamage_ != nullptr; }
+    bool isPartialUpdateSupported() const { return setDamageRegion_ != nullptr; }
+
+    /** 以局部呈现提交的帧数 / 因画面无变化跳过的交换次数（累计） */
+    uint64_t getPartialFrameCount() const { return partialFrames_.load(std::memory_order_relaxed); }
+    uint64_t getSkippedSwapCount() const { return skippedSwaps_.load(std::memory_order_relaxed); }
+
+    /** 帧在途上限的最大值 */
+    static constexpr int kMaxFramesInFlightLimit = 3;
+
+    /**
+     * 设置帧在途上限（任意线程可调用，下一帧生效）
+     * @param frames 1 - kMaxFramesInFlightLimit；0 表示不限制
+     */
+    void setMaxFramesInFlight(int frames);
+    int getMaxFramesInFlight() const { return maxFramesInFlight_.load(std::memory_order_relaxed); }
+
+    /**
+     * 等待在途帧数降到上限以下（帧开始时在上下文绑定的线程调用；不限制时立即返回）
+     * @return 本次阻塞等待 GPU 的时间（纳秒）
+     */
+    int64_t waitForFrameSlot();
+
+    /**
+     * 非阻塞检查帧槽位：以 0 超时轮询并删除已完成的栅栏，在途帧数低于上限时返回 true
+     * （共享调度器据此跳过 GPU 未追上的实例，避免阻塞同一工作线程上的其他实例）
+     */
+    bool pollFrameSlot();
+
+    /** 累计等待 GPU 的时间（纳秒）/ 发生等待的帧数 */
+    uint64_t getGpuWaitNs() const { return gpuWaitNs_.load(std::memory_order_relaxed); }
+    uint64_t getGpuWaitFrames() const { return gpuWaitFrames_.load(std::memory_order_relaxed); }
+
+    /** 是否为离屏上下文 */
+    bool isOffscreen() const { return offscreen_; }
+
+    /** 是否为 surfaceless 离屏上下文 */
+    bool isSurfaceless() const { return offscreen_ && surface_ == EGL_NO_SURFACE; }
+
+    EGLDisplay getEGLDisplay() const { return display_; }
+    EGLContext getEGLContext() const { return context_; }
+
+    /** 所在共享组（未加入时为空） */
+    const std::shared_ptr<ShareGroup>& getShareGroup() const { return shareGroup_; }
+
+    /** 离屏 FBO（窗口模式为 0） */
+    GLuint getFramebuffer() const { return fbo_; }
+
+    /** 调整离屏渲染目标尺寸（需在上下文绑定的线程调用） */
+    bool resizeOffscreen(int width, int height);
+
+    /**
+     * 读回当前渲染目标为 RGBA8（自下而上逐行，需在上下文绑定的线程调用）
+     */
+    bool readPixels(std::vector<uint8_t>& rgba);
+
     /** 设置垂直同步 */
     void setVSyncEnabled(bool enabled);
 
@@ -98,12 +233,20 @@ public:
     }
 
 private:
-    bool chooseConfig(const GLContextConfig& config);
+    bool openDisplay(EGLDisplay display);
+    bool chooseConfig(const GLContextConfig& config, EGLint surfaceType);
+    bool useShareGroup(const GLContextConfig& config, EGLint surfaceType);
+    bool createContext();
+    void queryGLInfo();
+    void queryPresentExtensions();
+    bool createOffscreenTarget(int width, int height, const GLContextConfig& config);
+    void destroyOffscreenTarget();
 
     EGLDisplay display_ = EGL_NO_DISPLAY;
     EGLSurface surface_ = EGL_NO_SURFACE;
     EGLContext context_ = EGL_NO_CONTEXT;
     EGLConfig eglConfig_ = nullptr;
+    std::shared_ptr<ShareGroup> shareGroup_;
 
     std::atomic<int> width_{0};
     std::atomic<int> height_{0};
@@ -112,6 +255,37 @@ private:
     std::string glVersionStr_{"unknown"};
     std::string glRendererStr_{"unknown"};
     bool initialized_ = false;
+    bool vsyncEnabled_ = true;
+
+    // 局部呈现
+    using SwapWithDamageProc = EGLBoolean (*)(EGLDisplay, EGLSurface, const EGLint*, EGLint);
+    using SetDamageRegionProc = EGLBoolean (*)(EGLDisplay, EGLSurface, EGLint*, EGLint);
+    static constexpr size_t kMaxDamageHistory = 4;
+    bool bufferAgeSupported_ = false;
+    SwapWithDamageProc swapWithDamage_ = nullptr;
+    SetDamageRegionProc setDamageRegion_ = nullptr;
+    bool framePartial_ = false;
+    std::vector<DamageRect> frameDamage_;
+    std::vector<EGLint> swapRects_;
+    std::deque<DamageRect> damageHistory_;   // 已呈现帧的损坏包围盒，[0] 为上一帧
+    int historyWidth_ = 0;
+    int historyHeight_ = 0;
+    std::atomic<uint64_t> partialFrames_{0};
+    std::atomic<uint64_t> skippedSwaps_{0};
+
+    // 帧在途上限：每帧交换前插入的栅栏，[0] 为最早的一帧；GPU 挂起时最多等待 1 秒
+    static constexpr GLuint64 kFenceTimeoutNs = 1000000000ull;
+    std::atomic<int> maxFramesInFlight_{0};
+    std::deque<GLsync> frameFences_;
+    std::atomic<uint64_t> gpuWaitNs_{0};
+    std::atomic<uint64_t> gpuWaitFrames_{0};
+
+    // 离屏模式
+    bool offscreen_ = false;
+    GLuint fbo_ = 0;
+    GLuint colorRb_ = 0;
+    GLuint depthRb_ = 0;
+    GLenum depthFormat_ = 0;
 };
 
 } // namespace glex
@@ -15,6 +15,23 @@
  *   - RenderPass: 渲染阶段抽象
  *   - RenderPipeline: 多阶段渲染管线
  *   - RenderThread: 独立渲染线程
+ *   - FrameScheduler / VsyncSource: 帧调度与 vsync 节拍
+ *   - FrameStatsRecorder: 逐帧分阶段耗时统计
+ *   - FrameRateGovernor: 自适应帧率调节
+ *   - JobSystem: 工作窃取任务系统（parallelFor / 任务依赖）
+ *   - ThreadPolicy: 线程亲和性与调度优先级
+ *   - SharedRenderScheduler: 多实例共享渲染线程
+ *   - ShareGroup: 多实例共享着色器程序与静态缓冲
+ *   - FrameUniforms: 逐实例的 uniform 缓冲（共享程序的逐帧参数）
+ *   - EGLDisplayRegistry: 进程级 EGLDisplay 引用计数与配置缓存
+ *   - DamageRegion: 局部呈现的损坏区域合并
+ *   - PassProfiler: 逐 Pass CPU / GPU 耗时剖析与 Chrome Trace 导出
+ *   - GpuTimer: 可分段共用的 GPU 计时查询流
+ *   - AsyncReadback: PBO 环 + 栅栏的异步帧缓冲回读
+ *   - FrameStreamer: GPU 缩放 + PBO 轮转 + 无锁队列的连续帧采集
+ *   - SpscRing: 有界无锁单生产者单消费者队列
+ *   - ResolutionScaler: 按 GPU 帧耗时调节的动态分辨率
+ *   - TouchInput: 无丢失的带时间戳触摸队列与多指状态表
  *
  * @author 云深
  * @version 1.0.2
@@ -25,6 +42,24 @@
 #include "glex/RenderPass.h"
 #include "glex/RenderPipeline.h"
 #include "glex/RenderThread.h"
+#include "glex/FrameScheduler.h"
+#include "glex/VsyncSource.h"
+#include "glex/FrameStats.h"
+#include "glex/FrameRateGovernor.h"
+#include "glex/JobSystem.h"
+#include "glex/ThreadPolicy.h"
+#include "glex/SharedRenderScheduler.h"
+#include "glex/ShareGroup.h"
+#include "glex/FrameUniforms.h"
+#include "glex/EGLDisplayRegistry.h"
+#include "glex/DamageRegion.h"
+#include "glex/PassProfiler.h"
+#include "glex/GpuTimer.h"
+#include "glex/AsyncReadback.h"
+#include "glex/FrameStreamer.h"
+#include "glex/SpscRing.h"
+#include "glex/ResolutionScaler.h"
+#include "glex/TouchInput.h"
 #include "glex/Log.h"
 
 #define GLEX_VERSION_MAJOR 1
@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file GpuTimer.h
+ * @brief GPU 计时查询（EXT_disjoint_timer_query）
+ *
+ * GL_TIME_ELAPSED_EXT 查询不能嵌套，同一上下文内的多个使用者（ResolutionScaler 的整帧计时、
+ * PassProfiler 的逐 Pass 计时）因此共用一条查询流，一帧被切成首尾相接的若干段：
+ *   - beginFrame：开始一段未标记的查询
+ *   - beginSegment / endSegment(tag)：结束当前段并开始标记段；标记段结束后接上新的未标记段
+ *   - endFrame：结束最后一段
+ * 各段耗时之和即整帧 GPU 耗时（交给帧回调），标记段的耗时另交给段回调。
+ * 没有进行中的帧时 beginSegment 单独计时一段。
+ *
+ * 查询对象循环复用；结果在之后几帧由 collect 非阻塞取回（按提交顺序完成），从不等待 GPU。
+ * 发生 disjoint（计时期间 GPU 频率变化或被抢占）时丢弃全部进行中的结果。
+ *
+ * 所有方法须在持有 GL 上下文的线程调用。
+ *
+ * 用法（渲染线程）：
+ *   timer.collect();                       // 每帧调用，回调已完成的结果
+ *   timer.beginFrame(frameIndex);
+ *   if (timer.beginSegment()) { ... ; timer.endSegment(tag); }
+ *   timer.endFrame();
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+namespace glex {
+
+class GpuTimer {
+public:
+    /** 未取回结果的查询上限，超出后不再开始新的帧 / 单独段 */
+    static constexpr size_t kDefaultMaxPending = 64;
+
+    /** 不属于任何帧的单独段 */
+    static constexpr uint64_t kNoFrame = UINT64_MAX;
+
+    /** 标记段的结果：tag 为 endSegment 传入的值 */
+    using SegmentSink = std::function<void(uint64_t tag, int64_t ns)>;
+
+    /** 整帧的结果：frame 为 beginFrame 传入的值 */
+    using FrameSink = std::function<void(uint64_t frame, int64_t ns)>;
+
+    explicit GpuTimer(size_t maxPending = kDefaultMaxPending) : maxPending_(maxPending) {}
+    ~GpuTimer() = default;
+
+    // 禁止拷贝
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /** 当前上下文是否支持计时查询（首次调用时检测扩展） */
+    bool isSupported();
+
+    /** 已检测且支持（不触发检测） */
+    bool isKnownSupported() const { return supported_ == 1; }
+
+    void setSegmentSink(SegmentSink sink) { segmentSink_ = std::move(sink); }
+    void setFrameSink(FrameSink sink) { frameSink_ = std::move(sink); }
+
+    /** 开始一帧（不支持、已有进行中的查询或待取回的查询过多时返回 false） */
+    bool beginFrame(uint64_t frame);
+
+    /** 结束一帧 */
+    void endFrame();
+
+    bool isFrameActive() const { return frameActive_; }
+
+    /** 开始一个标记段（不能嵌套；无法计时时返回 false，此时不要调用 endSegment） */
+    bool beginSegment();
+
+    /** 结束标记段 */
+    void endSegment(uint64_t tag);
+
+    /** 取回已完成的查询并回调（不阻塞） */
+    void collect();
+
+    /** 丢弃全部已提交、尚未取回的结果 */
+    void discardPending();
+
+    /** 删除全部查询对象（上下文销毁前调用；之后重新检测扩展） */
+    void release();
+
+private:
+    struct Pending {
+        GLuint query = 0;
+        uint64_t frame = kNoFrame;
+        uint64_t tag = 0;
+        bool tagged = false;
+        bool last = false;      // 帧的最后一段
+        bool discard = false;
+    };
+
+    void startQuery();
+    void finishQuery(uint64_t tag, bool tagged, bool last);
+
+    size_t maxPending_;
+    int supported_ = -1;        // -1 未检测，0 不支持，1 支持
+    std::vector<GLuint> freeQueries_;
+    std::deque<Pending> pending_;
+
+    // 提交侧
+    GLuint activeQuery_ = 0;
+    uint64_t activeFrame_ = kNoFrame;
+    bool frameActive_ = false;
+    bool segmentActive_ = false;
+
+    // 取回侧：正在累加的帧
+    bool accumulating_ = false;
+    bool frameDiscarded_ = false;
+    int64_t frameSumNs_ = 0;
+
+    SegmentSink segmentSink_;
+    FrameSink frameSink_;
+};
+
+} // namespace glex
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file JobSystem.h
+ * @brief 工作窃取任务系统
+ *
+ * 进程内单例，工作线程数 = 硬件线程数 - 1（调用方线程在等待时也参与执行）。
+ *   - 每个工作线程持有自己的双端队列：本线程从尾部取（LIFO，缓存友好），
+ *     空闲线程从其他队列头部窃取（FIFO）
+ *   - submit 支持依赖：所有依赖完成后任务才会入队
+ *   - wait 不阻塞空转，而是帮忙执行队列中的任务，因此可在任务内部嵌套调用；
+ *     无任务可帮时短暂自旋后挂起，直到目标任务完成或有新任务入队
+ *   - parallelFor 将区间切成块，由调用方与工作线程共同领取
+ *
+ * 用法：
+ *   JobSystem& jobs = JobSystem::Get();
+ *   JobHandle a = jobs.submit([]() { stepA(); });
+ *   JobHandle b = jobs.submit([]() { stepB(); }, { a });  // b 在 a 之后执行
+ *   jobs.wait(b);
+ *
+ *   jobs.parallelFor(0, particles.size(), 256, [&](size_t begin, size_t end) {
+ *       for (size_t i = begin; i < end; i++) { ... }
+ *   });
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "glex/Task.h"
+
+namespace glex {
+
+namespace detail {
+
+struct JobState {
+    Task fn;
+    std::atomic<int> remainingDeps{0};
+    std::atomic<bool> done{false};
+    std::mutex mutex;
+    std::vector<std::shared_ptr<JobState>> dependents;
+};
+
+} // namespace detail
+
+/**
+ * 任务句柄（可拷贝；空句柄视为已完成）
+ */
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    bool isDone() const { return !state_ || state_->done.load(std::memory_order_acquire); }
+    bool isValid() const { return state_ != nullptr; }
+
+private:
+    friend class JobSystem;
+    explicit JobHandle(std::shared_ptr<detail::JobState> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<detail::JobState> state_;
+};
+
+class JobSystem {
+public:
+    static JobSystem& Get();
+
+    ~JobSystem();
+
+    // 禁止拷贝
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /** 工作线程数（不含调用方线程；单核设备上为 0，任务在 wait 时内联执行） */
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    /** 提交任务，所有依赖完成后才会被调度 */
+    JobHandle submit(Task fn, std::initializer_list<JobHandle> deps = {});
+    JobHandle submit(Task fn, const std::vector<JobHandle>& deps);
+
+    /** 等待任务完成（期间帮忙执行其他任务） */
+    void wait(const JobHandle& handle);
+    void waitAll(const std::vector<JobHandle>& handles);
+
+    /**
+     * 按工作线程数切分 count 个元素的块大小：调用方与每个工作线程各领一块，
+     * 但每块不少于 minGrain 个元素（元素太少时不切分，避免调度开销超过计算本身）
+     */
+    size_t grainFor(size_t count, size_t minGrain) const
+    {
+        size_t lanes = workers_.size() + 1;
+        size_t grain = (count + lanes - 1) / lanes;
+        return grain > minGrain ? grain : minGrain;
+    }
+
+    /**
+     * 并行遍历 [begin, end)，每块不超过 grain 个元素，返回时所有块均已完成
+     * @param fn 可调用对象 void(size_t chunkBegin, size_t chunkEnd)
+     */
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, size_t grain, F&& fn)
+    {
+        using Fn = std::remove_reference_t<F>;
+        parallelForImpl(begin, end, grain,
+            [](void* ctx, size_t b, size_t e) { (*static_cast<Fn*>(ctx))(b, e); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+private:
+    using RangeFn = void (*)(void* ctx, size_t begin, size_t end);
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<detail::JobState>> jobs;
+    };
+
+    JobSystem();
+
+    void workerLoop(size_t index);
+    void schedule(std::shared_ptr<detail::JobState> job);
+    bool tryRunOne(size_t preferredQueue);
+    std::shared_ptr<detail::JobState> popLocal(size_t index);
+    std::shared_ptr<detail::JobState> steal(size_t thief);
+    void execute(const std::shared_ptr<detail::JobState>& job);
+    void wakeWaiters();
+    void parallelForImpl(size_t begin, size_t end, size_t grain, RangeFn fn, void* ctx);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<int> queued_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<int> sleepers_{0};
+
+    // wait 中挂起的线程：任务完成或新任务入队时唤醒
+    std::mutex waitMutex_;
+    std::condition_variable waitCv_;
+    std::atomic<int> waiters_{0};
+};
+
+} // namespace glex
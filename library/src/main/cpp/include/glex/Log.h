@@ -1,5 +1,7 @@
 #pragma once
 
+#if defined(OHOS_PLATFORM) || __has_include(<hilog/log.h>)
+
 #include <hilog/log.h>
 
 #ifndef GLEX_LOG_DOMAIN
@@ -14,3 +16,37 @@
 #define GLEX_LOGW(fmt, ...) OH_LOG_Print(LOG_APP, LOG_WARN, GLEX_LOG_DOMAIN, GLEX_LOG_TAG, fmt, ##__VA_ARGS__)
 #define GLEX_LOGE(fmt, ...) OH_LOG_Print(LOG_APP, LOG_ERROR, GLEX_LOG_DOMAIN, GLEX_LOG_TAG, fmt, ##__VA_ARGS__)
 #define GLEX_LOGD(fmt, ...) OH_LOG_Print(LOG_APP, LOG_DEBUG, GLEX_LOG_DOMAIN, GLEX_LOG_TAG, fmt, ##__VA_ARGS__)
+
+#else
+
+// 非 OpenHarmony 构建（Linux 离屏基准等）：输出到 stderr，去掉 hilog 的 {public} 修饰
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+
+namespace glex {
+namespace detail {
+
+inline void LogPrint(const char* level, const char* fmt, ...)
+{
+    std::string format(fmt);
+    for (size_t pos = format.find("{public}"); pos != std::string::npos; pos = format.find("{public}", pos)) {
+        format.erase(pos, 8);
+    }
+    std::fprintf(stderr, "[GLEX][%s] ", level);
+    va_list args;
+    va_start(args, fmt);
+    std::vfprintf(stderr, format.c_str(), args);
+    va_end(args);
+    std::fputc('\n', stderr);
+}
+
+} // namespace detail
+} // namespace glex
+
+#define GLEX_LOGI(fmt, ...) ::glex::detail::LogPrint("I", fmt, ##__VA_ARGS__)
+#define GLEX_LOGW(fmt, ...) ::glex::detail::LogPrint("W", fmt, ##__VA_ARGS__)
+#define GLEX_LOGE(fmt, ...) ::glex::detail::LogPrint("E", fmt, ##__VA_ARGS__)
+#define GLEX_LOGD(fmt, ...) ::glex::detail::LogPrint("D", fmt, ##__VA_ARGS__)
+
+#endif
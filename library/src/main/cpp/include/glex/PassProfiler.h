@@ -0,0 +1,178 @@
+#pragma once
+
+/**
+ * @file PassProfiler.h
+ * @brief 逐 Pass 的 CPU / GPU 耗时剖析与 Chrome Trace 导出
+ *
+ * RenderPipeline 在每个 Pass 的 update / fixedUpdate / prepareRender / render 外包裹作用域标记：
+ *   - CPU 耗时：steady_clock，记录所在线程（并行 / 流水线 update 时为工作线程）
+ *   - GPU 耗时：render 作用域额外在 GpuTimer 上计时一段，之后几帧在 GL 线程上轮询结果，
+ *     从不等待 GPU；发生 disjoint 时丢弃进行中的结果。默认使用自带的 GpuTimer，
+ *     setGpuTimer 可改用外部的（如 ResolutionScaler 的整帧计时），两者共用一条查询流
+ * 事件写入固定容量的环形缓冲区，可导出为 Chrome Trace JSON（chrome://tracing / Perfetto）。
+ *
+ * 用法：
+ *   profiler.setEnabled(true);
+ *   {
+ *       GLEX_PROFILE_GPU_SCOPE(&profiler, pass->getName().c_str(), ProfileScope::Render);
+ *       pass->render();
+ *   }
+ *   std::string json = profiler.exportChromeTrace();
+ *
+ * 编译选项 GLEX_ENABLE_PROFILER=0 时作用域宏展开为空，剖析器只保留空实现。
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "glex/GpuTimer.h"
+
+#ifndef GLEX_ENABLE_PROFILER
+#define GLEX_ENABLE_PROFILER 1
+#endif
+
+namespace glex {
+
+/**
+ * 剖析作用域类型
+ */
+enum class ProfileScope : uint8_t {
+    Update = 0,      // RenderPass::update
+    FixedUpdate,     // 一帧内全部 RenderPass::fixedUpdate
+    PrepareRender,   // RenderPass::prepareRender
+    Render,          // RenderPass::render
+    Pipeline,        // RenderPipeline 整体（update / render）
+};
+
+/** 作用域名称（用作 Chrome Trace 的 cat） */
+const char* GetProfileScopeName(ProfileScope scope);
+
+/**
+ * 一条剖析记录
+ */
+struct ProfileEvent {
+    static constexpr size_t kMaxNameLength = 32;
+
+    char name[kMaxNameLength] = {};
+    ProfileScope scope = ProfileScope::Update;
+    uint32_t threadId = 0;
+    uint64_t frame = 0;
+    uint64_t seq = 0;
+    int64_t startNs = 0;      // 相对剖析器创建时刻
+    int64_t durationNs = 0;
+    int64_t gpuNs = -1;       // GPU 耗时，-1 表示无查询或结果未就绪 / 被丢弃
+};
+
+class PassProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** 默认环形缓冲区容量（事件数） */
+    static constexpr size_t kDefaultCapacity = 4096;
+
+    /** Chrome Trace 中 GPU 轨道的线程号 */
+    static constexpr uint32_t kGpuTrackId = 0;
+
+    /** 是否编译了剖析功能 */
+    static constexpr bool IsCompiledIn() { return GLEX_ENABLE_PROFILER != 0; }
+
+    explicit PassProfiler(size_t capacity = kDefaultCapacity);
+    ~PassProfiler();
+
+    // 禁止拷贝
+    PassProfiler(const PassProfiler&) = delete;
+    PassProfiler& operator=(const PassProfiler&) = delete;
+
+    /** 运行时开关（默认关闭；关闭时作用域标记只有一次原子读） */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /** 开始新的一帧（RenderPipeline::update 调用），用于标注事件所属帧 */
+    void nextFrame() { frame_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * 轮询已完成的 GPU 查询并回填结果（GL 线程，每帧调用一次，不阻塞）
+     */
+    void collectGpuResults();
+
+    /** 删除自带 GpuTimer 的查询对象（GL 线程，上下文销毁前调用；外部 GpuTimer 由其所有者释放） */
+    void releaseGpu();
+
+    /**
+     * 改用外部 GpuTimer（GL 线程；nullptr 恢复自带的）
+     * 外部计时器须比剖析器存活更久，或在销毁前以 nullptr 解除
+     */
+    void setGpuTimer(GpuTimer* timer);
+
+    /** 当前上下文是否支持 GPU 计时（首次发起 GPU 作用域后有效） */
+    bool isGpuTimingSupported() const { return gpuTimer_->isKnownSupported(); }
+
+    /** 清空已记录的事件 */
+    void clear();
+
+    /** 导出 Chrome Trace JSON（Trace Event Format，ph = "X"） */
+    std::string exportChromeTrace() const;
+
+    /** 导出到文件 */
+    bool writeChromeTrace(const std::string& path) const { return WriteTraceFile(path, exportChromeTrace()); }
+
+    /** 把已导出的 Trace JSON 写入文件 */
+    static bool WriteTraceFile(const std::string& path, const std::string& json);
+
+    /**
+     * 作用域标记（RAII）：构造时记录开始时间，析构时写入事件
+     * gpu 为 true 时同时包裹一个 GPU 计时查询（只能在 GL 线程使用，且不能嵌套）
+     */
+    class Marker {
+    public:
+        Marker(PassProfiler* profiler, const char* name, ProfileScope scope, bool gpu);
+        ~Marker();
+
+        Marker(const Marker&) = delete;
+        Marker& operator=(const Marker&) = delete;
+
+    private:
+        PassProfiler* profiler_ = nullptr;
+        const char* name_ = nullptr;
+        ProfileScope scope_ = ProfileScope::Update;
+        Clock::time_point start_;
+        bool gpu_ = false;
+    };
+
+private:
+    int64_t sinceOrigin(Clock::time_point t) const;
+    uint64_t record(const char* name, ProfileScope scope, Clock::time_point start, Clock::time_point end);
+    void onGpuResult(uint64_t seq, int64_t ns);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> frame_{0};
+    Clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::vector<ProfileEvent> events_;
+    uint64_t nextSeq_ = 0;
+    uint64_t firstSeq_ = 0;   // clear() 时的 nextSeq_：更早的序号已被清除
+
+    // GPU 计时只在 GL 线程访问；段的标记为事件序号
+    GpuTimer ownTimer_;
+    GpuTimer* gpuTimer_ = &ownTimer_;
+};
+
+} // namespace glex
+
+#if GLEX_ENABLE_PROFILER
+#define GLEX_PROFILE_CONCAT_INNER(a, b) a##b
+#define GLEX_PROFILE_CONCAT(a, b) GLEX_PROFILE_CONCAT_INNER(a, b)
+#define GLEX_PROFILE_SCOPE(profiler, name, scope) \
+    ::glex::PassProfiler::Marker GLEX_PROFILE_CONCAT(glexProfileMarker, __LINE__)((profiler), (name), (scope), false)
+#define GLEX_PROFILE_GPU_SCOPE(profiler, name, scope) \
+    ::glex::PassProfiler::Marker GLEX_PROFILE_CONCAT(glexProfileMarker, __LINE__)((profiler), (name), (scope), true)
+#else
+#define GLEX_PROFILE_SCOPE(profiler, name, scope) ((void)0)
+#define GLEX_PROFILE_GPU_SCOPE(profiler, name, scope) ((void)0)
+#endif
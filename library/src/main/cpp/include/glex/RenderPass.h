@@ -18,10 +18,18 @@
  *   };
  */
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
+
+#include "glex/DamageRegion.h"
+#include "glex/TouchInput.h"
 
 namespace glex {
 
+class ShareGroup;
+
 class RenderPass {
 public:
     explicit RenderPass(const std::string& name) : name_(name) {}
@@ -53,17 +61,57 @@ public:
         }
     }
 
-    // Render
-    void render() {
+    /** 固定步长更新（管线固定步长模式），一帧内可能调用多次 */
+    void fixedUpdate(float step) {
+        if (enabled_ && initialized_) {
+            onFixedUpdate(step);
+        }
+    }
+
+    /** 由模拟状态生成渲染数据（流水线模式下可能在工作线程执行） */
+    void prepareRender() {
+        if (enabled_ && initialized_) {
+            onPrepareRender();
+        }
+    }
+
+    /** 发布已准备好的渲染数据（GL 线程，没有进行中的更新时调用） */
+    void publish() {
+        if (initialized_) {
+            onPublish();
+        }
+    }
+
+    /** 渲染；alpha 为固定步长插值系数，取值 [0, 1]（可变步长模式下为 1） */
+    void render(float alpha = 1.0f) {
+        interpolationAlpha_ = alpha;
         if (enabled_ && initialized_) {
             onRender();
         }
     }
 
-    // Touch event
+    /** 追加本帧的损坏矩形（GL 窗口坐标），仅 reportsDamage() 为 true 时有意义 */
+    void collectDamage(std::vector<DamageRect>& rects) {
+        if (initialized_) {
+            onCollectDamage(rects);
+        }
+    }
+
+    /** 触摸事件（时间戳取当前时刻） */
     void touch(float x, float y, int action, int pointerId) {
+        TouchEvent event;
+        event.x = x;
+        event.y = y;
+        event.action = action;
+        event.pointerId = pointerId;
+        event.timestampNs = TouchQueue::Now();
+        touch(event);
+    }
+
+    /** 触摸事件（保留原始时间戳） */
+    void touch(const TouchEvent& event) {
         if (enabled_ && initialized_) {
-            onTouch(x, y, action, pointerId);
+            onTouchEvent(event);
         }
     }
 
@@ -89,6 +137,41 @@ public:
     int getWidth() const { return width_; }
     int getHeight() const { return height_; }
 
+    /** 请求再绘制一帧（OnDemand 渲染模式），任意线程可调用 */
+    void requestRedraw() { redrawRequested_.store(true, std::memory_order_release); }
+
+    /** 读取并清除待处理的重绘请求 */
+    bool consumeRedrawRequest() { return redrawRequested_.exchange(false, std::memory_order_acq_rel); }
+
+    /** 距上一次 fixedUpdate 已经过的固定步长比例（在 onRender 内有效） */
+    float getInterpolationAlpha() const { return interpolationAlpha_; }
+
+    /** 所属管线的共享组（未共享时为空），在 initialize 之前设置 */
+    void setShareGroup(std::shared_ptr<ShareGroup> group) { shareGroup_ = std::move(group); }
+    const std::shared_ptr<ShareGroup>& getShareGroup() const { return shareGroup_; }
+
+    /** onUpdate 只访问本 Pass 自己的状态，可在 JobSystem 工作线程执行 */
+    bool isParallelUpdateSafe() const { return parallelUpdateSafe_; }
+
+    /**
+     * onRender 只读取 onPublish 交换进来的数据，
+     * 因此下一帧的 onUpdate / onPrepareRender 可与本帧的 onRender 重叠执行
+     */
+    bool isDoubleBuffered() const { return doubleBuffered_; }
+
+    /**
+     * onCollectDamage 报告与上一帧不同的全部像素（包括上一帧绘制的区域）；
+     * 其他 Pass 按整个画面损坏计算
+     */
+    bool reportsDamage() const { return reportsDamage_; }
+
+    /**
+     * 所属管线按手指维护的触摸状态，已包含正在分发的事件（不在管线中时为空）
+     * 由 RenderPipeline 设置
+     */
+    void setTouchState(const TouchState* state) { touchState_ = state; }
+    const TouchState* getTouchState() const { return touchState_; }
+
 protected:
     /** 瀛愮被瀹炵幇锛氬垵濮嬪寲 GL 璧勬簮 */
     virtual void onInitialize(int width, int height) = 0;
@@ -102,6 +185,18 @@ protected:
     /** 瀛愮被瀹炵幇锛氭覆鏌撶粯鍒?*/
     virtual void onRender() = 0;
 
+    /** 固定步长模式：模拟恰好推进一步（默认调用 onUpdate） */
+    virtual void onFixedUpdate(float step) { onUpdate(step); }
+
+    /** 双缓冲 Pass：由模拟状态填充后台渲染缓冲 */
+    virtual void onPrepareRender() {}
+
+    /** 双缓冲 Pass：交换前后台渲染缓冲 */
+    virtual void onPublish() {}
+
+    /** 报告损坏的 Pass：追加本帧变化的区域（在 update 之后、render 之前调用） */
+    virtual void onCollectDamage(std::vector<DamageRect>& rects) { (void)rects; }
+
     virtual void onTouch(float x, float y, int action, int pointerId) {
         (void)x;
         (void)y;
@@ -109,6 +204,11 @@ protected:
         (void)pointerId;
     }
 
+    /** 完整的触摸记录（默认调用 onTouch），需要时间戳时重写 */
+    virtual void onTouchEvent(const TouchEvent& event) {
+        onTouch(event.x, event.y, event.action, event.pointerId);
+    }
+
     /** 瀛愮被瀹炵幇锛氶攢姣?GL 璧勬簮 */
     virtual void onDestroy() = 0;
 
@@ -117,6 +217,15 @@ protected:
     bool initialized_ = false;
     int width_ = 0;
     int height_ = 0;
+    bool parallelUpdateSafe_ = false;
+    bool doubleBuffered_ = false;
+    bool reportsDamage_ = false;
+    float interpolationAlpha_ = 1.0f;
+    std::shared_ptr<ShareGroup> shareGroup_;
+    const TouchState* touchState_ = nullptr;
+
+private:
+    std::atomic<bool> redrawRequested_{false};
 };
 
 } // namespace glex
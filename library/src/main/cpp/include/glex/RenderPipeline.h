@@ -15,12 +15,40 @@
  *   // 每帧：
  *   pipeline.update(deltaTime);
  *   pipeline.render();
+ *
+ * 开启 setParallelUpdate 后，isParallelUpdateSafe() 的 Pass 在 JobSystem 上并行 update，
+ * 其余 Pass 仍在调用线程按顺序 update；render 始终在 GL 线程按顺序执行。
+ *
+ * 开启 setPipelined 后，isDoubleBuffered() 的 Pass 在 update 中发布上一帧模拟结果，
+ * 并把下一帧的 update + prepareRender 投递到 JobSystem，与本帧 render 重叠执行
+ * （增加一帧延迟）。修改 Pass 列表、尺寸、触摸前会先等待进行中的模拟；已完成的模拟
+ * 保留到下一次 update 发布，不会重新模拟（每帧恰好推进一次）。
+ *
+ * 开启 setFixedTimestep 后，update 把帧间隔累加到累加器，按固定步长调用 0 到
+ * maxSteps 次 onFixedUpdate；单帧超出上限的积累直接丢弃，避免卡顿后追帧雪崩。
+ * 剩余不足一步的比例作为插值系数传给 render（RenderPass::getInterpolationAlpha）；
+ * 流水线模式下发布的是上一帧的模拟结果，插值系数也取那一帧的值。
+ *
+ * collectDamage 汇总各 Pass 上报的损坏区域并合并为少量矩形；任一启用的 Pass
+ * 不上报（reportsDamage() 为 false），或 Pass 列表、尺寸、启用状态发生变化时返回整帧。
+ *
+ * getProfiler() 返回逐 Pass 剖析器：开启后每个 Pass 的 update / prepareRender / render
+ * 记录 CPU 耗时，render 另记录 GPU 耗时（异步取回），可导出为 Chrome Trace。
+ *
+ * setShareGroup 把 EGL 共享组传给之后初始化的 Pass（RenderPass::getShareGroup），
+ * Pass 据此从共享组获取着色器程序与静态缓冲，而不是各自编译上传。
+ *
+ * dispatchTouch 逐个分发完整的触摸记录（含时间戳）：先更新多指状态表，再调用各 Pass 的
+ * onTouchEvent；Pass 通过 RenderPass::getTouchState() 读取所有手指的状态。
  */
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "glex/JobSystem.h"
+#include "glex/PassProfiler.h"
 #include "glex/RenderPass.h"
 
 namespace glex {
@@ -50,31 +78,137 @@ public:
      */
     size_t getPassCount() const { return passes_.size(); }
 
+    /**
+     * 设置共享组（需与 GLContext 加入的共享组一致，在 initialize / addPass 之前调用）
+     * @param group 为空时 Pass 各自创建资源
+     */
+    void setShareGroup(std::shared_ptr<ShareGroup> group);
+    const std::shared_ptr<ShareGroup>& getShareGroup() const { return shareGroup_; }
+
     /** 初始化所有 Pass */
     void initialize(int width, int height);
 
     /** 调整所有 Pass 尺寸 */
     void resize(int width, int height);
 
+    /** 当前渲染尺寸（Pass 看到的尺寸） */
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+    /** 是否流水线化双缓冲 Pass 的模拟与渲染（默认关闭） */
+    void setPipelined(bool enabled);
+    bool isPipelined() const { return pipelined_; }
+
+    /** 等待进行中的流水线模拟完成（修改 Pass 状态前调用） */
+    void waitForUpdate();
+
+    /** 是否并行更新相互独立的 Pass（默认关闭） */
+    void setParallelUpdate(bool enabled) { parallelUpdate_ = enabled; }
+    bool isParallelUpdate() const { return parallelUpdate_; }
+
+    /** 默认每帧最多执行的固定步数 */
+    static constexpr int kDefaultMaxFixedSteps = 4;
+
+    /**
+     * 固定步长模拟
+     * @param step 步长（秒），<= 0 时恢复按帧间隔更新
+     * @param maxSteps 每帧最多执行的步数，超出部分丢弃
+     */
+    void setFixedTimestep(float step, int maxSteps = kDefaultMaxFixedSteps);
+    float getFixedTimestep() const { return fixedStep_; }
+    int getMaxFixedSteps() const { return maxFixedSteps_; }
+
+    /** 最近一帧执行的固定步数 */
+    int getLastFixedSteps() const { return lastFixedSteps_; }
+
+    /** 当前插值系数（固定步长模式下为 [0, 1]，否则为 1） */
+    float getInterpolationAlpha() const { return interpolationAlpha_; }
+
+    /** 因超过每帧步数上限而丢弃的步数（累计） */
+    uint64_t getDroppedFixedSteps() const { return droppedFixedSteps_; }
+
     /** 更新所有 Pass */
     void update(float deltaTime);
 
     /** 按顺序渲染所有启用的 Pass */
     void render();
 
-    /** 分发触摸事件 */
+    /** 汇总并清除各 Pass 的重绘请求（OnDemand 模式），任一 Pass 请求时返回 true */
+    bool consumeRedrawRequests();
+
+    /** 合并后最多保留的损坏矩形数 */
+    static constexpr size_t kMaxDamageRects = 4;
+
+    /**
+     * 汇总本帧损坏区域（update 之后、render 之前调用）
+     * @param rects 输出合并后的矩形（GL 窗口坐标）
+     * @return false 表示整帧损坏（此时 rects 为空）
+     */
+    bool collectDamage(std::vector<DamageRect>& rects);
+
+    /** 下一次 collectDamage 返回整帧（外部状态如清屏颜色变化时调用） */
+    void invalidateDamage() { fullDamage_ = true; }
+
+    /** 分发触摸事件（时间戳取当前时刻） */
     void dispatchTouch(float x, float y, int action, int pointerId);
 
-    /** 销毁所有 Pass */
+    /** 分发一条完整的触摸记录（按到达顺序逐条调用） */
+    void dispatchTouch(const TouchEvent& event);
+
+    /** 多指状态表（已应用到最近分发的事件） */
+    const TouchState& getTouchState() const { return touchState_; }
+
+    /** 逐 Pass 剖析器（默认关闭） */
+    PassProfiler& getProfiler() { return profiler_; }
+    const PassProfiler& getProfiler() const { return profiler_; }
+
+    /** 销毁所有 Pass（同时释放剖析器的 GPU 查询，需在 GL 线程调用） */
     void destroy();
 
     bool isInitialized() const { return initialized_; }
 
 private:
+    // 一帧的模拟量：变步长时执行一次 update(dt)，固定步长时执行 count 次 fixedUpdate(dt)
+    struct SimStep {
+        float dt = 0.0f;
+        int count = 1;
+        bool fixed = false;
+    };
+
+    void step(RenderPass* pass, const SimStep& sim);
+    SimStep advance(float deltaTime);
+    void simulate(const std::vector<RenderPass*>& passes, const SimStep& sim, bool async,
+                  std::vector<JobHandle>& handles);
+
     std::vector<std::shared_ptr<RenderPass>> passes_;
+    std::shared_ptr<ShareGroup> shareGroup_;
     int width_ = 0;
     int height_ = 0;
     bool initialized_ = false;
+    bool fullDamage_ = true;
+    std::vector<bool> damageEnabledState_;
+    bool parallelUpdate_ = false;
+    bool pipelined_ = false;
+
+    float fixedStep_ = 0.0f;
+    int maxFixedSteps_ = kDefaultMaxFixedSteps;
+    float accumulator_ = 0.0f;
+    int lastFixedSteps_ = 0;
+    float interpolationAlpha_ = 1.0f;
+    uint64_t droppedFixedSteps_ = 0;
+    bool redrawPending_ = false;
+
+    PassProfiler profiler_;
+    TouchState touchState_;
+
+    // 流水线模式：投递给工作线程的下一帧模拟
+    std::vector<JobHandle> inFlight_;
+    // 已为下一帧模拟并准备好渲染数据、等待 publish 的 Pass（waitForUpdate 只等待完成，不丢弃）
+    std::vector<RenderPass*> prepared_;
+    float preparedAlpha_ = 1.0f;
+    // 本帧发布的是上一帧模拟结果的 Pass：render 时使用那一帧的插值系数
+    std::vector<RenderPass*> lagging_;
+    float laggingAlpha_ = 1.0f;
 };
 
 } // namespace glex
@@ -5,6 +5,13 @@
  * @brief 独立渲染线程
  *
  * 在独立线程上运行渲染循环，支持帧率控制。
+ * 帧节奏由 FrameScheduler 按绝对截止时间调度，可选对齐到 VsyncSource。
+ * OnDemand 模式下仅在 requestRender() 标脏后绘制，空闲时线程挂起在条件变量上。
+ * 可选启用 FrameRateGovernor，在设备跟不上目标帧率时按阶梯降档。
+ * 投递的任务按优先级执行，非紧急任务受每帧时间预算限制，超出部分顺延到后续帧。
+ * 可设置 ThreadPolicy（CPU 亲和性 / 优先级 / 线程名），并统计线程在 CPU 间的迁移次数。
+ * 每帧开始时调用 GLContext::waitForFrameSlot()，按上下文的帧在途上限等待 GPU（耗时计入 GpuWait 阶段）。
+ * setShared(true) 后不再创建独立线程，而是由进程级 SharedRenderScheduler 与其他实例轮流绘制。
  * 自动管理 EGL 上下文的线程绑定。
  *
  * 用法：
@@ -18,14 +25,35 @@
  */
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "glex/FrameRateGovernor.h"
+#include "glex/FrameScheduler.h"
+#include "glex/FrameStats.h"
+#include "glex/Task.h"
+#include "glex/TaskQueue.h"
+#include "glex/ThreadPolicy.h"
+
 namespace glex {
 
 class GLContext;
+class SharedRenderScheduler;
+struct SharedRenderWorker;
+
+/**
+ * 渲染模式
+ */
+enum class RenderMode : int {
+    Continuous = 0,  // 按目标帧率持续绘制
+    OnDemand = 1,    // 仅在标脏后绘制，空闲时挂起渲染线程
+};
 
 class RenderThread {
 public:
@@ -34,6 +62,7 @@ public:
      * @param deltaTime 距上一帧的时间（秒）
      */
     using FrameCallback = std::function<void(float deltaTime)>;
+    using Clock = std::chrono::steady_clock;
 
     RenderThread() = default;
     ~RenderThread();
@@ -50,14 +79,38 @@ public:
     void start(GLContext* context, FrameCallback callback);
 
     /**
-     * 停止渲染循环并等待线程退出
+     * 由进程级 SharedRenderScheduler 驱动（在 start 之前调用，默认 false）
+     * 共享模式下 vsync 源与 ThreadPolicy 以调度器为准，本实例的设置不生效
+     */
+    void setShared(bool shared);
+    bool isShared() const { return shared_.load(std::memory_order_relaxed); }
+
+    /**
+     * 停止渲染循环并等待线程退出（共享模式下等待调度器移除本实例）
      */
     void stop();
 
     /**
      * 向渲染线程投递任务（任务会在渲染线程内执行）
+     * 任意线程可调用；常规情况下无锁（lock-free，非 wait-free，见 TaskQueue）且不分配内存，队列满时回退到加锁的溢出列表
+     * 渲染循环退出前会关闭投递（如 swapBuffers 失败后自行停止）：此后直到下次 start 都返回 false，
+     * 任务不会执行；返回 true 的任务保证在循环退出前执行
+     * @param priority Urgent 任务在下一次执行任务时必定运行；其余按优先级在帧预算内运行
+     * @param estimatedCostMs 预估耗时，用于判断剩余预算是否足够（0 表示可忽略）
+     * @return 任务是否被接收
      */
-    void post(std::function<void()> task);
+    bool post(Task task, TaskPriority priority = TaskPriority::Normal, float estimatedCostMs = 0.0f);
+
+    /**
+     * 设置每帧执行非紧急任务的时间预算（毫秒，默认 4）
+     * 每帧至少执行一个非紧急任务，避免大任务永远得不到执行；
+     * 一旦有任务因预算顺延，本帧不再执行任何更低优先级的任务
+     */
+    void setTaskBudget(float budgetMs);
+    float getTaskBudget() const { return taskBudgetMs_.load(std::memory_order_relaxed); }
+
+    /** 因预算不足顺延到后续帧的任务数 */
+    size_t getDeferredTaskCount() const { return deferredTasks_.load(std::memory_order_relaxed); }
 
     /**
      * 设置目标帧率
@@ -65,25 +118,132 @@ public:
      */
     void setTargetFPS(int fps);
 
+    /**
+     * 设置 vsync 源（在 start 之前调用；nullptr 表示纯计时调度）
+     */
+    void setVsyncSource(std::shared_ptr<VsyncSource> source);
+
+    /**
+     * 设置渲染模式（可在运行中切换）
+     */
+    void setRenderMode(RenderMode mode);
+
+    RenderMode getRenderMode() const { return static_cast<RenderMode>(renderMode_.load()); }
+
+    /**
+     * 标记需要重绘（OnDemand 模式下唤醒渲染线程绘制一帧；任意线程可调用）
+     */
+    void requestRender();
+
+    /**
+     * 设置渲染线程调度策略（可在运行中调用，下一帧在渲染线程上生效；重启线程后自动重新应用）
+     */
+    void setThreadPolicy(const ThreadPolicy& policy);
+
+    /** 最近一次应用策略时未能生效的部分（全部成功时为空） */
+    std::string getThreadPolicyError() const;
+
+    /** 渲染线程最近一帧所在的 CPU（未运行时为 -1） */
+    int getCurrentCpu() const { return currentCpu_.load(std::memory_order_relaxed); }
+
+    /** 本次启动以来观测到的渲染线程 CPU 迁移次数（逐帧采样） */
+    uint64_t getMigrationCount() const { return migrations_.load(std::memory_order_relaxed); }
+
     /** 获取目标帧率 */
     int getTargetFPS() const { return targetFPS_.load(); }
 
+    /**
+     * 自适应帧率调节器（默认禁用；启用后以目标帧率为上限调节实际调度帧率）
+     */
+    FrameRateGovernor& getFrameRateGovernor() { return governor_; }
+    const FrameRateGovernor& getFrameRateGovernor() const { return governor_; }
+
     /** 渲染循环是否正在运行 */
     bool isRunning() const { return running_.load(); }
 
     /** 获取实际帧率（最近一秒的平均值） */
     float getCurrentFPS() const { return currentFPS_.load(); }
 
+    /** 获取本次启动以来错过的帧截止时间数（共享模式下含因轮转让出而推迟的帧） */
+    uint64_t getMissedFrames() const
+    {
+        return scheduler_.getMissedFrames() + sharedMissedFrames_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 逐帧分阶段耗时统计
+     * 任务执行与 swapBuffers 由渲染线程记录，其余阶段由帧回调自行记录
+     */
+    FrameStatsRecorder& getFrameStats() { return frameStats_; }
+    const FrameStatsRecorder& getFrameStats() const { return frameStats_; }
+
+    /** 共享模式下因 GPU 未追上帧在途上限而被跳过的节拍数（本次启动以来） */
+    uint64_t getGpuBusySkips() const { return sharedGpuBusyTicks_.load(std::memory_order_relaxed); }
+
 private:
+    friend class SharedRenderScheduler;
+
     void loop();
-    void drainTasks();
+    void beginFrames(Clock::time_point now);
+    bool runFrame(Clock::time_point now, Clock::duration* workTime);
+    void collectTasks();
+    void drainTasks(bool unbounded = false);
+    void closeTasks();
+    bool hasPendingTasks() const;
+    void park();
+    void wake();
+    void applyThreadPolicy();
+    void sampleCpu();
 
     GLContext* context_ = nullptr;
     FrameCallback callback_;
     std::thread thread_;
 
-    std::mutex taskMutex_;
-    std::vector<std::function<void()>> tasks_;
+    // 共享模式
+    std::atomic<bool> shared_{false};
+    bool startedShared_ = false;
+    std::atomic<SharedRenderWorker*> sharedWorker_{nullptr};
+    std::atomic<uint64_t> sharedMissedFrames_{0};
+    std::atomic<uint64_t> sharedGpuBusyTicks_{0};
+
+    // 仅绘制线程（独立线程或共享调度线程）访问的逐帧状态
+    Clock::time_point prevFrame_{};
+    Clock::time_point fpsTimer_{};
+    Clock::time_point nextDue_{};
+    int fpsFrames_ = 0;
+    int scheduledFPS_ = 60;
+
+    TaskQueue tasks_;
+    std::mutex overflowMutex_;
+    std::vector<QueuedTask> overflowTasks_;
+    std::atomic<bool> hasOverflow_{false};
+    // 投递开关：closeTasks 关闭后等待进行中的 post 结束，之后最后一次 drain 不会漏掉已接收的任务
+    std::atomic<bool> acceptingTasks_{true};
+    std::atomic<int> activePosts_{0};
+
+    // 仅渲染线程访问：已取出、按优先级排队等待执行的任务（[readyHead_, size) 待执行；容量复用，不反复分配）
+    std::vector<QueuedTask> ready_[kTaskPriorityCount];
+    size_t readyHead_[kTaskPriorityCount] = {};
+    std::atomic<size_t> deferredTasks_{0};
+    std::atomic<float> taskBudgetMs_{4.0f};
+
+    FrameScheduler scheduler_;
+    FrameStatsRecorder frameStats_;
+    FrameRateGovernor governor_;
+
+    std::mutex parkMutex_;
+    std::condition_variable parkCv_;
+    std::atomic<bool> parked_{false};
+    std::atomic<bool> dirty_{true};
+    std::atomic<int> renderMode_{static_cast<int>(RenderMode::Continuous)};
+
+    mutable std::mutex policyMutex_;
+    ThreadPolicy policy_;
+    bool hasPolicy_ = false;
+    std::string policyError_;
+    std::atomic<bool> policyDirty_{false};
+    std::atomic<int> currentCpu_{-1};
+    std::atomic<uint64_t> migrations_{0};
 
     std::atomic<bool> running_{false};
     std::atomic<int> targetFPS_{60};
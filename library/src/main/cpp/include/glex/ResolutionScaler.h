@@ -0,0 +1,137 @@
+#pragma once
+
+/**
+ * @file ResolutionScaler.h
+ * @brief 按 GPU 帧耗时调节的动态分辨率
+ *
+ * 全屏着色器、叠加粒子这类填充率受限的内容，耗时近似与像素数成正比。
+ * 缩放系数 s < 1 时，本帧先渲染到 (w*s) x (h*s) 的离屏 FBO，再以一次线性过滤的
+ * glBlitFramebuffer 放大到窗口；s = 1 时直接渲染到窗口，没有额外开销。
+ *
+ * 自动模式按窗口（默认 30 帧）统计平均帧耗时：
+ *   - GPU 耗时：以 GpuTimer 的一帧包裹本帧绘制与放大，之后几帧轮询取回，从不等待 GPU；
+ *     disjoint 时丢弃。PassProfiler 可经 getGpuTimer() 共用同一条查询流，逐 Pass 的段
+ *     与整帧计时同时有效
+ *   - 不支持计时查询时退回渲染阶段的 CPU 耗时
+ * 平均耗时超出预算时按像素比例一次降到位（s *= sqrt(预算 / 耗时)），
+ * 远低于预算时每个窗口升一级；系数量化为 kScaleStep 的整数倍，避免频繁重建离屏目标。
+ *
+ * 所有方法须在持有 GL 上下文的线程（渲染线程）调用。
+ *
+ * 用法（渲染线程）：
+ *   if (scaler.update()) pipeline.resize(...scaler.computeSize...);  // 帧开始
+ *   scaler.beginFrame(width, height);                                // 绑定渲染目标
+ *   ... 清屏、绘制（视口为缩放后尺寸） ...
+ *   scaler.endFrame();                                               // 放大到窗口
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+#include "glex/GpuTimer.h"
+
+namespace glex {
+
+class ResolutionScaler {
+public:
+    /** 系数量化步长 */
+    static constexpr float kScaleStep = 0.05f;
+
+    /** 系数下限的最小值 */
+    static constexpr float kMinScale = 0.25f;
+
+    struct Config {
+        bool automatic = false;        // 是否按帧耗时自动调节
+        float scale = 1.0f;            // 固定系数（非自动模式）
+        float minScale = 0.5f;         // 自动模式下限
+        float maxScale = 1.0f;         // 自动模式上限
+        int windowFrames = 30;         // 统计窗口帧数
+        float headroom = 0.85f;        // 目标耗时 = 帧预算 * headroom
+        float upThreshold = 0.7f;      // 平均耗时 < 目标 * 此值时升一级
+    };
+
+    ResolutionScaler();
+    ~ResolutionScaler() = default;
+
+    // 禁止拷贝
+    ResolutionScaler(const ResolutionScaler&) = delete;
+    ResolutionScaler& operator=(const ResolutionScaler&) = delete;
+
+    /** 应用配置（固定模式立即生效；自动模式从上限开始） */
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    /** 帧预算（毫秒），通常为 1000 / 目标帧率 */
+    void setFrameBudget(float ms) { budgetMs_ = ms; }
+
+    /** 当前系数 */
+    float getScale() const { return scale_; }
+
+    /** 是否渲染到离屏目标（系数 < 1） */
+    bool isScaled() const { return scale_ < 1.0f; }
+
+    /** 按当前系数计算渲染尺寸（至少 1x1） */
+    void computeSize(int width, int height, int* scaledWidth, int* scaledHeight) const;
+
+    /**
+     * 自动模式：取回计时结果并在窗口满时调整系数
+     * @return 系数发生变化（调用方需按新尺寸 resize）
+     */
+    bool update();
+
+    /**
+     * 开始一帧：系数 < 1 时绑定离屏 FBO；自动模式时在 GpuTimer 上开始一帧计时
+     * @param width / height 窗口尺寸
+     * @return 本帧渲染目标是否为离屏 FBO
+     */
+    bool beginFrame(int width, int height);
+
+    /** 结束一帧：放大到窗口帧缓冲并结束计时 */
+    void endFrame();
+
+    /** 整帧计时所用的 GpuTimer（可交给 PassProfiler::setGpuTimer 共用） */
+    GpuTimer& getGpuTimer() { return gpuTimer_; }
+
+    /** 报告本帧渲染的 CPU 耗时（毫秒），GPU 计时不可用时作为样本 */
+    void reportCpuTime(float ms);
+
+    /** 删除离屏目标与计时查询 */
+    void releaseGpu();
+
+private:
+    bool ensureTarget(int width, int height);
+    void onGpuFrame(uint64_t frame, int64_t ns);
+    void addSample(float ms);
+    float quantize(float scale) const;
+
+    Config config_;
+    float scale_ = 1.0f;
+    float budgetMs_ = 1000.0f / 60.0f;
+
+    std::vector<float> samples_;
+    bool gpuSampled_ = false;          // 本帧样本来自 GPU 计时
+
+    GLuint fbo_ = 0;
+    GLuint colorRb_ = 0;
+    GLuint depthRb_ = 0;
+    int targetWidth_ = 0;
+    int targetHeight_ = 0;
+
+    // 本帧状态
+    bool frameScaled_ = false;
+    GLuint windowFbo_ = 0;             // 放大的目标（窗口表面为 0，离屏上下文为其 FBO）
+    int frameWidth_ = 0;
+    int frameHeight_ = 0;
+    int scaledWidth_ = 0;
+    int scaledHeight_ = 0;
+
+    // GPU 计时：帧按序编号，系数变化前提交的帧测的是旧尺寸，取回时丢弃
+    GpuTimer gpuTimer_;
+    uint64_t nextFrame_ = 0;
+    uint64_t firstValidFrame_ = 0;
+};
+
+} // namespace glex
@@ -12,9 +12,14 @@
  *   shader.build(vertexSrc, fragmentSrc);
  *   shader.use();
  *   shader.setUniform1f("u_time", time);
+ *
+ * 链接成功后即缓存全部活跃 uniform 的 location。经 ShareGroup 在多个上下文间共享的程序
+ * 标记为 shared：location 缓存只读（未命中时不再写入），
+ * “设置 uniform + 绘制”需持有 lockForDraw() 返回的锁。
  */
 
 #include <GLES3/gl3.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -45,6 +50,19 @@ public:
     /** 销毁着色器程序 */
     void destroy();
 
+    /** 标记为跨上下文共享（由 ShareGroup 设置） */
+    void setShared(bool shared) { shared_ = shared; }
+    bool isShared() const { return shared_; }
+
+    /**
+     * 共享程序的绘制锁：uniform 值属于程序对象，多个线程的上下文交替设置会互相覆盖
+     * 非共享程序返回空锁
+     */
+    std::unique_lock<std::mutex> lockForDraw()
+    {
+        return shared_ ? std::unique_lock<std::mutex>(drawMutex_) : std::unique_lock<std::mutex>();
+    }
+
     // ============================================================
     // Uniform 操作（自动缓存 location）
     // ============================================================
@@ -59,6 +77,28 @@ public:
     void setUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
     void setUniformMatrix4fv(const std::string& name, const float* value, bool transpose = false);
 
+    /**
+     * 活跃 uniform 的描述（链接时由 glGetActiveUniform 缓存）
+     */
+    struct UniformInfo {
+        GLint location = -1;
+        GLenum type = 0;     // GL_FLOAT / GL_FLOAT_VEC4 / GL_FLOAT_MAT4 等
+        GLint size = 0;      // 数组长度（非数组为 1）
+    };
+
+    /**
+     * 查询活跃 uniform 的位置、类型与数组长度（数组可用带或不带 [0] 的名字）
+     * @return 未找到时返回 false，info 保持 location = -1
+     */
+    bool getUniformInfo(const std::string& name, UniformInfo* info) const;
+
+    /**
+     * 按类型上传 float 系列 uniform（float / vec2-4 / mat2-4 及其数组）
+     * 元素数取 count / 每元素分量数，并截断到数组长度；其他类型忽略
+     * @return 是否上传
+     */
+    static bool setUniformfv(const UniformInfo& info, const float* values, size_t count);
+
     // ============================================================
     // Attribute 操作
     // ============================================================
@@ -68,9 +108,13 @@ public:
 
 private:
     GLuint compileShader(GLenum type, const std::string& source);
+    void cacheActiveUniforms();
 
     GLuint program_ = 0;
     std::unordered_map<std::string, GLint> uniformCache_;
+    std::unordered_map<std::string, UniformInfo> uniformInfo_;
+    bool shared_ = false;
+    std::mutex drawMutex_;
 };
 
 } // namespace glex
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file ShareGroup.h
+ * @brief 进程级 EGL 共享组
+ *
+ * 多个 GLEX 实例默认各自创建上下文，相同的着色器要重复编译、相同的静态顶点要重复上传。
+ * ShareGroup 持有一个离屏根上下文，加入共享组的 GLContext 以它为 share_context 创建，
+ * 从而可以复用：
+ *   - 着色器程序：按源码缓存，首个实例编译，其余实例直接取用
+ *   - 静态缓冲：按键缓存，内容只上传一次
+ * VAO / FBO 等容器对象不可共享，仍由各实例创建。
+ *
+ * 生命周期：Acquire() 返回进程内唯一实例的引用，最后一个引用（含缓存资源持有的引用）
+ * 释放时销毁根上下文。缓存资源在最后一个使用者释放时删除。
+ * 共享对象的创建与删除都在根上下文上进行（临时绑定后恢复调用线程原有绑定），
+ * 因此可以在任意线程调用，与调用方当前绑定的上下文无关。
+ *
+ * 共享程序的 uniform 值属于程序对象本身：使用者须在每次绘制前设置全部 uniform，
+ * 并在“设置 uniform + 绘制”期间持有 ShaderProgram::lockForDraw()，避免不同线程的实例互相覆盖。
+ * 锁只保证提交顺序，已提交的绘制是否使用提交时的值取决于驱动；逐实例变化的值应放入
+ * FrameUniforms（每个实例自有的 UBO），内置 Pass 均如此。
+ *
+ * 用法：
+ *   GLContextConfig config;
+ *   config.shareGroup = ShareGroup::Acquire();
+ *   context.initialize(window, config);
+ *   auto program = config.shareGroup->acquireProgram(vertSrc, fragSrc);
+ */
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+
+#include "glex/GLContext.h"
+#include "glex/ShaderProgram.h"
+
+namespace glex {
+
+class ShareGroup : public std::enable_shared_from_this<ShareGroup> {
+public:
+    /** 获取进程级共享组（不存在时创建根上下文；失败返回 nullptr） */
+    static std::shared_ptr<ShareGroup> Acquire();
+
+    ~ShareGroup();
+
+    // 禁止拷贝
+    ShareGroup(const ShareGroup&) = delete;
+    ShareGroup& operator=(const ShareGroup&) = delete;
+
+    EGLDisplay getDisplay() const { return root_.getEGLDisplay(); }
+    EGLContext getRootContext() const { return root_.getEGLContext(); }
+
+    /** 根上下文是否为 surfaceless（此时组内离屏上下文也使用 surfaceless） */
+    bool isSurfaceless() const { return root_.isSurfaceless(); }
+
+    /**
+     * 获取按源码缓存的着色器程序
+     * @return 构建失败时返回 nullptr
+     */
+    std::shared_ptr<ShaderProgram> acquireProgram(const std::string& vertexSource,
+                                                  const std::string& fragmentSource);
+
+    /**
+     * 获取按键缓存的静态缓冲（GL_ARRAY_BUFFER，GL_STATIC_DRAW）
+     * 同一键的内容应当相同，已存在时忽略 data
+     */
+    std::shared_ptr<const GLuint> acquireStaticBuffer(const std::string& key, const void* data, size_t size);
+
+    /**
+     * group 非空时从共享组获取，否则在当前上下文上单独构建（供 Pass 统一两种情况）
+     * @return 构建失败时返回 nullptr
+     */
+    static std::shared_ptr<ShaderProgram> BuildProgram(const std::shared_ptr<ShareGroup>& group,
+                                                       const std::string& vertexSource,
+                                                       const std::string& fragmentSource);
+
+    /** 当前缓存中仍被使用的程序 / 缓冲数 */
+    size_t getProgramCount() const;
+    size_t getBufferCount() const;
+
+private:
+    ShareGroup() = default;
+    bool initialize();
+
+    GLContext root_;
+    std::mutex rootMutex_;   // 根上下文同一时刻只能绑定到一个线程
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<ShaderProgram>> programs_;
+    std::unordered_map<std::string, std::weak_ptr<const GLuint>> buffers_;
+};
+
+} // namespace glex
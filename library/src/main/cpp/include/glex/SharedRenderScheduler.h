@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file SharedRenderScheduler.h
+ * @brief 进程级共享渲染调度器
+ *
+ * 同屏有多个 GLEX 视图时，每个实例各开一个渲染线程会让多个线程错相唤醒、争抢核心。
+ * 共享调度器用一个（或少量）工作线程在同一个 vsync 周期内依次绘制所有实例：
+ *   - 实例加入时分配给负载最低的工作线程，此后固定不变（EGL 上下文同一时刻只能绑定到一个线程）
+ *   - 每个节拍按各实例自己的目标帧率判断是否到期，到期则 eglMakeCurrent 切换后绘制一帧
+ *   - 实例的帧在途栅栏未完成时（GLContext::pollFrameSlot）本节拍跳过它，不阻塞其他实例
+ *   - 一个节拍的耗时超过周期时，剩余实例顺延到下一节拍并从它们开始，保证轮转公平
+ *   - 全部实例都处于 OnDemand 空闲时工作线程挂起
+ *
+ * 用法：
+ *   SharedRenderScheduler::Get().setThreadCount(1);
+ *   renderThread.setShared(true);
+ *   renderThread.start(context, callback);
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "glex/ThreadPolicy.h"
+
+namespace glex {
+
+class RenderThread;
+struct SharedRenderWorker;
+
+class SharedRenderScheduler {
+public:
+    /** 默认工作线程数 */
+    static constexpr int kDefaultThreadCount = 1;
+
+    static SharedRenderScheduler& Get();
+
+    ~SharedRenderScheduler();
+
+    // 禁止拷贝
+    SharedRenderScheduler(const SharedRenderScheduler&) = delete;
+    SharedRenderScheduler& operator=(const SharedRenderScheduler&) = delete;
+
+    /** 工作线程数上限（只影响之后加入的实例） */
+    void setThreadCount(int count);
+    int getThreadCount() const;
+
+    /** 工作线程的调度策略（已运行的线程在下一节拍应用） */
+    void setThreadPolicy(const ThreadPolicy& policy);
+
+    /** 当前由调度器驱动的实例数 */
+    size_t getClientCount() const;
+
+    /** 唤醒实例所在的工作线程（任意线程可调用） */
+    static void WakeWorker(SharedRenderWorker* worker);
+
+private:
+    friend class RenderThread;
+
+    SharedRenderScheduler() = default;
+
+    /** 由 RenderThread::start / stop 调用；detach 阻塞到工作线程释放该实例 */
+    void attach(RenderThread* client);
+    void detach(RenderThread* client);
+
+    void workerLoop(SharedRenderWorker* worker);
+    void applyPolicy(SharedRenderWorker& worker);
+    void updateMembership(SharedRenderWorker& worker);
+    void release(SharedRenderWorker& worker, RenderThread* client);
+    bool bind(SharedRenderWorker& worker, RenderThread* client);
+    int renderTick(SharedRenderWorker& worker);
+    void park(SharedRenderWorker& worker);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<SharedRenderWorker>> workers_;
+    int threadCount_ = kDefaultThreadCount;
+    ThreadPolicy policy_;
+    std::atomic<uint64_t> policyVersion_{0};
+};
+
+} // namespace glex
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file SpscRing.h
+ * @brief 有界无锁单生产者单消费者环形队列
+ *
+ *   - 仅生产者线程 tryPush，仅消费者线程 tryPop；两端都无锁、不分配内存
+ *   - 队列满时 tryPush 返回 false 且不移动元素，由生产者决定丢弃或重试（从不阻塞）
+ *   - 元素在槽位中原地构造（默认构造 + 移动赋值），出队后槽位保留已移走的对象
+ *   - 恰好容纳构造时给定的元素个数（不取整为 2 的幂），调用方配置的上限即内存上限
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace glex {
+
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @param capacity 容量（至少为 1）
+     */
+    explicit SpscRing(size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1)
+    {
+        slots_.reset(new T[capacity_]);
+    }
+
+    // 禁止拷贝
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /** 入队（仅生产者线程）；队列满时返回 false 且不移动 value */
+    bool tryPush(T& value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= capacity_) {
+            return false;
+        }
+        slots_[tail % capacity_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** 出队（仅消费者线程）；队列空时返回 false */
+    bool tryPop(T& out)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots_[head % capacity_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** 近似元素数量（并发下仅供参考） */
+    size_t sizeApprox() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t capacity_;
+    alignas(64) std::atomic<size_t> head_{0};   // 消费者写
+    alignas(64) std::atomic<size_t> tail_{0};   // 生产者写
+};
+
+} // namespace glex
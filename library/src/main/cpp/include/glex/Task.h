@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file Task.h
+ * @brief 小对象优化的只移动任务类型
+ *
+ * 替代 std::function<void()> 作为渲染线程任务载体：
+ *   - 捕获不超过 kInlineSize 字节的可调用对象直接存放在内部缓冲区，不分配堆内存
+ *   - 只可移动，允许捕获 std::unique_ptr 等只移动对象
+ *
+ * 用法：
+ *   Task task([this]() { doWork(); });
+ *   task();
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace glex {
+
+class Task {
+public:
+    /** 内联存储容量（Task 整体恰好占一个 64 字节缓存行） */
+    static constexpr size_t kInlineSize = 64 - sizeof(void*);
+
+    Task() noexcept = default;
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Task>::value>>
+    Task(F&& fn)  // NOLINT: 允许从 lambda 隐式构造
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (FitsInline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(fn));
+            ops_ = &InlineOps<Fn>::kOps;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(fn));
+            ops_ = &HeapOps<Fn>::kOps;
+        }
+    }
+
+    Task(Task&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        reset();
+    }
+
+    // 禁止拷贝
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void operator()()
+    {
+        ops_->invoke(storage_);
+    }
+
+    /** 释放持有的可调用对象 */
+    void reset() noexcept
+    {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool FitsInline()
+    {
+        return sizeof(Fn) <= kInlineSize &&
+               alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template <typename Fn>
+    struct InlineOps {
+        static void Invoke(void* storage) { (*static_cast<Fn*>(storage))(); }
+        static void Move(void* dst, void* src) noexcept
+        {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void Destroy(void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); }
+        static constexpr Ops kOps = { &Invoke, &Move, &Destroy };
+    };
+
+    template <typename Fn>
+    struct HeapOps {
+        static void Invoke(void* storage) { (**static_cast<Fn**>(storage))(); }
+        static void Move(void* dst, void* src) noexcept
+        {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+            *static_cast<Fn**>(src) = nullptr;
+        }
+        static void Destroy(void* storage) noexcept { delete *static_cast<Fn**>(storage); }
+        static constexpr Ops kOps = { &Invoke, &Move, &Destroy };
+    };
+
+    void moveFrom(Task& other) noexcept
+    {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
+
+} // namespace glex
@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file TaskQueue.h
+ * @brief 有界无锁多生产者单消费者任务队列
+ *
+ * 基于每槽位序号的环形队列（Vyukov bounded queue）：
+ *   - 任意线程 tryPush，无锁、不分配内存（任务本身满足 Task 的内联条件时）
+ *   - 仅消费者线程（渲染线程）tryPop
+ *   - 队列满时 tryPush 返回 false，由调用方决定回退策略
+ *   - 每个元素附带优先级与预估耗时，供渲染线程按帧预算调度
+ *
+ * 进度保证：tryPush 是无锁（lock-free）而非无等待（wait-free）的。
+ * 生产者以 CAS 抢占入队位置，竞争失败时重试，单次投递的步数没有上界（但总有一个生产者能成功）；
+ * 抢到位置后在发布前被挂起的生产者会让消费者暂时看不到其后的元素。
+ * RenderThread::post 在队列满时还会回退到加锁的溢出列表。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "glex/Task.h"
+
+namespace glex {
+
+/**
+ * 任务优先级（数值越小越先执行）
+ */
+enum class TaskPriority : uint8_t {
+    Urgent = 0,  // 必须在本帧执行，不受预算限制（如 RunOnRenderThreadSync）
+    High,
+    Normal,
+    Low,
+    Count
+};
+
+constexpr int kTaskPriorityCount = static_cast<int>(TaskPriority::Count);
+
+/**
+ * 队列元素：任务 + 调度信息
+ */
+struct QueuedTask {
+    Task task;
+    TaskPriority priority = TaskPriority::Normal;
+    float costMs = 0.0f;  // 预估耗时（毫秒），0 表示未知/可忽略
+};
+
+class TaskQueue {
+public:
+    /**
+     * @param capacity 容量（向上取整为 2 的幂）
+     */
+    explicit TaskQueue(size_t capacity = 1024);
+    ~TaskQueue();
+
+    // 禁止拷贝
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    /** 入队（任意线程，lock-free）；队列满时返回 false 且不移动 task */
+    bool tryPush(QueuedTask& task);
+
+    /** 出队（仅消费者线程）；队列空时返回 false */
+    bool tryPop(QueuedTask& out);
+
+    /** 近似元素数量（并发下仅供参考） */
+    size_t sizeApprox() const;
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq{0};
+        QueuedTask task;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+};
+
+} // namespace glex
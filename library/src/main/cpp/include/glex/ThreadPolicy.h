@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file ThreadPolicy.h
+ * @brief 线程调度策略（CPU 亲和性 / 优先级 / 线程名）
+ *
+ * 大小核设备上调度器常把渲染线程放到小核，帧耗时可能翻倍。
+ * ThreadPolicy 描述期望的调度方式，ApplyThreadPolicy 作用于调用线程：
+ *   - cpus / performanceCores：绑定到指定 CPU 或自动选出的非小核
+ *   - nice：调整 nice 值（越小优先级越高）
+ *   - realtime：尝试 SCHED_FIFO，无权限时回退到 nice
+ *   - name：线程名（最长 15 字节）
+ *
+ * 每次应用都描述完整状态：未指定 CPU 时恢复到全部 CPU，未开启 realtime 时回到 SCHED_OTHER，
+ * 未设置 nice 时恢复为 0，因此新策略不会叠加在旧策略之上。
+ * 非 Linux 平台上所有设置均为空操作。
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace glex {
+
+struct ThreadPolicy {
+    std::vector<int> cpus;          // 指定 CPU 列表（为空且 performanceCores 为 false 时恢复到全部 CPU）
+    bool performanceCores = false;  // 自动绑定到非小核（cpus 非空时忽略）
+    bool setNice = false;
+    int nice = 0;                   // setNice 为 true 时生效，范围 [-20, 19]；否则恢复为 0
+    bool realtime = false;          // 尝试 SCHED_FIFO；为 false 时回到 SCHED_OTHER
+    int realtimePriority = 1;       // SCHED_FIFO 优先级
+    std::string name;               // 为空时不修改
+};
+
+/**
+ * 对调用线程应用策略
+ * @param error 非空时写入未能生效的部分（其余设置仍会尝试）
+ * @return 全部设置成功时返回 true
+ */
+bool ApplyThreadPolicy(const ThreadPolicy& policy, std::string* error = nullptr);
+
+/**
+ * 只设置调用线程的线程名（最长 15 字节），不改变亲和性、nice 与调度类
+ * @param error 非空时写入失败原因
+ */
+bool SetCurrentThreadName(const std::string& name, std::string* error = nullptr);
+
+/**
+ * 非小核 CPU 列表
+ * 按 cpu_capacity（或 cpuinfo_max_freq）区分；同构设备返回全部在线 CPU
+ */
+std::vector<int> GetPerformanceCores();
+
+/** 调用线程当前所在的 CPU（不支持时返回 -1） */
+int GetCurrentCpu();
+
+} // namespace glex
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file TouchInput.h
+ * @brief 无丢失的触摸事件队列与多指状态表
+ *
+ * TouchQueue：UI 线程（单生产者）写入完整的触摸记录，渲染线程（单消费者）每帧按顺序全部取出。
+ *   - 常规路径为无锁 SpscRing，不分配内存
+ *   - 环满时转入加锁的溢出列表（与 RenderThread 的任务溢出相同），之后的事件也排在溢出列表中，
+ *     直到渲染线程取走，保证既不丢失也不乱序
+ *   - 时间戳取单调时钟（steady_clock），调用方传入的时间戳被钳制为单调不减
+ *
+ * TouchState：按 pointerId 记录每根手指的当前 / 上一个 / 按下位置、时间与速度，
+ * 由 RenderPipeline 在分发每个事件前更新，Pass 通过 RenderPass::getTouchState() 读取。
+ *
+ * 用法：
+ *   queue.push(event);                         // UI 线程
+ *   queue.drain(events);                       // 渲染线程，帧开始
+ *   for (auto& e : events) pipeline.dispatchTouch(e);
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "glex/SpscRing.h"
+
+namespace glex {
+
+/**
+ * 触摸动作（与 ArkTS 侧 setTouchEvent 的 action 一致）
+ */
+enum class TouchAction : int {
+    Down = 0,
+    Move = 1,
+    Up = 2,
+    Cancel = 3,
+};
+
+/**
+ * 一条完整的触摸记录
+ */
+struct TouchEvent {
+    float x = 0.0f;
+    float y = 0.0f;
+    int action = 0;           // TouchAction
+    int pointerId = 0;
+    int64_t timestampNs = 0;  // 单调时钟
+};
+
+/**
+ * 单根手指的状态
+ */
+struct PointerState {
+    int pointerId = -1;       // -1 表示空槽
+    bool down = false;
+    float x = 0.0f;
+    float y = 0.0f;
+    float prevX = 0.0f;       // 上一个事件的位置
+    float prevY = 0.0f;
+    float startX = 0.0f;      // 按下位置
+    float startY = 0.0f;
+    float velocityX = 0.0f;   // 像素 / 秒（相邻两事件）
+    float velocityY = 0.0f;
+    int64_t downTimeNs = 0;
+    int64_t timestampNs = 0;  // 最近一个事件的时间
+};
+
+class TouchState {
+public:
+    /** 同时跟踪的手指数上限 */
+    static constexpr int kMaxPointers = 10;
+
+    /** 按事件更新状态（抬起 / 取消后该手指保留最后状态，down 为 false） */
+    void apply(const TouchEvent& event);
+
+    /** 按 pointerId 查找（未找到返回 nullptr） */
+    const PointerState* find(int pointerId) const;
+
+    /** 按槽位访问（0 <= index < kMaxPointers，空槽的 pointerId 为 -1） */
+    const PointerState& at(int index) const { return pointers_[index]; }
+
+    /** 按下中的手指数 */
+    int getActiveCount() const;
+
+    void reset();
+
+private:
+    PointerState pointers_[kMaxPointers];
+};
+
+class TouchQueue {
+public:
+    /** 默认无锁环容量 */
+    static constexpr size_t kDefaultCapacity = 256;
+
+    explicit TouchQueue(size_t capacity = kDefaultCapacity);
+
+    // 禁止拷贝
+    TouchQueue(const TouchQueue&) = delete;
+    TouchQueue& operator=(const TouchQueue&) = delete;
+
+    /** 当前单调时刻（纳秒） */
+    static int64_t Now();
+
+    /**
+     * 入队（仅生产者线程）
+     * timestampNs <= 0 时取当前时刻；早于上一个事件时钳制为上一个事件的时间
+     */
+    void push(TouchEvent event);
+
+    /**
+     * 按入队顺序取出全部事件并追加到 out（仅消费者线程）
+     * @return 取出的数量
+     */
+    size_t drain(std::vector<TouchEvent>& out);
+
+    /** 因环满而走溢出列表的事件数（累计） */
+    uint64_t getOverflowCount() const { return overflowCount_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<TouchEvent> ring_;
+    std::mutex overflowMutex_;
+    std::vector<TouchEvent> overflow_;
+    std::atomic<bool> hasOverflow_{false};
+    std::atomic<uint64_t> overflowCount_{0};
+    int64_t lastTimestampNs_ = 0;   // 仅生产者线程
+};
+
+} // namespace glex
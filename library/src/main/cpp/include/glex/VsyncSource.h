@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file VsyncSource.h
+ * @brief 垂直同步信号源
+ *
+ * 为 FrameScheduler 提供帧节拍：
+ *   - TimerVsyncSource：基于 steady_clock 的模拟节拍，不依赖设备，可在 Linux 上验证帧节奏
+ *   - NativeVsyncSource：基于 OH_NativeVSync 的设备节拍（仅 OHOS 平台）
+ *
+ * 用法：
+ *   auto vsync = CreateDefaultVsyncSource();
+ *   renderThread.setVsyncSource(vsync);
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#ifdef OHOS_PLATFORM
+struct OH_NativeVSync;
+#endif
+
+namespace glex {
+
+class VsyncSource {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~VsyncSource() = default;
+
+    /**
+     * 阻塞等待下一次 vsync
+     * @param timestamp 输出 vsync 时间戳
+     * @return 成功返回 true；信号源不可用或被中断时返回 false
+     */
+    virtual bool waitForVsync(Clock::time_point* timestamp) = 0;
+
+    /** vsync 周期 */
+    virtual std::chrono::nanoseconds getPeriod() const = 0;
+
+    /** 唤醒阻塞中的 waitForVsync（停止渲染线程时调用） */
+    virtual void interrupt() {}
+
+    /**
+     * 清除未被消费的中断（渲染循环重新开始时调用）
+     * interrupt 在没有等待者时会保留到下一次 waitForVsync，否则重启后的第一帧会失去 vsync 对齐
+     */
+    virtual void clearInterrupt() {}
+};
+
+/**
+ * 模拟 vsync：按固定周期产生绝对时间节拍
+ */
+class TimerVsyncSource : public VsyncSource {
+public:
+    explicit TimerVsyncSource(std::chrono::nanoseconds period = std::chrono::nanoseconds(16666667));
+
+    bool waitForVsync(Clock::time_point* timestamp) override;
+    std::chrono::nanoseconds getPeriod() const override { return period_; }
+    void interrupt() override;
+    void clearInterrupt() override;
+
+private:
+    std::chrono::nanoseconds period_;
+    Clock::time_point next_{};
+    bool anchored_ = false;
+    std::atomic<bool> interrupted_{false};
+};
+
+#ifdef OHOS_PLATFORM
+/**
+ * 设备 vsync：通过 OH_NativeVSync_RequestFrame 逐帧请求回调
+ */
+class NativeVsyncSource : public VsyncSource {
+public:
+    NativeVsyncSource();
+    ~NativeVsyncSource() override;
+
+    NativeVsyncSource(const NativeVsyncSource&) = delete;
+    NativeVsyncSource& operator=(const NativeVsyncSource&) = delete;
+
+    /** 是否成功创建了系统 vsync 句柄 */
+    bool isValid() const { return vsync_ != nullptr; }
+
+    bool waitForVsync(Clock::time_point* timestamp) override;
+    std::chrono::nanoseconds getPeriod() const override;
+    void interrupt() override;
+    void clearInterrupt() override;
+
+private:
+    /**
+     * 回调共享的状态（引用计数）：信号源与每个未完成的 RequestFrame 各持有一个引用，
+     * 信号源析构后迟到的回调仍只访问此状态，由最后一个引用释放。
+     * 每个请求带序号，只有当前等待的请求能唤醒等待者；超时未回调的请求个数有上限
+     */
+    struct CallbackState;
+
+    static void OnVsync(long long timestamp, void* data);
+
+    OH_NativeVSync* vsync_ = nullptr;
+    CallbackState* state_ = nullptr;
+};
+#endif
+
+/**
+ * 创建当前平台默认的 vsync 源：OHOS 上优先使用设备 vsync，否则回退为模拟节拍
+ */
+std::shared_ptr<VsyncSource> CreateDefaultVsyncSource();
+
+} // namespace glex
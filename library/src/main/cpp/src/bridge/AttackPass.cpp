@@ -1,9 +1,12 @@
 #include "AttackPass.h"
 #include "glex/GLResourceTracker.h"
+#include "glex/JobSystem.h"
 #include "glex/Log.h"
+#include "glex/ShareGroup.h"
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace glex {
 
@@ -33,8 +36,13 @@ layout(location = 0) in vec2 a_position;
 layout(location = 1) in float a_size;
 layout(location = 2) in float a_life;
 layout(location = 3) in float a_alpha;
+layout(location = 4) in vec2 a_prevPosition;
 
-uniform mat4 u_projection;
+layout(std140) uniform GlexFrame {
+    mat4 u_projection;
+    float u_time;
+    float u_alpha;
+};
 
 out float v_life;
 out float v_alpha;
@@ -42,7 +50,8 @@ out float v_alpha;
 void main() {
     v_life = a_life;
     v_alpha = a_alpha;
-    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+    vec2 position = mix(a_prevPosition, a_position, u_alpha);
+    gl_Position = u_projection * vec4(position, 0.0, 1.0);
     gl_PointSize = a_size;
 }
 )";
@@ -79,14 +88,6 @@ void main() {
 }
 )";
 
-struct AttackVertex {
-    float x;
-    float y;
-    float size;
-    float life;
-    float alpha;
-};
-
 } // namespace
 
 void AttackPass::onInitialize(int width, int height)
@@ -101,12 +102,16 @@ void AttackPass::onInitialize(int width, int height)
         maxPointSize_ = std::min(maxPointSize_, range[1]);
     }
 
-    if (!shader_.build(kAttackVertSrc, kAttackFragSrc)) {
+    shader_ = ShareGroup::BuildProgram(shareGroup_, kAttackVertSrc, kAttackFragSrc);
+    if (!shader_) {
         GLEX_LOGE("AttackPass: shader build failed");
         glReady_ = false;
         return;
     }
 
+    FrameUniforms::BindProgram(*shader_);
+    frameUniforms_.initialize();
+
     glGenVertexArrays(1, &vao_);
     GLResourceTracker::Get().OnCreateVertexArray();
     glGenBuffers(1, &vbo_);
@@ -127,6 +132,8 @@ void AttackPass::onInitialize(int width, int height)
     glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(3);
     glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
     glBindVertexArray(0);
 
     glReady_ = true;
@@ -138,16 +145,15 @@ void AttackPass::onResize(int width, int height)
     (void)width;
     (void)height;
     updateOrigin();
+    lastDamage_ = {};
 }
 
 void AttackPass::onUpdate(float deltaTime)
 {
     time_ += deltaTime;
+    // 特效持续动画：OnDemand 模式下每帧请求下一帧
+    requestRedraw();
 
-    if (touchCooldown_ > 0.0f) {
-        touchCooldown_ -= deltaTime;
-        if (touchCooldown_ < 0.0f) touchCooldown_ = 0.0f;
-    }
     if (shockTimer_ >= 0.0f) {
         shockTimer_ += deltaTime;
         if (shockTimer_ >= shockDuration_) {
@@ -155,20 +161,29 @@ void AttackPass::onUpdate(float deltaTime)
         }
     }
 
+    // 粒子积分互不依赖，按工作线程数分块并行
     const float damping = std::exp(-drag_ * deltaTime);
-    for (auto& p : particles_) {
-        if (p.life <= 0.0f) {
-            continue;
-        }
-        p.x += p.vx * deltaTime;
-        p.y += p.vy * deltaTime;
-        p.vx *= damping;
-        p.vy *= damping;
-        p.life -= deltaTime;
-        if (p.life <= 0.0f) {
-            p.life = 0.0f;
-        }
-    }
+    AttackParticle* particles = particles_.data();
+    JobSystem& jobs = JobSystem::Get();
+    jobs.parallelFor(0, particles_.size(), jobs.grainFor(particles_.size(), kMinParticleGrain),
+        [particles, damping, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                AttackParticle& p = particles[i];
+                if (p.life <= 0.0f) {
+                    continue;
+                }
+                p.prevX = p.x;
+                p.prevY = p.y;
+                p.x += p.vx * deltaTime;
+                p.y += p.vy * deltaTime;
+                p.vx *= damping;
+                p.vy *= damping;
+                p.life -= deltaTime;
+                if (p.life <= 0.0f) {
+                    p.life = 0.0f;
+                }
+            }
+        });
 
     idleTimer_ += deltaTime;
     if (idleTimer_ >= slashInterval_) {
@@ -194,11 +209,10 @@ void AttackPass::onUpdate(float deltaTime)
     }
 }
 
-void AttackPass::onRender()
+void AttackPass::onPrepareRender()
 {
-    if (!glReady_) return;
-
-    std::vector<AttackVertex> verts;
+    std::vector<AttackVertex>& verts = backVerts_;
+    verts.clear();
     verts.reserve(static_cast<size_t>(maxParticles_) * static_cast<size_t>(std::max(1, trailSteps_)));
 
     for (const auto& p : particles_) {
@@ -229,6 +243,8 @@ void AttackPass::onRender()
             v.size = trailSize;
             v.life = life;
             v.alpha = trailAlpha;
+            v.prevX = p.prevX - nx * offset;
+            v.prevY = p.prevY - ny * offset;
             verts.push_back(v);
         }
     }
@@ -254,6 +270,8 @@ void AttackPass::onRender()
             v.size = 14.0f + 10.0f * head;
             v.life = 0.12f + 0.2f * progress;
             v.alpha = 0.25f + 0.75f * head;
+            v.prevX = x;
+            v.prevY = y;
             verts.push_back(v);
         }
 
@@ -264,6 +282,8 @@ void AttackPass::onRender()
         head.size = 28.0f;
         head.life = 0.08f;
         head.alpha = 1.0f;
+        head.prevX = head.x;
+        head.prevY = head.y;
         verts.push_back(head);
     }
 
@@ -281,25 +301,91 @@ void AttackPass::onRender()
             v.size = 10.0f - 4.0f * t;
             v.life = 0.55f;
             v.alpha = 0.25f * alpha;
+            v.prevX = v.x;
+            v.prevY = v.y;
             verts.push_back(v);
         }
     }
 
+    // 点精灵以顶点为中心、边长为 size；插值位置落在上一步与当前步之间，两端都计入
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    for (size_t i = 0; i < verts.size(); i++) {
+        const AttackVertex& v = verts[i];
+        float half = v.size * 0.5f;
+        float loX = std::min(v.x, v.prevX) - half;
+        float loY = std::min(v.y, v.prevY) - half;
+        float hiX = std::max(v.x, v.prevX) + half;
+        float hiY = std::max(v.y, v.prevY) + half;
+        if (i == 0) {
+            minX = loX;
+            minY = loY;
+            maxX = hiX;
+            maxY = hiY;
+            continue;
+        }
+        minX = std::min(minX, loX);
+        minY = std::min(minY, loY);
+        maxX = std::max(maxX, hiX);
+        maxY = std::max(maxY, hiY);
+    }
+    backBounds_ = {};
+    if (!verts.empty()) {
+        backBounds_.x = static_cast<int>(std::floor(minX));
+        backBounds_.y = static_cast<int>(std::floor(minY));
+        backBounds_.width = static_cast<int>(std::ceil(maxX)) - backBounds_.x;
+        backBounds_.height = static_cast<int>(std::ceil(maxY)) - backBounds_.y;
+    }
+}
+
+void AttackPass::onPublish()
+{
+    frontVerts_.swap(backVerts_);
+    std::swap(frontBounds_, backBounds_);
+}
+
+void AttackPass::onCollectDamage(std::vector<DamageRect>& rects)
+{
+    // 像素坐标（y 向下）转换为 GL 窗口坐标（y 向上），外扩 1 像素覆盖抗锯齿边缘
+    DamageRect current;
+    if (!frontBounds_.isEmpty()) {
+        current.x = frontBounds_.x - 1;
+        current.y = height_ - (frontBounds_.y + frontBounds_.height) - 1;
+        current.width = frontBounds_.width + 2;
+        current.height = frontBounds_.height + 2;
+    }
+    if (!current.isEmpty()) {
+        rects.push_back(current);
+    }
+    if (!lastDamage_.isEmpty()) {
+        rects.push_back(lastDamage_);
+    }
+    lastDamage_ = current;
+}
+
+void AttackPass::onRender()
+{
+    if (!glReady_) return;
+
+    const std::vector<AttackVertex>& verts = frontVerts_;
     if (verts.empty()) return;
 
     const float w = static_cast<float>(width_);
     const float h = static_cast<float>(height_);
-    float proj[16];
-    MakeOrtho(proj, 0.0f, w, h, 0.0f, -1.0f, 1.0f);
+    FrameUniformData frame;
+    MakeOrtho(frame.projection, 0.0f, w, h, 0.0f, -1.0f, 1.0f);
+    frame.alpha = getInterpolationAlpha();
 
     GLboolean depthEnabled = glIsEnabled(GL_DEPTH_TEST);
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE);
 
-    shader_.use();
-    shader_.setUniformMatrix4fv("u_projection", proj);
-
+    // 逐实例的值在本实例的 UBO 中，共享程序不再有可变的 uniform 状态，无需绘制锁
+    frameUniforms_.upload(frame);
+    shader_->use();
     glBindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER,
@@ -317,7 +403,8 @@ void AttackPass::onRender()
 
 void AttackPass::onDestroy()
 {
-    shader_.destroy();
+    shader_.reset();
+    frameUniforms_.release();
     if (vbo_) {
         GLResourceTracker::Get().OnDeleteBuffer();
         glDeleteBuffers(1, &vbo_);
@@ -342,6 +429,8 @@ void AttackPass::initParticles()
         p.baseSize = 0.0f;
         p.x = 0.0f;
         p.y = 0.0f;
+        p.prevX = 0.0f;
+        p.prevY = 0.0f;
         p.vx = 0.0f;
         p.vy = 0.0f;
     }
@@ -379,6 +468,8 @@ void AttackPass::spawnBurst(float sweepAngleDeg, int count)
         float radius = distRadius(rng_);
         p.x = originX_ + radialX * radius;
         p.y = originY_ + radialY * radius;
+        p.prevX = p.x;
+        p.prevY = p.y;
 
         float mix = distMix(rng_);
         float dirX = tangentX * (1.0f - mix) + radialX * mix;
@@ -412,14 +503,26 @@ void AttackPass::updateOrigin()
     originY_ = static_cast<float>(height_) * 0.72f;
 }
 
-void AttackPass::onTouch(float x, float y, int action, int pointerId)
+void AttackPass::onTouchEvent(const TouchEvent& event)
 {
-    setTouch(x, y, action, pointerId);
+    setTouch(event);
 }
 
 void AttackPass::setTouch(float x, float y, int action, int pointerId)
 {
-    (void)action;
+    TouchEvent event;
+    event.x = x;
+    event.y = y;
+    event.action = action;
+    event.pointerId = pointerId;
+    event.timestampNs = TouchQueue::Now();
+    setTouch(event);
+}
+
+void AttackPass::setTouch(const TouchEvent& event)
+{
+    float x = event.x;
+    float y = event.y;
     if (!std::isfinite(x) || !std::isfinite(y)) {
         return;
     }
@@ -427,36 +530,39 @@ void AttackPass::setTouch(float x, float y, int action, int pointerId)
         x = std::max(0.0f, std::min(x, static_cast<float>(width_)));
         y = std::max(0.0f, std::min(y, static_cast<float>(height_)));
     }
-    float dx = 0.0f;
-    float dy = 0.0f;
-    bool hasDir = false;
-    if (hasLastTouch_ && pointerId == lastPointerId_) {
-        dx = x - lastTouchX_;
-        dy = y - lastTouchY_;
-        if ((dx * dx + dy * dy) > 16.0f) {
-            hasDir = true;
-        }
+    TouchAction action = static_cast<TouchAction>(event.action);
+    bool released = action == TouchAction::Up || action == TouchAction::Cancel;
+
+    // 新的按下或换了手指：锚点从当前点开始
+    if (action == TouchAction::Down || !hasAnchor_ || event.pointerId != anchorPointerId_) {
+        anchorX_ = x;
+        anchorY_ = y;
+        anchorPointerId_ = event.pointerId;
+        hasAnchor_ = true;
     }
 
-    lastTouchX_ = x;
-    lastTouchY_ = y;
-    lastPointerId_ = pointerId;
-    hasLastTouch_ = true;
-
-    if (touchCooldown_ > 0.0f) {
+    if (lastSlashNs_ > 0 && event.timestampNs - lastSlashNs_ < kTouchCooldownNs) {
+        hasAnchor_ = hasAnchor_ && !released;
         return;
     }
-    touchCooldown_ = 0.12f;
-
-    originX_ = x;
-    originY_ = y;
+    lastSlashNs_ = event.timestampNs;
 
+    float dx = x - anchorX_;
+    float dy = y - anchorY_;
     float center = sweepCenterDeg_;
-    if (hasDir) {
+    if ((dx * dx + dy * dy) > 16.0f) {
         center = std::atan2(dy, dx) * 180.0f / kPi;
     }
+
+    originX_ = x;
+    originY_ = y;
     beginSlash(center);
     idleTimer_ = 0.0f;
+
+    // 下一次斩击的方向从这里量起
+    anchorX_ = x;
+    anchorY_ = y;
+    hasAnchor_ = !released;
 }
 
 } // namespace glex
@@ -5,13 +5,22 @@
  * @brief 割草游戏“扇形斩击”粒子特效 Pass
  *
  * 表现为扇形爆发的高亮能量粒子，带拖尾与衰减。
+ * 上报损坏区域（本帧与上一帧粒子范围），局部呈现时只重绘特效附近的区域。
+ *
+ * 固定步长：顶点同时携带上一步与当前步的位置，onRender 按插值系数在着色器中混合，
+ * 模拟频率低于刷新率时粒子仍平滑移动。
+ *
+ * 触摸：按事件时间戳计算 120ms 冷却；斩击方向取自锚点（按下位置或上一次斩击位置）
+ * 到当前点的向量，快速滑动时一帧内到达的多个事件也能得到整段滑动的方向。
  */
 
+#include <memory>
 #include <random>
 #include <vector>
 
 #include <GLES3/gl3.h>
 
+#include "glex/FrameUniforms.h"
 #include "glex/RenderPass.h"
 #include "glex/ShaderProgram.h"
 
@@ -20,6 +29,8 @@ namespace glex {
 struct AttackParticle {
     float x;
     float y;
+    float prevX;   // 上一步的位置（用于插值）
+    float prevY;
     float vx;
     float vy;
     float life;
@@ -27,17 +38,36 @@ struct AttackParticle {
     float baseSize;
 };
 
+struct AttackVertex {
+    float x;
+    float y;
+    float size;
+    float life;
+    float alpha;
+    float prevX;   // 上一步的位置；不随模拟移动的顶点与 x / y 相同
+    float prevY;
+};
+
 class AttackPass : public RenderPass {
 public:
-    AttackPass() : RenderPass("AttackPass") {}
+    AttackPass() : RenderPass("AttackPass")
+    {
+        parallelUpdateSafe_ = true;
+        doubleBuffered_ = true;
+        reportsDamage_ = true;
+    }
     void setTouch(float x, float y, int action, int pointerId);
+    void setTouch(const TouchEvent& event);
 
 protected:
     void onInitialize(int width, int height) override;
     void onResize(int width, int height) override;
     void onUpdate(float deltaTime) override;
+    void onPrepareRender() override;
+    void onPublish() override;
     void onRender() override;
-    void onTouch(float x, float y, int action, int pointerId) override;
+    void onTouchEvent(const TouchEvent& event) override;
+    void onCollectDamage(std::vector<DamageRect>& rects) override;
     void onDestroy() override;
 
 private:
@@ -50,6 +80,7 @@ private:
     int maxParticles_ = 1800;
     int burstCount_ = 240;
     int nextIndex_ = 0;
+    static constexpr size_t kMinParticleGrain = 128;   // 每块至少的粒子数
 
     float time_ = 0.0f;
     float slashTimer_ = -1.0f;
@@ -68,11 +99,12 @@ private:
     float drag_ = 3.2f;
     int trailSteps_ = 4;
     float trailSpacing_ = 14.0f;
-    float touchCooldown_ = 0.0f;
-    float lastTouchX_ = -1.0f;
-    float lastTouchY_ = -1.0f;
-    int lastPointerId_ = -1;
-    bool hasLastTouch_ = false;
+    static constexpr int64_t kTouchCooldownNs = 120000000;   // 120ms
+    int64_t lastSlashNs_ = 0;
+    float anchorX_ = 0.0f;
+    float anchorY_ = 0.0f;
+    int anchorPointerId_ = -1;
+    bool hasAnchor_ = false;
     float shockTimer_ = -1.0f;
     float shockDuration_ = 0.25f;
     float shockRadiusStart_ = 40.0f;
@@ -82,7 +114,17 @@ private:
 
     float maxPointSize_ = 32.0f;
 
-    ShaderProgram shader_;
+    // 顶点数据双缓冲：onPrepareRender 写 back，onPublish 交换，onRender 读 front
+    std::vector<AttackVertex> backVerts_;
+    std::vector<AttackVertex> frontVerts_;
+
+    // 顶点包围盒（像素坐标，y 向下），随顶点一起双缓冲；上一帧上报的损坏用于擦除旧粒子
+    DamageRect backBounds_;
+    DamageRect frontBounds_;
+    DamageRect lastDamage_;
+
+    std::shared_ptr<ShaderProgram> shader_;   // 加入共享组时来自共享组
+    FrameUniforms frameUniforms_;             // 投影与插值系数（本实例独有）
     GLuint vao_ = 0;
     GLuint vbo_ = 0;
     bool glReady_ = false;
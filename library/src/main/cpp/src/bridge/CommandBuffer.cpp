@@ -0,0 +1,192 @@
+#include "CommandBuffer.h"
+#include "UniformTable.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace glex {
+namespace bridge {
+
+namespace {
+
+constexpr size_t kTouchPayloadBytes = 24;
+constexpr size_t kClearColorPayloadBytes = 16;
+
+template <typename T>
+T ReadAt(const uint8_t* p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+uint16_t ReadU16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace
+
+float Command::readValue(size_t index) const
+{
+    return ReadAt<float>(values + index * sizeof(float));
+}
+
+void Command::copyValues(float* out) const
+{
+    std::memcpy(out, values, valueCount * sizeof(float));
+}
+
+bool CommandReader::fail(const std::string& message)
+{
+    error_ = message + " at byte " + std::to_string(offset_);
+    return false;
+}
+
+bool CommandReader::next(Command& out)
+{
+    if (offset_ >= size_ || hasError()) {
+        return false;
+    }
+    if (size_ - offset_ < kCommandHeaderBytes) {
+        return fail("truncated command header");
+    }
+    const uint8_t* header = data_ + offset_;
+    uint8_t op = header[0];
+    size_t payloadBytes = ReadU16(header + 2);
+    if (size_ - offset_ - kCommandHeaderBytes < payloadBytes) {
+        return fail("truncated payload");
+    }
+    const uint8_t* payload = header + kCommandHeaderBytes;
+
+    out = Command();
+    out.op = static_cast<CommandOp>(op);
+    switch (out.op) {
+        case CommandOp::SetUniform: {
+            if (payloadBytes < 1) {
+                return fail("setUniform: empty payload");
+            }
+            size_t nameLength = payload[0];
+            if (nameLength == 0 || 1 + nameLength > payloadBytes) {
+                return fail("setUniform: invalid name");
+            }
+            size_t valueBytes = payloadBytes - 1 - nameLength;
+            if (valueBytes == 0 || valueBytes % sizeof(float) != 0 ||
+                valueBytes / sizeof(float) > UniformTable::kMaxValues) {
+                return fail("setUniform: invalid value size");
+            }
+            out.name = reinterpret_cast<const char*>(payload + 1);
+            out.nameLength = nameLength;
+            out.values = payload + 1 + nameLength;
+            out.valueCount = valueBytes / sizeof(float);
+            for (size_t i = 0; i < out.valueCount; i++) {
+                if (!std::isfinite(out.readValue(i))) {
+                    return fail("setUniform: non-finite value");
+                }
+            }
+            break;
+        }
+        case CommandOp::SetUniformByHandle: {
+            if (payloadBytes <= sizeof(int32_t) || (payloadBytes - sizeof(int32_t)) % sizeof(float) != 0 ||
+                (payloadBytes - sizeof(int32_t)) / sizeof(float) > UniformTable::kMaxValues) {
+                return fail("setUniformByHandle: invalid payload size");
+            }
+            out.handle = ReadAt<int32_t>(payload);
+            if (out.handle < 0) {
+                return fail("setUniformByHandle: invalid handle");
+            }
+            out.values = payload + sizeof(int32_t);
+            out.valueCount = (payloadBytes - sizeof(int32_t)) / sizeof(float);
+            for (size_t i = 0; i < out.valueCount; i++) {
+                if (!std::isfinite(out.readValue(i))) {
+                    return fail("setUniformByHandle: non-finite value");
+                }
+            }
+            break;
+        }
+        case CommandOp::Touch: {
+            if (payloadBytes != kTouchPayloadBytes) {
+                return fail("touch: invalid payload size");
+            }
+            out.touch.x = ReadAt<float>(payload);
+            out.touch.y = ReadAt<float>(payload + 4);
+            out.touch.action = ReadAt<int32_t>(payload + 8);
+            out.touch.pointerId = ReadAt<int32_t>(payload + 12);
+            double timestamp = ReadAt<double>(payload + 16);
+            if (!std::isfinite(out.touch.x) || !std::isfinite(out.touch.y)) {
+                return fail("touch: non-finite coordinates");
+            }
+            if (out.touch.action < static_cast<int>(TouchAction::Down) ||
+                out.touch.action > static_cast<int>(TouchAction::Cancel)) {
+                return fail("touch: invalid action");
+            }
+            out.touch.timestampNs = std::isfinite(timestamp) ? static_cast<int64_t>(timestamp) : 0;
+            break;
+        }
+        case CommandOp::SetPassEnabled: {
+            if (payloadBytes < 2) {
+                return fail("setPassEnabled: invalid payload");
+            }
+            out.enabled = payload[0] != 0;
+            out.name = reinterpret_cast<const char*>(payload + 1);
+            out.nameLength = payloadBytes - 1;
+            break;
+        }
+        case CommandOp::SetClearColor: {
+            if (payloadBytes != kClearColorPayloadBytes) {
+                return fail("setClearColor: invalid payload size");
+            }
+            for (int i = 0; i < 4; i++) {
+                out.color[i] = ReadAt<float>(payload + i * 4);
+                if (!std::isfinite(out.color[i])) {
+                    return fail("setClearColor: non-finite value");
+                }
+            }
+            break;
+        }
+        default:
+            return fail("unknown command " + std::to_string(op));
+    }
+    offset_ += kCommandHeaderBytes + payloadBytes;
+    return true;
+}
+
+bool ValidateCommands(const uint8_t* data, size_t size, size_t* count, std::string* error)
+{
+    CommandReader reader(data, size);
+    Command command;
+    size_t n = 0;
+    while (reader.next(command)) {
+        n++;
+    }
+    if (reader.hasError()) {
+        if (error) {
+            *error = reader.getError();
+        }
+        return false;
+    }
+    if (count) {
+        *count = n;
+    }
+    return true;
+}
+
+void StampTouchTimestamps(uint8_t* data, size_t size, int64_t nowNs)
+{
+    size_t offset = 0;
+    while (size - offset >= kCommandHeaderBytes) {
+        uint8_t* header = data + offset;
+        size_t payloadBytes = ReadU16(header + 2);
+        if (static_cast<CommandOp>(header[0]) == CommandOp::Touch && payloadBytes == kTouchPayloadBytes) {
+            uint8_t* stamp = header + kCommandHeaderBytes + 16;
+            if (!(ReadAt<double>(stamp) > 0.0)) {
+                double now = static_cast<double>(nowNs);
+                std::memcpy(stamp, &now, sizeof(now));
+            }
+        }
+        offset += kCommandHeaderBytes + payloadBytes;
+    }
+}
+
+} // namespace bridge
+} // namespace glex
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file CommandBuffer.h
+ * @brief ArkTS 批量命令的二进制格式与解码
+ *
+ * ArkTS 侧以 GlexCommandEncoder 把一帧要做的修改编码进一个 ArrayBuffer，
+ * 经一次 NAPI 调用（submitCommands）整体提交，渲染线程在下一帧开始时一次性应用。
+ *
+ * 格式（小端，无对齐要求）：命令依次排列，每条为
+ *   u8 op | u8 reserved (0) | u16 payloadBytes | payload
+ *
+ *   SetUniform     (1)  u8 nameLength | name (ASCII) | f32 x n（n >= 1）
+ *   Touch          (2)  f32 x | f32 y | i32 action | i32 pointerId | f64 timestampNs（<= 0 时取 submitCommands 调用时刻）
+ *   SetPassEnabled (3)  u8 enabled | name (ASCII，占满剩余 payload)
+ *   SetClearColor  (4)  f32 r | f32 g | f32 b | f32 a
+ *   SetUniformByHandle (5)  i32 handle（getUniformHandle 返回值）| f32 x n（n >= 1）
+ *
+ * 提交时整体校验：任一命令格式错误（含 uniform 超过 UniformTable::kMaxValues 个 float）则整批拒绝；
+ * 句柄与 uniform 名由 submitCommands 对照 UniformTable 再校验一遍，保证要么全部生效、要么都不生效。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "glex/TouchInput.h"
+
+namespace glex {
+namespace bridge {
+
+enum class CommandOp : uint8_t {
+    SetUniform = 1,
+    Touch = 2,
+    SetPassEnabled = 3,
+    SetClearColor = 4,
+    SetUniformByHandle = 5,
+};
+
+/** 每条命令的头部字节数 */
+constexpr size_t kCommandHeaderBytes = 4;
+
+/**
+ * 解码后的一条命令（指针指向原缓冲区，缓冲区存活期间有效）
+ */
+struct Command {
+    CommandOp op = CommandOp::SetUniform;
+    const char* name = nullptr;        // SetUniform / SetPassEnabled
+    size_t nameLength = 0;
+    int handle = -1;                   // SetUniformByHandle
+    const uint8_t* values = nullptr;   // SetUniform / SetUniformByHandle：f32 数组（可能未对齐，用 readValue 读取）
+    size_t valueCount = 0;
+    bool enabled = false;              // SetPassEnabled
+    float color[4] = { 0.0f, 0.0f, 0.0f, 1.0f };   // SetClearColor
+    TouchEvent touch;                  // Touch
+
+    float readValue(size_t index) const;
+    void copyValues(float* out) const;
+    std::string getName() const { return std::string(name, nameLength); }
+};
+
+class CommandReader {
+public:
+    CommandReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    /**
+     * 解码下一条命令
+     * @return false 表示已读完或格式错误（hasError() 区分）
+     */
+    bool next(Command& out);
+
+    bool hasError() const { return !error_.empty(); }
+    const std::string& getError() const { return error_; }
+
+private:
+    bool fail(const std::string& message);
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+    std::string error_;
+};
+
+/**
+ * 校验整批命令
+ * @param count 输出命令条数
+ * @param error 失败原因
+ */
+bool ValidateCommands(const uint8_t* data, size_t size, size_t* count, std::string* error);
+
+/**
+ * 把已校验缓冲区中时间戳 <= 0 的触摸命令改写为 nowNs（提交时调用，时间戳反映提交时刻而非应用时刻）
+ */
+void StampTouchTimestamps(uint8_t* data, size_t size, int64_t nowNs);
+
+} // namespace bridge
+} // namespace glex
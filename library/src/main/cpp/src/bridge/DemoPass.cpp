@@ -1,7 +1,9 @@
 #include "DemoPass.h"
 #include "glex/Log.h"
+#include "glex/ShareGroup.h"
 
 #include <cmath>
+#include <utility>
 
 namespace glex {
 
@@ -22,7 +24,11 @@ static const char* kBgFragSrc = R"(#version 300 es
 precision highp float;
 in vec2 v_uv;
 out vec4 fragColor;
-uniform float u_time;
+layout(std140) uniform GlexFrame {
+    mat4 u_projection;
+    float u_time;
+    float u_alpha;
+};
 void main() {
     // 深空渐变：顶部深蓝 → 底部暗蓝紫
     vec3 topColor = vec3(0.02, 0.03, 0.12);
@@ -43,8 +49,11 @@ layout(location = 0) in vec2 a_position;
 layout(location = 1) in float a_size;
 layout(location = 2) in vec4 a_color;
 
-uniform mat4 u_projection;
-uniform float u_time;
+layout(std140) uniform GlexFrame {
+    mat4 u_projection;
+    float u_time;
+    float u_alpha;
+};
 
 out vec4 v_color;
 
@@ -76,14 +85,20 @@ static const char* kMeteorVertSrc = R"(#version 300 es
 layout(location = 0) in vec2 a_position;
 layout(location = 1) in float a_size;
 layout(location = 2) in float a_alpha;
+layout(location = 3) in vec2 a_prevPosition;
 
-uniform mat4 u_projection;
+layout(std140) uniform GlexFrame {
+    mat4 u_projection;
+    float u_time;
+    float u_alpha;
+};
 
 out float v_alpha;
 
 void main() {
     v_alpha = a_alpha;
-    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+    vec2 position = mix(a_prevPosition, a_position, u_alpha);
+    gl_Position = u_projection * vec4(position, 0.0, 1.0);
     gl_PointSize = a_size;
 }
 )";
@@ -135,9 +150,12 @@ void DemoPass::onResize(int width, int height)
 
 void DemoPass::onUpdate(float deltaTime)
 {
+    prevTime_ = time_;
     time_ += deltaTime;
+    // 星空持续动画：OnDemand 模式下每帧请求下一帧
+    requestRedraw();
 
-    // 更新星星闪烁
+    // 更新星星闪烁（星星只有数百颗，切块调度的开销超过计算本身，直接串行）
     for (auto& star : stars_) {
         float twinkle = sinf(time_ * star.twinkleSpeed + star.twinklePhase);
         star.brightness = 0.5f + 0.5f * twinkle;
@@ -146,6 +164,8 @@ void DemoPass::onUpdate(float deltaTime)
     // 更新流星
     for (auto& m : meteors_) {
         if (!m.active) continue;
+        m.prevX = m.x;
+        m.prevY = m.y;
         m.x += m.vx * deltaTime;
         m.y += m.vy * deltaTime;
         m.life -= deltaTime;
@@ -164,26 +184,14 @@ void DemoPass::onUpdate(float deltaTime)
     }
 }
 
-void DemoPass::onRender()
+void DemoPass::onPrepareRender()
 {
-    if (!glReady_) return;
-
-    float w = static_cast<float>(width_);
-    float h = static_cast<float>(height_);
-
-    // ---- 1. 渲染背景 ----
-    bgShader_.use();
-    bgShader_.setUniform1f("u_time", time_);
-    glBindVertexArray(bgVao_);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
-
-    // ---- 2. 渲染星星 ----
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    back_.time = time_;
+    back_.prevTime = prevTime_;
 
-    // 准备星星顶点数据：[x, y, size, r, g, b, a]
-    std::vector<float> starData;
+    // 星星顶点数据：[x, y, size, r, g, b, a]
+    std::vector<float>& starData = back_.stars;
+    starData.clear();
     starData.reserve(stars_.size() * 7);
     for (const auto& s : stars_) {
         starData.push_back(s.x);
@@ -195,24 +203,8 @@ void DemoPass::onRender()
         starData.push_back(s.brightness * 0.9f);
     }
 
-    float proj[16];
-    makeOrtho(proj, 0, w, h, 0, -1, 1);
-
-    starShader_.use();
-    starShader_.setUniformMatrix4fv("u_projection", proj);
-    starShader_.setUniform1f("u_time", time_);
-
-    glBindVertexArray(starVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, starVbo_);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(starData.size() * sizeof(float)),
-                 starData.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(stars_.size()));
-    glBindVertexArray(0);
-
-    // ---- 3. 渲染流星 ----
-    struct MeteorVert { float x, y, size, alpha; };
-    std::vector<MeteorVert> meteorData;
+    std::vector<MeteorVertex>& meteorData = back_.meteors;
+    meteorData.clear();
     for (const auto& m : meteors_) {
         if (!m.active) continue;
         float progress = m.life / m.maxLife;
@@ -223,23 +215,65 @@ void DemoPass::onRender()
             float t = static_cast<float>(i) / TRAIL;
             float trailAlpha = progress * (1.0f - t * 0.9f);
             float trailSize = m.size * (1.0f - t * 0.7f);
-            MeteorVert v;
+            MeteorVertex v;
             v.x = m.x - m.vx * t * 0.15f;
             v.y = m.y - m.vy * t * 0.15f;
             v.size = trailSize;
             v.alpha = trailAlpha;
+            v.prevX = m.prevX - m.vx * t * 0.15f;
+            v.prevY = m.prevY - m.vy * t * 0.15f;
             meteorData.push_back(v);
         }
     }
+}
 
-    if (!meteorData.empty()) {
-        meteorShader_.use();
-        meteorShader_.setUniformMatrix4fv("u_projection", proj);
+void DemoPass::onPublish()
+{
+    std::swap(front_, back_);
+}
 
+void DemoPass::onRender()
+{
+    if (!glReady_) return;
+
+    float w = static_cast<float>(width_);
+    float h = static_cast<float>(height_);
+
+    // 三个程序共用本实例的 GlexFrame 块：每帧写入一次，共享程序不再有可变的 uniform 状态
+    FrameUniformData frame;
+    makeOrtho(frame.projection, 0, w, h, 0, -1, 1);
+    frame.alpha = getInterpolationAlpha();
+    frame.time = front_.prevTime + (front_.time - front_.prevTime) * frame.alpha;
+    frameUniforms_.upload(frame);
+
+    // ---- 1. 渲染背景 ----
+    bgShader_->use();
+    glBindVertexArray(bgVao_);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+
+    // ---- 2. 渲染星星 ----
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+    const std::vector<float>& starData = front_.stars;
+    starShader_->use();
+    glBindVertexArray(starVao_);
+    glBindBuffer(GL_ARRAY_BUFFER, starVbo_);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(starData.size() * sizeof(float)),
+                 starData.data(), GL_DYNAMIC_DRAW);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(starData.size() / 7));
+    glBindVertexArray(0);
+
+    // ---- 3. 渲染流星 ----
+    const std::vector<MeteorVertex>& meteorData = front_.meteors;
+    if (!meteorData.empty()) {
+        meteorShader_->use();
         glBindVertexArray(meteorVao_);
         glBindBuffer(GL_ARRAY_BUFFER, meteorVbo_);
         glBufferData(GL_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(meteorData.size() * sizeof(MeteorVert)),
+                     static_cast<GLsizeiptr>(meteorData.size() * sizeof(MeteorVertex)),
                      meteorData.data(), GL_DYNAMIC_DRAW);
         glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(meteorData.size()));
         glBindVertexArray(0);
@@ -250,9 +284,12 @@ void DemoPass::onRender()
 
 void DemoPass::onDestroy()
 {
-    bgShader_.destroy();
-    starShader_.destroy();
-    meteorShader_.destroy();
+    // 共享程序与缓冲在最后一个使用者释放时删除
+    bgShader_.reset();
+    starShader_.reset();
+    meteorShader_.reset();
+    bgQuad_.reset();
+    frameUniforms_.release();
 
     auto deleteVAO = [](GLuint& vao, GLuint& vbo) {
         if (vbo) { glDeleteBuffers(1, &vbo); vbo = 0; }
@@ -335,6 +372,8 @@ void DemoPass::spawnMeteor()
 
         m.x = distX(rng_);
         m.y = 0.0f;
+        m.prevX = m.x;
+        m.prevY = m.y;
         m.vx = cosf(angle) * speed;
         m.vy = sinf(angle) * speed;
         m.maxLife = distLife(rng_);
@@ -350,20 +389,30 @@ void DemoPass::initGLResources()
     if (glReady_) return;
 
     // ---- 背景 ----
-    bgShader_.build(kBgVertSrc, kBgFragSrc);
+    bgShader_ = ShareGroup::BuildProgram(shareGroup_, kBgVertSrc, kBgFragSrc);
 
-    float bgQuad[] = { -1, -1,  1, -1,  -1, 1,  1, 1 };
+    static const float bgQuad[] = { -1, -1,  1, -1,  -1, 1,  1, 1 };
+    GLuint quadBuffer = 0;
+    if (shareGroup_) {
+        bgQuad_ = shareGroup_->acquireStaticBuffer("glex.DemoPass.bgQuad", bgQuad, sizeof(bgQuad));
+        quadBuffer = bgQuad_ ? *bgQuad_ : 0;
+    }
+    if (quadBuffer == 0) {
+        glGenBuffers(1, &bgVbo_);
+        glBindBuffer(GL_ARRAY_BUFFER, bgVbo_);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(bgQuad), bgQuad, GL_STATIC_DRAW);
+        quadBuffer = bgVbo_;
+    }
+    // VAO 是容器对象，不能跨上下文共享
     glGenVertexArrays(1, &bgVao_);
-    glGenBuffers(1, &bgVbo_);
     glBindVertexArray(bgVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, bgVbo_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(bgQuad), bgQuad, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
     glBindVertexArray(0);
 
     // ---- 星星 ----
-    starShader_.build(kStarVertSrc, kStarFragSrc);
+    starShader_ = ShareGroup::BuildProgram(shareGroup_, kStarVertSrc, kStarFragSrc);
 
     glGenVertexArrays(1, &starVao_);
     glGenBuffers(1, &starVbo_);
@@ -380,23 +429,31 @@ void DemoPass::initGLResources()
     glBindVertexArray(0);
 
     // ---- 流星 ----
-    meteorShader_.build(kMeteorVertSrc, kMeteorFragSrc);
+    meteorShader_ = ShareGroup::BuildProgram(shareGroup_, kMeteorVertSrc, kMeteorFragSrc);
 
     glGenVertexArrays(1, &meteorVao_);
     glGenBuffers(1, &meteorVbo_);
     glBindVertexArray(meteorVao_);
     glBindBuffer(GL_ARRAY_BUFFER, meteorVbo_);
-    // [x, y, size, alpha] = 4 floats per point
-    constexpr int MSTRIDE = 4 * sizeof(float);
+    // [x, y, size, alpha, prevX, prevY] = 6 floats per point
+    constexpr int MSTRIDE = sizeof(MeteorVertex);
     glEnableVertexAttribArray(0); // position
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, MSTRIDE, (void*)0);
     glEnableVertexAttribArray(1); // size
     glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, MSTRIDE, (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(2); // alpha
     glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, MSTRIDE, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(3); // previous position
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, MSTRIDE, (void*)(4 * sizeof(float)));
     glBindVertexArray(0);
 
-    glReady_ = true;
+    glReady_ = bgShader_ && starShader_ && meteorShader_;
+    if (glReady_) {
+        FrameUniforms::BindProgram(*bgShader_);
+        FrameUniforms::BindProgram(*starShader_);
+        FrameUniforms::BindProgram(*meteorShader_);
+        glReady_ = frameUniforms_.initialize();
+    }
 }
 
 } // namespace glex
@@ -10,11 +10,13 @@
  * 效果：渐变背景 + 闪烁星星 + 流星
  */
 
+#include <memory>
 #include <random>
 #include <vector>
 
 #include <GLES3/gl3.h>
 
+#include "glex/FrameUniforms.h"
 #include "glex/RenderPass.h"
 #include "glex/ShaderProgram.h"
 
@@ -31,6 +33,7 @@ struct DemoStar {
 
 struct DemoMeteor {
     float x, y;          // 位置
+    float prevX, prevY;  // 上一步的位置（用于插值）
     float vx, vy;        // 速度
     float life;          // 剩余生命
     float maxLife;       // 最大生命
@@ -40,12 +43,18 @@ struct DemoMeteor {
 
 class DemoPass : public RenderPass {
 public:
-    DemoPass() : RenderPass("DemoPass") {}
+    DemoPass() : RenderPass("DemoPass")
+    {
+        parallelUpdateSafe_ = true;
+        doubleBuffered_ = true;
+    }
 
 protected:
     void onInitialize(int width, int height) override;
     void onResize(int width, int height) override;
     void onUpdate(float deltaTime) override;
+    void onPrepareRender() override;
+    void onPublish() override;
     void onRender() override;
     void onDestroy() override;
 
@@ -67,25 +76,42 @@ private:
 
     // 时间
     float time_ = 0.0f;
+    float prevTime_ = 0.0f;   // 上一步的时间（用于插值）
 
     // 随机数
     std::mt19937 rng_{42};
 
-    // GL 资源 - 背景
-    ShaderProgram bgShader_;
+    // 渲染数据（双缓冲：onPrepareRender 写 back，onPublish 交换，onRender 读 front）
+    // 流星位置与背景时间同时保存上一步与当前步，onRender 按插值系数混合
+    struct MeteorVertex { float x, y, size, alpha, prevX, prevY; };
+    struct RenderData {
+        float time = 0.0f;
+        float prevTime = 0.0f;
+        std::vector<float> stars;  // [x, y, size, r, g, b, a]
+        std::vector<MeteorVertex> meteors;
+    };
+    RenderData back_;
+    RenderData front_;
+
+    // GL 资源 - 背景（加入共享组时着色器与全屏四边形来自共享组）
+    std::shared_ptr<ShaderProgram> bgShader_;
+    std::shared_ptr<const GLuint> bgQuad_;
     GLuint bgVao_ = 0;
     GLuint bgVbo_ = 0;
 
     // GL 资源 - 星星
-    ShaderProgram starShader_;
+    std::shared_ptr<ShaderProgram> starShader_;
     GLuint starVao_ = 0;
     GLuint starVbo_ = 0;
 
     // GL 资源 - 流星
-    ShaderProgram meteorShader_;
+    std::shared_ptr<ShaderProgram> meteorShader_;
     GLuint meteorVao_ = 0;
     GLuint meteorVbo_ = 0;
 
+    // 投影、时间与插值系数（本实例独有的 UBO，三个程序共用）
+    FrameUniforms frameUniforms_;
+
     bool glReady_ = false;
 };
 
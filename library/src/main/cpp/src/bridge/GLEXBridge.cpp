@@ -3,11 +3,13 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
-#include <future>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -28,6 +30,8 @@
 #include "glex/GLResourceTracker.h"
 #include "ShaderPass.h"
 #include "BuiltinPassRegistry.h"
+#include "CommandBuffer.h"
+#include "UniformTable.h"
 #include "glex/PassRegistry.h"
 
 namespace glex {
@@ -75,6 +79,11 @@ static bool GetDouble(napi_env env, napi_value value, double* out)
     return napi_get_value_double(env, value, out) == napi_ok;
 }
 
+static bool GetBool(napi_env env, napi_value value, bool* out)
+{
+    return napi_get_value_bool(env, value, out) == napi_ok;
+}
+
 static bool GetSurfaceId(napi_env env, napi_value value, uint64_t* out)
 {
     napi_valuetype type;
@@ -152,6 +161,40 @@ static bool GetFloatArray(napi_env env, napi_value value, std::vector<float>& ou
     return true;
 }
 
+// Float32Array：返回底层存储的指针，不拷贝
+static bool GetFloat32Array(napi_env env, napi_value value, const float** data, size_t* count)
+{
+    bool isTypedArray = false;
+    if (napi_is_typedarray(env, value, &isTypedArray) != napi_ok || !isTypedArray) {
+        return false;
+    }
+    napi_typedarray_type type;
+    size_t length = 0;
+    void* buffer = nullptr;
+    napi_value arraybuffer;
+    size_t offset = 0;
+    if (napi_get_typedarray_info(env, value, &type, &length, &buffer, &arraybuffer, &offset) != napi_ok ||
+        type != napi_float32_array) {
+        return false;
+    }
+    *data = static_cast<const float*>(buffer);
+    *count = length;
+    return true;
+}
+
+static bool GetNamedProperty(napi_env env, napi_value object, const char* name, napi_value* out)
+{
+    bool has = false;
+    if (napi_has_named_property(env, object, name, &has) != napi_ok || !has) {
+        return false;
+    }
+    if (napi_get_named_property(env, object, name, out) != napi_ok) {
+        return false;
+    }
+    napi_valuetype type;
+    return napi_typeof(env, *out, &type) == napi_ok && type != napi_undefined && type != napi_null;
+}
+
 static std::string GetXComponentId(OH_NativeXComponent* component)
 {
     if (!component) {
@@ -189,6 +232,87 @@ static void FinalizeMappedRawfile(napi_env env, void* data, void* hint)
     }
 }
 
+static void FinalizeCapturePixels(napi_env env, void* data, void* hint)
+{
+    (void)env;
+    (void)hint;
+    delete[] static_cast<uint8_t*>(data);
+}
+
+// 流式采集：在 JS 线程上把工作线程交来的帧交给 ArkTS 回调
+static void CallStreamCallback(napi_env env, napi_value jsCallback, void* context, void* data)
+{
+    (void)context;
+    std::unique_ptr<StreamFrame> frame(static_cast<StreamFrame*>(data));
+    if (env == nullptr || jsCallback == nullptr || !frame) {
+        return;
+    }
+
+    size_t length = frame->byteLength();
+    uint8_t* pixels = frame->pixels.release();
+    napi_value buffer;
+    if (napi_create_external_arraybuffer(env, pixels, length, FinalizeCapturePixels, nullptr, &buffer) != napi_ok) {
+        void* copy = nullptr;
+        napi_create_arraybuffer(env, length, &copy, &buffer);
+        if (copy) {
+            memcpy(copy, pixels, length);
+        }
+        delete[] pixels;
+    }
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_value v;
+    napi_create_int64(env, static_cast<int64_t>(frame->seq), &v);
+    napi_set_named_property(env, result, "seq", v);
+    napi_create_double(env, static_cast<double>(frame->timestampNs) / 1e6, &v);
+    napi_set_named_property(env, result, "timestamp", v);
+    napi_create_int32(env, frame->width, &v);
+    napi_set_named_property(env, result, "width", v);
+    napi_create_int32(env, frame->height, &v);
+    napi_set_named_property(env, result, "height", v);
+    napi_set_named_property(env, result, "pixels", buffer);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    napi_call_function(env, undefined, jsCallback, 1, &result, nullptr);
+}
+
+// 触摸事件从产生（事件时间戳）到进入队列的延迟，按来源（XComponent 原生回调 / ArkTS）统计
+struct TouchSourceStats {
+    // 时间戳与 steady_clock 不同源或明显异常时不计入延迟
+    static constexpr int64_t kMaxPlausibleDelayNs = 1000000000;
+
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> delaySamples{0};
+    std::atomic<uint64_t> delayNs{0};
+    std::atomic<uint64_t> maxDelayNs{0};
+
+    void record(int64_t timestampNs)
+    {
+        events.fetch_add(1, std::memory_order_relaxed);
+        if (timestampNs <= 0) {
+            return;
+        }
+        int64_t delay = TouchQueue::Now() - timestampNs;
+        if (delay < 0 || delay > kMaxPlausibleDelayNs) {
+            return;
+        }
+        delaySamples.fetch_add(1, std::memory_order_relaxed);
+        delayNs.fetch_add(static_cast<uint64_t>(delay), std::memory_order_relaxed);
+        if (static_cast<uint64_t>(delay) > maxDelayNs.load(std::memory_order_relaxed)) {
+            maxDelayNs.store(static_cast<uint64_t>(delay), std::memory_order_relaxed);
+        }
+    }
+
+    double averageDelayMs() const
+    {
+        uint64_t samples = delaySamples.load(std::memory_order_relaxed);
+        return samples > 0 ? static_cast<double>(delayNs.load(std::memory_order_relaxed)) / 1e6 /
+                             static_cast<double>(samples) : 0.0;
+    }
+};
+
 // ============================================================
 // 渲染实例
 // ============================================================
@@ -204,6 +328,7 @@ public:
     void HandleSurfaceCreated(OHNativeWindow* window);
     void HandleSurfaceChanged(uint64_t width, uint64_t height);
     void HandleSurfaceDestroyed();
+    void HandleNativeTouch(OH_NativeXComponent* component, void* window);
 
     static napi_value NapiNew(napi_env env, napi_callback_info info);
     static void NapiFinalize(napi_env env, void* data, void* hint);
@@ -219,19 +344,49 @@ public:
 
     static napi_value NapiSetBackgroundColor(napi_env env, napi_callback_info info);
     static napi_value NapiSetTargetFPS(napi_env env, napi_callback_info info);
+    static napi_value NapiSetRenderMode(napi_env env, napi_callback_info info);
+    static napi_value NapiRequestRender(napi_env env, napi_callback_info info);
+    static napi_value NapiSetAdaptiveFrameRate(napi_env env, napi_callback_info info);
+    static napi_value NapiSetParallelUpdate(napi_env env, napi_callback_info info);
+    static napi_value NapiSetPipelinedUpdate(napi_env env, napi_callback_info info);
+    static napi_value NapiSetFixedTimestep(napi_env env, napi_callback_info info);
+    static napi_value NapiSetSharedRenderThread(napi_env env, napi_callback_info info);
+    static napi_value NapiSetShareGroup(napi_env env, napi_callback_info info);
+    static napi_value NapiSetPartialPresent(napi_env env, napi_callback_info info);
+    static napi_value NapiSetMaxFramesInFlight(napi_env env, napi_callback_info info);
+    static napi_value NapiSetResolutionScale(napi_env env, napi_callback_info info);
+    static napi_value NapiSetDynamicResolution(napi_env env, napi_callback_info info);
+    static napi_value NapiGetRenderResolution(napi_env env, napi_callback_info info);
+    static napi_value NapiSetRenderThreadPolicy(napi_env env, napi_callback_info info);
     static napi_value NapiSetShaderSources(napi_env env, napi_callback_info info);
     static napi_value NapiLoadShaderFromRawfile(napi_env env, napi_callback_info info);
     static napi_value NapiLoadRawfileBytes(napi_env env, napi_callback_info info);
     static napi_value NapiSetUniform(napi_env env, napi_callback_info info);
+    static napi_value NapiGetUniformHandle(napi_env env, napi_callback_info info);
+    static napi_value NapiSetUniformByHandle(napi_env env, napi_callback_info info);
+    static napi_value NapiSubmitCommands(napi_env env, napi_callback_info info);
     static napi_value NapiSetPasses(napi_env env, napi_callback_info info);
     static napi_value NapiAddPass(napi_env env, napi_callback_info info);
     static napi_value NapiRemovePass(napi_env env, napi_callback_info info);
     static napi_value NapiGetPasses(napi_env env, napi_callback_info info);
     static napi_value NapiSetTouchEvent(napi_env env, napi_callback_info info);
+    static napi_value NapiSetNativeTouch(napi_env env, napi_callback_info info);
+    static napi_value NapiGetTouchStats(napi_env env, napi_callback_info info);
 
     static napi_value NapiGetCurrentFPS(napi_env env, napi_callback_info info);
+    static napi_value NapiGetMissedFrames(napi_env env, napi_callback_info info);
+    static napi_value NapiGetFrameStats(napi_env env, napi_callback_info info);
+    static napi_value NapiGetFrameRateSteps(napi_env env, napi_callback_info info);
     static napi_value NapiGetGLInfo(napi_env env, napi_callback_info info);
     static napi_value NapiGetGpuStats(napi_env env, napi_callback_info info);
+    static napi_value NapiSetProfilerEnabled(napi_env env, napi_callback_info info);
+    static napi_value NapiGetProfilerTrace(napi_env env, napi_callback_info info);
+    static napi_value NapiSaveProfilerTrace(napi_env env, napi_callback_info info);
+    static napi_value NapiRequestCapture(napi_env env, napi_callback_info info);
+    static napi_value NapiTakeCapture(napi_env env, napi_callback_info info);
+    static napi_value NapiStartStreamCapture(napi_env env, napi_callback_info info);
+    static napi_value NapiStopStreamCapture(napi_env env, napi_callback_info info);
+    static napi_value NapiGetStreamStats(napi_env env, napi_callback_info info);
     static napi_value NapiGetLastError(napi_env env, napi_callback_info info);
     static napi_value NapiClearLastError(napi_env env, napi_callback_info info);
 
@@ -240,9 +395,15 @@ private:
     void ClearError();
     std::string GetError();
 
+    void MarkDirty();
+    bool PushTouch(const TouchEvent& event, bool native);
     void RequestResize(int width, int height);
     void RequestShaderUpdate(const std::string& vert, const std::string& frag);
-    void RequestUniform(const std::string& name, const std::vector<float>& values);
+    void ApplyShaderUpdate();
+    bool RequestUniform(int handle, const float* values, size_t count);
+    void ApplyUniformChanges(bool all);
+    ShaderPass& EnsureCustomPass();
+    void ApplySubmittedCommands();
     bool ReadRawfileToString(napi_env env, napi_value jsResMgr, const std::string& path, std::string& out);
     bool ReadRawfileToBytes(napi_env env, napi_value jsResMgr, const std::string& path, std::vector<uint8_t>& out);
 
@@ -255,12 +416,21 @@ private:
     std::shared_ptr<RenderPass> CreatePassByName(const std::string& name);
     void ApplyRequestedPasses(int width, int height);
 
+    GLContextConfig MakeContextConfigLocked();
     void InitializeRenderer(int width, int height);
     void DestroyRenderer();
+    void ApplyFrameRateGovernorLocked();
     void StartRenderLoopLocked();
+    void ApplyPendingChanges();
+    void RenderFrame();
     void StopRenderLoopLocked();
     void DestroySurfaceLocked(bool keepStartRequested);
+    bool SwapSurfaceLocked(OHNativeWindow* window, bool ownsWindow);
     bool RunOnRenderThreadSync(std::function<void()> task);
+    std::string ExportProfilerTraceLocked();
+    void ServiceCaptures(bool issue);
+    void StopStreamLocked();
+    void ApplyRenderScale();
 
     napi_env env_;
 
@@ -280,6 +450,59 @@ private:
     std::atomic<float> bgColorB_{0.10f};
     std::atomic<float> bgColorA_{1.0f};
     std::atomic<int> targetFPS_{60};
+    std::atomic<int> renderMode_{static_cast<int>(RenderMode::Continuous)};
+    std::atomic<bool> parallelUpdate_{false};
+    std::atomic<bool> pipelinedUpdate_{false};
+    std::atomic<float> fixedUpdateHz_{0.0f};
+    std::atomic<int> maxFixedSteps_{RenderPipeline::kDefaultMaxFixedSteps};
+    bool adaptiveFrameRate_ = false;
+    std::vector<int> frameRateLadder_;
+    ThreadPolicy threadPolicy_;
+    bool hasThreadPolicy_ = false;
+    bool sharedRenderThread_ = false;
+    bool shareGroupEnabled_ = false;
+    std::atomic<bool> partialPresent_{false};
+    std::atomic<bool> damageInvalidated_{false};
+    std::atomic<bool> profilerEnabled_{false};
+    std::atomic<int> maxFramesInFlight_{0};
+
+    // 动态分辨率：配置由 JS 线程写入，scaler_ 只在渲染线程访问
+    std::atomic<bool> dynamicResolution_{false};
+    std::atomic<float> resolutionScale_{1.0f};
+    std::atomic<float> minResolutionScale_{0.5f};
+    std::atomic<float> maxResolutionScale_{1.0f};
+    std::atomic<bool> resolutionDirty_{false};
+    std::atomic<float> currentResolutionScale_{1.0f};
+    std::atomic<int> renderWidth_{0};
+    std::atomic<int> renderHeight_{0};
+    std::unique_ptr<ResolutionScaler> scaler_;
+
+    // 异步截图：请求与结果由 captureMutex_ 保护，readback_ 只在渲染线程访问
+    struct CaptureRequest {
+        uint64_t id = 0;
+        bool fullFrame = true;
+        int x = 0;   // 像素坐标，原点在左上
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+    static constexpr size_t kMaxQueuedCaptures = 8;
+    static constexpr size_t kMaxCaptureResults = 8;
+    std::mutex captureMutex_;
+    std::deque<CaptureRequest> captureRequests_;
+    std::deque<ReadbackImage> captureResults_;
+    std::vector<uint64_t> pendingCaptureIds_;
+    uint64_t nextCaptureId_ = 1;
+    std::atomic<bool> captureQueued_{false};
+    std::unique_ptr<AsyncReadback> readback_;
+    bool frameDrawn_ = false;
+
+    // 流式采集：streamer_ 在渲染线程上安装 / 移除，JS 回调经线程安全函数投递
+    std::unique_ptr<FrameStreamer> streamer_;
+    napi_threadsafe_function streamTsfn_ = nullptr;
+    StreamStats lastStreamStats_;
+    std::vector<DamageRect> damage_;
+    float lastClearColor_[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
     std::atomic<int> pendingWidth_{0};
     std::atomic<int> pendingHeight_{0};
     std::atomic<bool> resizePending_{false};
@@ -289,17 +512,35 @@ private:
     std::string pendingVert_;
     std::string pendingFrag_;
     std::atomic<bool> shaderPending_{false};
+    // 着色器编译作为可顺延的普通任务投递给渲染线程（预估耗时用于帧预算）
+    static constexpr float kShaderCompileCostMs = 8.0f;
+    std::atomic<bool> shaderTaskQueued_{false};
     std::shared_ptr<ShaderPass> customPass_;
-    std::mutex uniformMutex_;
-    std::unordered_map<std::string, std::vector<float>> pendingUniforms_;
-    std::atomic<bool> uniformDirty_{false};
-
-    std::atomic<float> touchX_{0.0f};
-    std::atomic<float> touchY_{0.0f};
-    std::atomic<int> touchAction_{0};
-    std::atomic<int> touchPointerId_{0};
-    std::atomic<uint64_t> touchSeq_{0};
-    uint64_t lastAppliedTouchSeq_ = 0;
+    // 自定义 Pass 刚创建：下一次 ApplyUniformChanges 补齐全部已写入的 uniform（渲染线程独占）
+    bool customPassFresh_ = false;
+    // setUniform / setUniformByHandle / 批量命令共用：按句柄暂存，渲染线程每帧只取走改动过的
+    UniformTable uniformTable_;
+
+    // submitCommands：已校验的命令字节按提交顺序拼接，渲染线程在下一帧开始时整体取走
+    std::mutex commandMutex_;
+    std::vector<uint8_t> pendingCommands_;
+    std::atomic<bool> commandsDirty_{false};
+    std::vector<uint8_t> commandScratch_;          // 仅渲染线程
+    std::vector<float> commandValues_;             // 仅渲染线程
+
+    // UI 线程写入、渲染线程每帧按顺序全部取出的触摸记录
+    // 生产者：XComponent 触摸回调与 NAPI setTouchEvent，二者都在 ArkTS 主线程
+    TouchQueue touchQueue_;
+    std::vector<TouchEvent> touchBatch_;           // 仅渲染线程
+    int64_t lastTouchNs_ = 0;                      // 仅渲染线程：已排入分发的最后一个触摸时间戳
+    std::atomic<uint64_t> touchEventsDelivered_{0};
+    std::atomic<uint64_t> touchDispatchDelayNs_{0};
+    std::atomic<uint64_t> touchDispatchSamples_{0};
+    // 原生触摸：XComponent 回调直接入队；收到第一个原生事件后忽略 ArkTS 转发的事件
+    std::atomic<bool> nativeTouchEnabled_{true};
+    std::atomic<bool> nativeTouchActive_{false};
+    TouchSourceStats nativeTouchStats_;
+    TouchSourceStats arktsTouchStats_;
 
     std::mutex passMutex_;
     std::vector<std::string> requestedPasses_{ "DemoPass" };
@@ -365,6 +606,7 @@ void GLEXEngine::UnbindXComponentId()
     std::lock_guard<std::mutex> lock(registry.mutex);
     registry.engines.erase(xcomponentId_);
     xcomponentId_.clear();
+    nativeTouchActive_.store(false, std::memory_order_relaxed);
 }
 
 void GLEXEngine::HandleSurfaceCreated(OHNativeWindow* window)
@@ -372,12 +614,22 @@ void GLEXEngine::HandleSurfaceCreated(OHNativeWindow* window)
     GLEX_LOGI("XComponent: OnSurfaceCreated");
     std::lock_guard<std::mutex> lock(mutex_);
 
+    // 快速路径：沿用上下文与 Pipeline，只重建 EGLSurface
+    if (SwapSurfaceLocked(window, false)) {
+        surfaceId_ = 0;
+        if (startRequested_.load()) {
+            StartRenderLoopLocked();
+            startRequested_.store(false);
+        }
+        return;
+    }
+
     DestroySurfaceLocked(true);
     ownsWindow_ = false;
     nativeWindow_ = window;
 
     glContext_ = std::make_unique<GLContext>();
-    if (!glContext_->initialize(reinterpret_cast<EGLNativeWindowType>(window))) {
+    if (!glContext_->initialize(reinterpret_cast<EGLNativeWindowType>(window), MakeContextConfigLocked())) {
         GLEX_LOGE("XComponent: GL init failed");
         SetError("XComponent: GL init failed");
         glContext_.reset();
@@ -406,16 +658,25 @@ void GLEXEngine::HandleSurfaceDestroyed()
 {
     GLEX_LOGI("XComponent: OnSurfaceDestroyed");
     std::lock_guard<std::mutex> lock(mutex_);
-    DestroyRenderer();
-    StopRenderLoopLocked();
-    if (glContext_) {
-        glContext_->destroy();
-        glContext_.reset();
+    if (glContext_ && glContext_->isInitialized() && !glContext_->isOffscreen()) {
+        // 保留上下文、Pipeline 与 GL 对象，窗口重新创建时只需重建 EGLSurface；
+        // 销毁前在渲染的，重新创建后自动恢复
+        bool wasRunning = renderThread_ && renderThread_->isRunning();
+        StopRenderLoopLocked();
+        glContext_->releaseSurface();
+        startRequested_.store(wasRunning);
+    } else {
+        DestroyRenderer();
+        StopRenderLoopLocked();
+        if (glContext_) {
+            glContext_->destroy();
+            glContext_.reset();
+        }
+        startRequested_.store(false);
     }
     nativeWindow_ = nullptr;
     ownsWindow_ = false;
     surfaceId_ = 0;
-    startRequested_.store(false);
     resizePending_.store(false, std::memory_order_relaxed);
     pendingWidth_.store(0, std::memory_order_relaxed);
     pendingHeight_.store(0, std::memory_order_relaxed);
@@ -438,6 +699,94 @@ std::string GLEXEngine::GetError()
     std::lock_guard<std::mutex> lock(errorMutex_);
     return lastError_;
 }
+
+void GLEXEngine::MarkDirty()
+{
+    if (renderThread_) {
+        renderThread_->requestRender();
+    }
+}
+
+bool GLEXEngine::PushTouch(const TouchEvent& event, bool native)
+{
+    (native ? nativeTouchStats_ : arktsTouchStats_).record(event.timestampNs);
+    // 原生回调已在投递同一批事件：ArkTS 转发的只计入统计
+    if (!native && nativeTouchActive_.load(std::memory_order_relaxed) &&
+        nativeTouchEnabled_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    touchQueue_.push(event);
+    MarkDirty();
+    return true;
+}
+
+static int ToTouchAction(OH_NativeXComponent_TouchEventType type)
+{
+    switch (type) {
+        case OH_NATIVEXCOMPONENT_DOWN:
+            return static_cast<int>(TouchAction::Down);
+        case OH_NATIVEXCOMPONENT_MOVE:
+            return static_cast<int>(TouchAction::Move);
+        case OH_NATIVEXCOMPONENT_UP:
+            return static_cast<int>(TouchAction::Up);
+        case OH_NATIVEXCOMPONENT_CANCEL:
+            return static_cast<int>(TouchAction::Cancel);
+        default:
+            return -1;
+    }
+}
+
+void GLEXEngine::HandleNativeTouch(OH_NativeXComponent* component, void* window)
+{
+    if (!nativeTouchEnabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    OH_NativeXComponent_TouchEvent touch;
+    if (OH_NativeXComponent_GetTouchEvent(component, window, &touch) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        return;
+    }
+    int action = ToTouchAction(touch.type);
+    if (action < 0) {
+        return;
+    }
+    if (!nativeTouchActive_.exchange(true, std::memory_order_relaxed)) {
+        GLEX_LOGI("XComponent: native touch dispatch active");
+    }
+
+    TouchEvent event;
+    if (action == static_cast<int>(TouchAction::Move)) {
+        // 与本事件合并的历史移动点先按顺序入队（不含本事件自身）
+        int32_t count = 0;
+        OH_NativeXComponent_HistoricalPoint* points = nullptr;
+        if (OH_NativeXComponent_GetHistoricalPoints(component, window, &count, &points) ==
+                OH_NATIVEXCOMPONENT_RESULT_SUCCESS && points) {
+            for (int32_t i = 0; i < count; i++) {
+                const OH_NativeXComponent_HistoricalPoint& point = points[i];
+                if (point.timeStamp >= touch.timeStamp || !std::isfinite(point.x) || !std::isfinite(point.y)) {
+                    continue;
+                }
+                event.x = point.x;
+                event.y = point.y;
+                event.action = action;
+                event.pointerId = point.id;
+                event.timestampNs = point.timeStamp;
+                PushTouch(event, true);
+            }
+        }
+    }
+
+    if (!std::isfinite(touch.x) || !std::isfinite(touch.y)) {
+        return;
+    }
+    // 原生坐标已是相对组件的像素坐标，与表面尺寸一致，无需 ArkTS 侧的 vp 换算
+    event.x = touch.x;
+    event.y = touch.y;
+    event.action = action;
+    event.pointerId = touch.id;
+    event.timestampNs = touch.timeStamp;
+    PushTouch(event, true);
+}
+
 void GLEXEngine::RequestResize(int width, int height)
 {
     pendingWidth_.store(width, std::memory_order_relaxed);
@@ -446,24 +795,84 @@ void GLEXEngine::RequestResize(int width, int height)
     if (glContext_) {
         glContext_->setSurfaceSize(width, height);
     }
+    MarkDirty();
 }
 
 void GLEXEngine::RequestShaderUpdate(const std::string& vert, const std::string& frag)
 {
-    std::lock_guard<std::mutex> lock(shaderMutex_);
-    pendingVert_ = vert;
-    pendingFrag_ = frag;
-    shaderPending_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(shaderMutex_);
+        pendingVert_ = vert;
+        pendingFrag_ = frag;
+        shaderPending_.store(true, std::memory_order_release);
+    }
+    // 编译链接较慢：以普通优先级、带预估耗时投递，帧预算不足时顺延，期间继续用旧程序绘制。
+    // 渲染线程尚未创建时由第一帧的 ApplyPendingChanges 处理
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (renderThread_ && !shaderTaskQueued_.exchange(true, std::memory_order_acq_rel) &&
+            !renderThread_->post([this]() { ApplyShaderUpdate(); }, TaskPriority::Normal, kShaderCompileCostMs)) {
+            // 渲染循环已停止：留给重启后的第一帧处理
+            shaderTaskQueued_.store(false, std::memory_order_release);
+        }
+    }
+    MarkDirty();
 }
 
-void GLEXEngine::RequestUniform(const std::string& name, const std::vector<float>& values)
+void GLEXEngine::ApplyShaderUpdate()
 {
-    if (name.empty() || values.empty()) {
+    shaderTaskQueued_.store(false, std::memory_order_release);
+    if (!shaderPending_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    std::string vert;
+    std::string frag;
+    {
+        std::lock_guard<std::mutex> lock(shaderMutex_);
+        vert = pendingVert_;
+        frag = pendingFrag_;
+    }
+    if (!glContext_ || glContext_->getGLESVersionMajor() < 3) {
+        SetError("Custom shader requires OpenGL ES 3.0+");
         return;
     }
-    std::lock_guard<std::mutex> lock(uniformMutex_);
-    pendingUniforms_[name] = values;
-    uniformDirty_.store(true, std::memory_order_release);
+    ShaderPass& pass = EnsureCustomPass();
+    pass.setShaderSources(vert, frag);
+    pass.compilePending();
+    ClearError();
+    ApplyUniformChanges(false);
+}
+
+ShaderPass& GLEXEngine::EnsureCustomPass()
+{
+    if (!customPass_) {
+        customPass_ = std::make_shared<ShaderPass>();
+        customPassFresh_ = true;
+    }
+    return *customPass_;
+}
+
+bool GLEXEngine::RequestUniform(int handle, const float* values, size_t count)
+{
+    if (!uniformTable_.set(handle, values, count)) {
+        return false;
+    }
+    MarkDirty();
+    return true;
+}
+
+void GLEXEngine::ApplyUniformChanges(bool all)
+{
+    // 自定义 Pass 尚未创建时同样取走（清除脏标记），创建后的第一次再补齐全部值
+    if (customPass_ && customPassFresh_) {
+        customPassFresh_ = false;
+        all = true;
+    }
+    uniformTable_.consume(all, [this](int handle, const std::string& name, const float* values, size_t count) {
+        if (customPass_) {
+            customPass_->setUniform(handle, name, values, count);
+        }
+    });
 }
 
 bool GLEXEngine::ReadRawfileToString(napi_env env, napi_value jsResMgr, const std::string& path, std::string& out)
@@ -577,6 +986,7 @@ void GLEXEngine::RequestPasses(std::vector<std::string> passes)
     std::lock_guard<std::mutex> lock(passMutex_);
     requestedPasses_ = std::move(passes);
     passesDirty_.store(true, std::memory_order_release);
+    MarkDirty();
 }
 
 void GLEXEngine::RequestAddPass(const std::string& name)
@@ -589,6 +999,7 @@ void GLEXEngine::RequestAddPass(const std::string& name)
     if (std::find(requestedPasses_.begin(), requestedPasses_.end(), name) == requestedPasses_.end()) {
         requestedPasses_.push_back(name);
         passesDirty_.store(true, std::memory_order_release);
+        MarkDirty();
     }
 }
 
@@ -599,6 +1010,7 @@ void GLEXEngine::RequestRemovePass(const std::string& name)
     if (it != requestedPasses_.end()) {
         requestedPasses_.erase(it, requestedPasses_.end());
         passesDirty_.store(true, std::memory_order_release);
+        MarkDirty();
     }
 }
 
@@ -611,9 +1023,7 @@ std::vector<std::string> GLEXEngine::GetRequestedPassesSnapshot()
 std::shared_ptr<RenderPass> GLEXEngine::CreatePassByName(const std::string& name)
 {
     if (name == "ShaderPass") {
-        if (!customPass_) {
-            customPass_ = std::make_shared<ShaderPass>();
-        }
+        EnsureCustomPass();
         return customPass_;
     }
     return glex::CreatePass(name);
@@ -628,6 +1038,7 @@ void GLEXEngine::ApplyRequestedPasses(int width, int height)
     }
 
     pipeline_->destroy();
+    pipeline_->setShareGroup(glContext_ ? glContext_->getShareGroup() : nullptr);
 
     if (!passes.empty()) {
         if (!glContext_ || glContext_->getGLESVersionMajor() < 3) {
@@ -650,6 +1061,19 @@ void GLEXEngine::ApplyRequestedPasses(int width, int height)
     }
 }
 
+GLContextConfig GLEXEngine::MakeContextConfigLocked()
+{
+    GLContextConfig config;
+    if (shareGroupEnabled_) {
+        config.shareGroup = ShareGroup::Acquire();
+        if (!config.shareGroup) {
+            // 共享组不可用时退回独立上下文，不影响出图
+            GLEX_LOGW("Share group unavailable, using a standalone context");
+        }
+    }
+    return config;
+}
+
 void GLEXEngine::InitializeRenderer(int width, int height)
 {
     RequestResize(width, height);
@@ -658,6 +1082,7 @@ void GLEXEngine::InitializeRenderer(int width, int height)
 
 void GLEXEngine::DestroyRenderer()
 {
+    StopStreamLocked();
     if (!pipeline_) {
         return;
     }
@@ -666,101 +1091,312 @@ void GLEXEngine::DestroyRenderer()
             if (pipeline_) {
                 pipeline_->destroy();
             }
+            if (readback_) {
+                readback_->release();
+            }
+            if (scaler_) {
+                scaler_->releaseGpu();
+            }
         });
     }
     pipeline_.reset();
+    readback_.reset();
+    scaler_.reset();
+}
+
+void GLEXEngine::ApplyFrameRateGovernorLocked()
+{
+    if (!renderThread_) {
+        return;
+    }
+    FrameRateGovernor& governor = renderThread_->getFrameRateGovernor();
+    FrameRateGovernor::Config config;
+    if (!frameRateLadder_.empty()) {
+        config.ladder = frameRateLadder_;
+    }
+    governor.configure(config);
+    governor.setEnabled(adaptiveFrameRate_);
 }
 
 void GLEXEngine::StartRenderLoopLocked()
 {
-    if (!glContext_ || !glContext_->isInitialized()) return;
+    if (!glContext_ || !glContext_->isInitialized() || !glContext_->hasSurface()) return;
     if (renderThread_ && renderThread_->isRunning()) return;
 
     glContext_->clearCurrent();
 
     if (!renderThread_) {
         renderThread_ = std::make_unique<RenderThread>();
+        renderThread_->setVsyncSource(CreateDefaultVsyncSource());
+        ApplyFrameRateGovernorLocked();
+        if (hasThreadPolicy_) {
+            renderThread_->setThreadPolicy(threadPolicy_);
+        }
     }
 
-    lastAppliedTouchSeq_ = 0;
+    renderThread_->setShared(sharedRenderThread_);
     renderThread_->setTargetFPS(targetFPS_.load(std::memory_order_relaxed));
+    renderThread_->setRenderMode(static_cast<RenderMode>(renderMode_.load(std::memory_order_relaxed)));
     renderThread_->start(glContext_.get(), [this](float deltaTime) {
-        if (passesDirty_.exchange(false, std::memory_order_acq_rel)) {
-            ApplyRequestedPasses(glContext_->getWidth(), glContext_->getHeight());
-        }
-        if (shaderPending_.exchange(false, std::memory_order_acq_rel)) {
-            std::string vert;
-            std::string frag;
-            {
-                std::lock_guard<std::mutex> lock(shaderMutex_);
-                vert = pendingVert_;
-                frag = pendingFrag_;
-            }
-            if (glContext_ && glContext_->getGLESVersionMajor() >= 3) {
-                if (!customPass_) {
-                    customPass_ = std::make_shared<ShaderPass>();
-                }
-                customPass_->setShaderSources(vert, frag);
-                ClearError();
-            } else {
-                SetError("Custom shader requires OpenGL ES 3.0+");
+        FrameStatsRecorder& stats = renderThread_->getFrameStats();
+        {
+            ScopedFramePhase phase(stats, FramePhase::PassChanges);
+            ApplyPendingChanges();
+        }
+        {
+            ScopedFramePhase phase(stats, FramePhase::Update);
+            if (pipeline_) {
+                pipeline_->setParallelUpdate(parallelUpdate_.load(std::memory_order_relaxed));
+                pipeline_->setPipelined(pipelinedUpdate_.load(std::memory_order_relaxed));
+                float hz = fixedUpdateHz_.load(std::memory_order_relaxed);
+                pipeline_->setFixedTimestep(hz > 0.0f ? 1.0f / hz : 0.0f,
+                                            maxFixedSteps_.load(std::memory_order_relaxed));
+                pipeline_->update(deltaTime);
             }
         }
+        ScopedFramePhase phase(stats, FramePhase::Render);
+        RenderFrame();
+        // 绘制完成、交换之前发起截图读取（整帧未重绘时顺延）
+        ServiceCaptures(frameDrawn_);
+        if (streamer_ && frameDrawn_) {
+            streamer_->captureFrame(glContext_->getWidth(), glContext_->getHeight());
+        }
+        // 动画中的 Pass 请求下一帧（OnDemand 模式下否则线程将挂起）
+        if (pipeline_ && pipeline_->consumeRedrawRequests()) {
+            renderThread_->requestRender();
+        }
+    });
+}
 
-        if (uniformDirty_.exchange(false, std::memory_order_acq_rel)) {
-            std::unordered_map<std::string, std::vector<float>> snapshot;
-            {
-                std::lock_guard<std::mutex> lock(uniformMutex_);
-                snapshot = pendingUniforms_;
-            }
-            if (customPass_) {
-                for (const auto& item : snapshot) {
-                    customPass_->setUniform(item.first, item.second);
-                }
-            }
+void GLEXEngine::ApplyPendingChanges()
+{
+    if (!scaler_) {
+        scaler_ = std::make_unique<ResolutionScaler>();
+        resolutionDirty_.store(true, std::memory_order_release);
+    }
+    if (resolutionDirty_.exchange(false, std::memory_order_acq_rel)) {
+        ResolutionScaler::Config config;
+        config.automatic = dynamicResolution_.load(std::memory_order_relaxed);
+        config.scale = resolutionScale_.load(std::memory_order_relaxed);
+        config.minScale = minResolutionScale_.load(std::memory_order_relaxed);
+        config.maxScale = maxResolutionScale_.load(std::memory_order_relaxed);
+        scaler_->setConfig(config);
+    }
+    glContext_->setMaxFramesInFlight(maxFramesInFlight_.load(std::memory_order_relaxed));
+
+    int fps = targetFPS_.load(std::memory_order_relaxed);
+    scaler_->setFrameBudget(1000.0f / static_cast<float>(fps > 0 ? fps : 60));
+    scaler_->update();
+
+    if (passesDirty_.exchange(false, std::memory_order_acq_rel)) {
+        int sw = 0;
+        int sh = 0;
+        scaler_->computeSize(glContext_->getWidth(), glContext_->getHeight(), &sw, &sh);
+        ApplyRequestedPasses(sw, sh);
+    }
+    bool profile = profilerEnabled_.load(std::memory_order_relaxed);
+    if (pipeline_ && pipeline_->getProfiler().isEnabled() != profile) {
+        pipeline_->getProfiler().setEnabled(profile);
+    }
+    if (pipeline_) {
+        // 剖析器的 GPU 段计在动态分辨率的整帧计时之内（GL_TIME_ELAPSED 查询不能嵌套）
+        pipeline_->getProfiler().setGpuTimer(&scaler_->getGpuTimer());
+    }
+    // 已投递编译任务时由任务处理（可能因帧预算顺延到之后的帧）
+    if (!shaderTaskQueued_.load(std::memory_order_acquire)) {
+        ApplyShaderUpdate();
+    }
+
+    ApplyUniformChanges(false);
+
+    if (resizePending_.exchange(false, std::memory_order_acq_rel)) {
+        int rw = pendingWidth_.load(std::memory_order_relaxed);
+        int rh = pendingHeight_.load(std::memory_order_relaxed);
+        if (pipeline_) {
+            int sw = 0;
+            int sh = 0;
+            scaler_->computeSize(rw, rh, &sw, &sh);
+            pipeline_->resize(sw, sh);
+        }
+        if (glContext_) {
+            glContext_->setSurfaceSize(rw, rh);
         }
+    }
 
-        if (resizePending_.exchange(false, std::memory_order_acq_rel)) {
-            int rw = pendingWidth_.load(std::memory_order_relaxed);
-            int rh = pendingHeight_.load(std::memory_order_relaxed);
-            if (pipeline_) {
-                pipeline_->resize(rw, rh);
-            }
-            if (glContext_) {
-                glContext_->setSurfaceSize(rw, rh);
+    // 缩放系数变化时 Pass 按新的渲染尺寸 resize
+    ApplyRenderScale();
+
+    // 上一帧以来的每个触摸事件都按到达顺序分发（快速滑动不再只剩最后一个点）
+    touchBatch_.clear();
+    touchQueue_.drain(touchBatch_);
+    if (!touchBatch_.empty()) {
+        lastTouchNs_ = std::max(lastTouchNs_, touchBatch_.back().timestampNs);
+    }
+    // 批量命令在同一帧内整体生效，其中的触摸排在队列事件之后
+    ApplySubmittedCommands();
+    if (!touchBatch_.empty() && pipeline_) {
+        // 触摸坐标是窗口像素：映射到 Pass 看到的渲染尺寸
+        float sx = glContext_->getWidth() > 0 ?
+            static_cast<float>(pipeline_->getWidth()) / static_cast<float>(glContext_->getWidth()) : 1.0f;
+        float sy = glContext_->getHeight() > 0 ?
+            static_cast<float>(pipeline_->getHeight()) / static_cast<float>(glContext_->getHeight()) : 1.0f;
+        int64_t now = TouchQueue::Now();
+        uint64_t delayNs = 0;
+        uint64_t samples = 0;
+        for (TouchEvent& event : touchBatch_) {
+            int64_t delay = now - event.timestampNs;
+            if (delay >= 0 && delay <= TouchSourceStats::kMaxPlausibleDelayNs) {
+                delayNs += static_cast<uint64_t>(delay);
+                samples++;
             }
+            event.x *= sx;
+            event.y *= sy;
+            pipeline_->dispatchTouch(event);
         }
+        touchEventsDelivered_.fetch_add(touchBatch_.size(), std::memory_order_relaxed);
+        touchDispatchDelayNs_.fetch_add(delayNs, std::memory_order_relaxed);
+        touchDispatchSamples_.fetch_add(samples, std::memory_order_relaxed);
+    }
+}
 
-        uint64_t seq = touchSeq_.load(std::memory_order_relaxed);
-        if (seq != lastAppliedTouchSeq_) {
-            lastAppliedTouchSeq_ = seq;
-            if (pipeline_) {
-                pipeline_->dispatchTouch(
-                    touchX_.load(std::memory_order_relaxed),
-                    touchY_.load(std::memory_order_relaxed),
-                    touchAction_.load(std::memory_order_relaxed),
-                    touchPointerId_.load(std::memory_order_relaxed)
-                );
+void GLEXEngine::ApplySubmittedCommands()
+{
+    if (!commandsDirty_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        commandScratch_.swap(pendingCommands_);
+        pendingCommands_.clear();
+    }
+
+    CommandReader reader(commandScratch_.data(), commandScratch_.size());
+    Command command;
+    bool passesSynced = false;
+    while (reader.next(command)) {
+        switch (command.op) {
+            case CommandOp::SetUniform:
+            case CommandOp::SetUniformByHandle: {
+                // 写入与 setUniform 相同的句柄表，循环结束后统一应用（句柄与数量已在提交时校验）
+                commandValues_.resize(command.valueCount);
+                command.copyValues(commandValues_.data());
+                int handle = command.op == CommandOp::SetUniform ?
+                    uniformTable_.getHandle(command.getName()) : command.handle;
+                uniformTable_.set(handle, commandValues_.data(), commandValues_.size());
+                break;
+            }
+            case CommandOp::Touch:
+                // 与 TouchQueue::push 相同的单调钳制：排在队列事件之后，时间戳不能早于它们
+                if (command.touch.timestampNs < lastTouchNs_) {
+                    command.touch.timestampNs = lastTouchNs_;
+                }
+                lastTouchNs_ = command.touch.timestampNs;
+                touchBatch_.push_back(command.touch);
+                break;
+            case CommandOp::SetPassEnabled: {
+                if (!pipeline_) {
+                    break;
+                }
+                if (!passesSynced) {
+                    // 流水线模式下工作线程可能正在读取启用状态
+                    pipeline_->waitForUpdate();
+                    passesSynced = true;
+                }
+                RenderPass* pass = pipeline_->getPass(command.getName());
+                if (pass) {
+                    pass->setEnabled(command.enabled);
+                } else {
+                    GLEX_LOGW("submitCommands: pass '%{public}s' not found", command.getName().c_str());
+                }
+                break;
             }
+            case CommandOp::SetClearColor:
+                bgColorR_.store(command.color[0], std::memory_order_relaxed);
+                bgColorG_.store(command.color[1], std::memory_order_relaxed);
+                bgColorB_.store(command.color[2], std::memory_order_relaxed);
+                bgColorA_.store(command.color[3], std::memory_order_relaxed);
+                break;
         }
+    }
+    if (reader.hasError()) {
+        GLEX_LOGE("submitCommands: %{public}s", reader.getError().c_str());
+    }
+    // 批量设置的 uniform 在本帧生效
+    ApplyUniformChanges(false);
+}
+
+void GLEXEngine::ApplyRenderScale()
+{
+    int sw = 0;
+    int sh = 0;
+    scaler_->computeSize(glContext_->getWidth(), glContext_->getHeight(), &sw, &sh);
+    if (pipeline_ && pipeline_->isInitialized() &&
+        (pipeline_->getWidth() != sw || pipeline_->getHeight() != sh)) {
+        pipeline_->resize(sw, sh);
+    }
+    currentResolutionScale_.store(scaler_->getScale(), std::memory_order_relaxed);
+    renderWidth_.store(sw, std::memory_order_relaxed);
+    renderHeight_.store(sh, std::memory_order_relaxed);
+}
 
-        int w = glContext_->getWidth();
-        int h = glContext_->getHeight();
+void GLEXEngine::RenderFrame()
+{
+    auto start = std::chrono::steady_clock::now();
+    int w = glContext_->getWidth();
+    int h = glContext_->getHeight();
+    bool scaled = scaler_->isScaled();
 
-        glViewport(0, 0, w, h);
-        glClearColor(
-            bgColorR_.load(std::memory_order_relaxed),
-            bgColorG_.load(std::memory_order_relaxed),
-            bgColorB_.load(std::memory_order_relaxed),
-            bgColorA_.load(std::memory_order_relaxed)
-        );
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    float clearColor[4] = {
+        bgColorR_.load(std::memory_order_relaxed),
+        bgColorG_.load(std::memory_order_relaxed),
+        bgColorB_.load(std::memory_order_relaxed),
+        bgColorA_.load(std::memory_order_relaxed)
+    };
 
-        if (pipeline_) {
-            pipeline_->update(deltaTime);
-            pipeline_->render();
+    // 局部呈现：只重绘损坏区域（背景色变化、开关切换时整帧重绘一次）
+    bool partial = false;
+    DamageRect repaint;
+    frameDrawn_ = false;
+    // 缩放渲染时放大整帧覆盖窗口，不做局部呈现
+    if (partialPresent_.load(std::memory_order_relaxed) && pipeline_ && !scaled) {
+        // 有待处理的截图时整帧重绘，保证读到的是完整的当前画面
+        if (damageInvalidated_.exchange(false, std::memory_order_acq_rel) ||
+            captureQueued_.load(std::memory_order_acquire) || streamer_ ||
+            std::memcmp(clearColor, lastClearColor_, sizeof(clearColor)) != 0) {
+            pipeline_->invalidateDamage();
         }
-    });
+        partial = glContext_->beginFrame(pipeline_->collectDamage(damage_) ? &damage_ : nullptr, &repaint);
+    }
+    std::memcpy(lastClearColor_, clearColor, sizeof(clearColor));
+    if (partial && repaint.isEmpty()) {
+        // 画面无变化，swapBuffers 会跳过交换
+        return;
+    }
+    frameDrawn_ = true;
+
+    // 缩放时渲染到离屏目标；整帧 GPU 计时与剖析器的逐 Pass 计时共用一条查询流
+    scaler_->beginFrame(w, h);
+    int rw = w;
+    int rh = h;
+    scaler_->computeSize(w, h, &rw, &rh);
+    glViewport(0, 0, rw, rh);
+    if (partial) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(repaint.x, repaint.y, repaint.width, repaint.height);
+    }
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (pipeline_) {
+        pipeline_->render();
+    }
+    if (partial) {
+        glDisable(GL_SCISSOR_TEST);
+    }
+    scaler_->endFrame();
+    glViewport(0, 0, w, h);
+    scaler_->reportCpuTime(
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
 }
 
 void GLEXEngine::StopRenderLoopLocked()
@@ -770,6 +1406,36 @@ void GLEXEngine::StopRenderLoopLocked()
     }
 }
 
+bool GLEXEngine::SwapSurfaceLocked(OHNativeWindow* window, bool ownsWindow)
+{
+    // 只有窗口上下文、且共享组设置未变时才能沿用（加入 / 退出共享组必须重建上下文）
+    if (!glContext_ || !glContext_->isInitialized() || glContext_->isOffscreen() ||
+        (glContext_->getShareGroup() != nullptr) != shareGroupEnabled_) {
+        return false;
+    }
+
+    // 上下文绑定在渲染线程上时由渲染线程替换，否则在当前线程替换
+    bool swapped = false;
+    auto swap = [this, window, &swapped]() {
+        swapped = glContext_->replaceSurface(reinterpret_cast<EGLNativeWindowType>(window));
+    };
+    if (!RunOnRenderThreadSync(swap)) {
+        swap();
+    }
+    if (!swapped) {
+        GLEX_LOGW("Surface swap failed, rebuilding context");
+        return false;
+    }
+
+    if (nativeWindow_ != nullptr && ownsWindow_ && nativeWindow_ != window) {
+        OH_NativeWindow_DestroyNativeWindow(nativeWindow_);
+    }
+    nativeWindow_ = window;
+    ownsWindow_ = ownsWindow;
+    RequestResize(glContext_->getWidth(), glContext_->getHeight());
+    return true;
+}
+
 void GLEXEngine::DestroySurfaceLocked(bool keepStartRequested)
 {
     bool pendingStart = startRequested_.load();
@@ -803,15 +1469,131 @@ bool GLEXEngine::RunOnRenderThreadSync(std::function<void()> task)
     if (!renderThread_ || !renderThread_->isRunning() || !task) {
         return false;
     }
-    auto done = std::make_shared<std::promise<void>>();
-    auto future = done->get_future();
-    renderThread_->post([task = std::move(task), done]() mutable {
+    // 调用方阻塞等待，任务与完成信号都可以放在栈上，投递时只捕获两个指针；
+    // 以 Urgent 投递，不受渲染线程任务预算限制
+    struct SyncSignal {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+    } signal;
+    bool accepted = renderThread_->post([&task, &signal]() {
         task();
-        done->set_value();
-    });
-    future.wait();
+        {
+            std::lock_guard<std::mutex> lock(signal.mutex);
+            signal.done = true;
+        }
+        signal.cv.notify_one();
+    }, TaskPriority::Urgent);
+    if (!accepted) {
+        // 渲染循环已自行停止（如 swapBuffers 失败）：等它释放上下文，由调用方执行
+        GLEX_LOGW("Render loop stopped, running task on caller");
+        renderThread_->stop();
+        return false;
+    }
+    // 被接收的任务保证在渲染循环退出前执行
+    std::unique_lock<std::mutex> lock(signal.mutex);
+    signal.cv.wait(lock, [&signal]() { return signal.done; });
     return true;
 }
+
+void GLEXEngine::ServiceCaptures(bool issue)
+{
+    if (!readback_) {
+        if (!captureQueued_.load(std::memory_order_acquire)) {
+            return;
+        }
+        readback_ = std::make_unique<AsyncReadback>();
+    }
+
+    // 取回之前帧发起的读取（不等待 GPU）
+    std::vector<ReadbackImage> done;
+    readback_->poll(done);
+
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    auto finish = [this](ReadbackImage&& image) {
+        pendingCaptureIds_.erase(std::remove(pendingCaptureIds_.begin(), pendingCaptureIds_.end(), image.id),
+                                 pendingCaptureIds_.end());
+        captureResults_.push_back(std::move(image));
+        if (captureResults_.size() > kMaxCaptureResults) {
+            GLEX_LOGW("Capture %{public}llu dropped: not taken",
+                      static_cast<unsigned long long>(captureResults_.front().id));
+            captureResults_.pop_front();
+        }
+    };
+    for (auto& image : done) {
+        finish(std::move(image));
+    }
+
+    int surfaceWidth = glContext_->getWidth();
+    int surfaceHeight = glContext_->getHeight();
+    while (issue && !captureRequests_.empty() && readback_->hasFreeSlot()) {
+        CaptureRequest req = captureRequests_.front();
+        captureRequests_.pop_front();
+        if (req.fullFrame) {
+            req.x = 0;
+            req.y = 0;
+            req.width = surfaceWidth;
+            req.height = surfaceHeight;
+        }
+        // 左上原点转换为 GL 窗口坐标并裁剪到 Surface
+        DamageRect rect = ClipDamage({ req.x, surfaceHeight - (req.y + req.height), req.width, req.height },
+                                     surfaceWidth, surfaceHeight);
+        if (!readback_->request(req.id, rect.x, rect.y, rect.width, rect.height)) {
+            ReadbackImage failed;
+            failed.id = req.id;
+            finish(std::move(failed));
+        }
+    }
+
+    bool queued = !captureRequests_.empty();
+    captureQueued_.store(queued, std::memory_order_release);
+    // OnDemand 模式下继续出帧，直到请求全部发起、栅栏全部取回
+    if (queued || readback_->getInFlightCount() > 0) {
+        renderThread_->requestRender();
+    }
+}
+
+void GLEXEngine::StopStreamLocked()
+{
+    if (!streamer_) {
+        return;
+    }
+    // 在渲染线程上移除并释放 FBO / PBO；渲染线程未运行时 GL 对象随上下文销毁
+    std::unique_ptr<FrameStreamer> streamer;
+    auto remove = [this, &streamer]() {
+        streamer_->releaseGpu();
+        streamer = std::move(streamer_);
+    };
+    if (!RunOnRenderThreadSync(remove)) {
+        streamer = std::move(streamer_);
+    }
+    // 等待工作线程退出后再释放线程安全函数（之后不会再有帧投递）
+    streamer->stop();
+    lastStreamStats_ = streamer->getStats();
+    if (streamTsfn_) {
+        napi_release_threadsafe_function(streamTsfn_, napi_tsfn_release);
+        streamTsfn_ = nullptr;
+    }
+}
+
+std::string GLEXEngine::ExportProfilerTraceLocked()
+{
+    // pipeline_ 由渲染线程创建：运行中在渲染线程上导出，否则直接读取
+    std::string trace;
+    auto exportTrace = [this, &trace]() {
+        if (pipeline_) {
+            trace = pipeline_->getProfiler().exportChromeTrace();
+        }
+    };
+    if (!RunOnRenderThreadSync(exportTrace)) {
+        exportTrace();
+    }
+    if (trace.empty()) {
+        trace = PassProfiler().exportChromeTrace();
+    }
+    return trace;
+}
+
 // ============================================================
 // NAPI 接口实现
 // ============================================================
@@ -914,25 +1696,39 @@ napi_value GLEXEngine::NapiSetSurfaceId(napi_env env, napi_callback_info info)
         return GetUndefined(env);
     }
 
-    engine->DestroySurfaceLocked(true);
-
-    engine->surfaceId_ = surfaceId;
-
     OHNativeWindow* window = nullptr;
     int32_t result = OH_NativeWindow_CreateNativeWindowFromSurfaceId(surfaceId, &window);
     if (result != 0 || window == nullptr) {
         GLEX_LOGE("setSurfaceId: create native window failed, result=%{public}d", result);
+        engine->DestroySurfaceLocked(true);
         engine->SetError("setSurfaceId: create native window failed");
         return GetUndefined(env);
     }
-    engine->nativeWindow_ = window;
-    engine->ownsWindow_ = true;
 
-    engine->glContext_ = std::make_unique<GLContext>();
-    if (!engine->glContext_->initialize(reinterpret_cast<EGLNativeWindowType>(window))) {
-        GLEX_LOGE("setSurfaceId: GL init failed");
-        engine->SetError("setSurfaceId: GL init failed");
-        engine->glContext_.reset();
+    // 快速路径：配置兼容时只重建 EGLSurface，Pass 状态与着色器保留
+    if (engine->SwapSurfaceLocked(window, true)) {
+        engine->surfaceId_ = surfaceId;
+        GLEX_LOGI("setSurfaceId: surface swapped, id=%" PRIu64 ", size=%{public}dx%{public}d",
+                  surfaceId, engine->glContext_->getWidth(), engine->glContext_->getHeight());
+        if (engine->startRequested_.load()) {
+            engine->StartRenderLoopLocked();
+            engine->startRequested_.store(false);
+        }
+        return GetUndefined(env);
+    }
+
+    engine->DestroySurfaceLocked(true);
+
+    engine->surfaceId_ = surfaceId;
+    engine->nativeWindow_ = window;
+    engine->ownsWindow_ = true;
+
+    engine->glContext_ = std::make_unique<GLContext>();
+    if (!engine->glContext_->initialize(reinterpret_cast<EGLNativeWindowType>(window),
+                                        engine->MakeContextConfigLocked())) {
+        GLEX_LOGE("setSurfaceId: GL init failed");
+        engine->SetError("setSurfaceId: GL init failed");
+        engine->glContext_.reset();
         return GetUndefined(env);
     }
 
@@ -974,7 +1770,7 @@ napi_value GLEXEngine::NapiStartRender(napi_env env, napi_callback_info info)
     std::lock_guard<std::mutex> lock(engine->mutex_);
     engine->startRequested_.store(true);
 
-    if (engine->glContext_ && engine->glContext_->isInitialized()) {
+    if (engine->glContext_ && engine->glContext_->isInitialized() && engine->glContext_->hasSurface()) {
         engine->StartRenderLoopLocked();
         engine->startRequested_.store(false);
     } else {
@@ -1032,6 +1828,7 @@ napi_value GLEXEngine::NapiSetBackgroundColor(napi_env env, napi_callback_info i
         engine->bgColorG_.store(static_cast<float>(g), std::memory_order_relaxed);
         engine->bgColorB_.store(static_cast<float>(b), std::memory_order_relaxed);
         engine->bgColorA_.store(static_cast<float>(a), std::memory_order_relaxed);
+        engine->MarkDirty();
     }
     return GetUndefined(env);
 }
@@ -1055,6 +1852,374 @@ napi_value GLEXEngine::NapiSetTargetFPS(napi_env env, napi_callback_info info)
     return GetUndefined(env);
 }
 
+napi_value GLEXEngine::NapiSetRenderMode(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    int32_t mode = 0;
+    if (argc < 1 || !GetInt32(env, args[0], &mode) ||
+        (mode != static_cast<int32_t>(RenderMode::Continuous) && mode != static_cast<int32_t>(RenderMode::OnDemand))) {
+        engine->SetError("setRenderMode: invalid mode");
+        return GetUndefined(env);
+    }
+
+    engine->renderMode_.store(mode, std::memory_order_relaxed);
+    if (engine->renderThread_) {
+        engine->renderThread_->setRenderMode(static_cast<RenderMode>(mode));
+    }
+    GLEX_LOGI("setRenderMode: %{public}s", mode == static_cast<int32_t>(RenderMode::OnDemand) ? "onDemand" : "continuous");
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiRequestRender(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetAdaptiveFrameRate(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 2);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setAdaptiveFrameRate: invalid parameters");
+        return GetUndefined(env);
+    }
+
+    std::vector<int> ladder;
+    if (argc >= 2) {
+        std::vector<float> values;
+        if (!GetFloatArray(env, args[1], values)) {
+            engine->SetError("setAdaptiveFrameRate: ladder must be a non-empty number array");
+            return GetUndefined(env);
+        }
+        for (float v : values) {
+            int fps = static_cast<int>(v);
+            if (fps <= 0) {
+                engine->SetError("setAdaptiveFrameRate: ladder entries must be positive");
+                return GetUndefined(env);
+            }
+            ladder.push_back(fps);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->adaptiveFrameRate_ = enabled;
+    if (!ladder.empty()) {
+        engine->frameRateLadder_ = std::move(ladder);
+    }
+    engine->ApplyFrameRateGovernorLocked();
+    GLEX_LOGI("setAdaptiveFrameRate: %{public}s", enabled ? "on" : "off");
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetParallelUpdate(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setParallelUpdate: invalid parameters");
+        return GetUndefined(env);
+    }
+    engine->parallelUpdate_.store(enabled, std::memory_order_relaxed);
+    GLEX_LOGI("setParallelUpdate: %{public}s (%{public}d workers)",
+              enabled ? "on" : "off", static_cast<int>(JobSystem::Get().getWorkerCount()));
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetPipelinedUpdate(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setPipelinedUpdate: invalid parameters");
+        return GetUndefined(env);
+    }
+    engine->pipelinedUpdate_.store(enabled, std::memory_order_relaxed);
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetFixedTimestep(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 2);
+    if (!engine) return GetUndefined(env);
+
+    double hz = 0.0;
+    if (argc < 1 || !GetDouble(env, args[0], &hz) || hz < 0.0) {
+        engine->SetError("setFixedTimestep: updatesPerSecond must be >= 0");
+        return GetUndefined(env);
+    }
+    int32_t maxSteps = RenderPipeline::kDefaultMaxFixedSteps;
+    if (argc >= 2 && (!GetInt32(env, args[1], &maxSteps) || maxSteps < 1)) {
+        engine->SetError("setFixedTimestep: maxStepsPerFrame must be a positive integer");
+        return GetUndefined(env);
+    }
+    engine->fixedUpdateHz_.store(static_cast<float>(hz), std::memory_order_relaxed);
+    engine->maxFixedSteps_.store(maxSteps, std::memory_order_relaxed);
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetSharedRenderThread(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 2);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setSharedRenderThread: invalid parameters");
+        return GetUndefined(env);
+    }
+    if (argc >= 2) {
+        int32_t threads = 0;
+        if (!GetInt32(env, args[1], &threads) || threads < 1) {
+            engine->SetError("setSharedRenderThread: threadCount must be a positive integer");
+            return GetUndefined(env);
+        }
+        SharedRenderScheduler::Get().setThreadCount(threads);
+    }
+
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->sharedRenderThread_ = enabled;
+    if (engine->renderThread_ && engine->renderThread_->isRunning() && engine->renderThread_->isShared() != enabled) {
+        // 切换驱动方式需要重启渲染循环（Pass 与 GL 资源保留）
+        engine->StopRenderLoopLocked();
+        engine->StartRenderLoopLocked();
+    }
+    GLEX_LOGI("setSharedRenderThread: %{public}s", enabled ? "on" : "off");
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetShareGroup(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setShareGroup: invalid parameters");
+        return GetUndefined(env);
+    }
+
+    // 上下文创建后不能再加入或退出共享组：下一次创建 Surface 时生效
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->shareGroupEnabled_ = enabled;
+    GLEX_LOGI("setShareGroup: %{public}s", enabled ? "on" : "off");
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetMaxFramesInFlight(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    int32_t frames = 0;
+    if (argc < 1 || !GetInt32(env, args[0], &frames) || frames < 0 ||
+        frames > GLContext::kMaxFramesInFlightLimit) {
+        engine->SetError("setMaxFramesInFlight: frames must be 0 (unlimited) or 1 - 3");
+        return GetUndefined(env);
+    }
+    engine->maxFramesInFlight_.store(frames, std::memory_order_relaxed);
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetResolutionScale(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    double scale = 1.0;
+    if (argc < 1 || !GetDouble(env, args[0], &scale) || scale <= 0.0 || scale > 1.0) {
+        engine->SetError("setResolutionScale: scale must be in (0, 1]");
+        return GetUndefined(env);
+    }
+    engine->resolutionScale_.store(static_cast<float>(scale), std::memory_order_relaxed);
+    engine->dynamicResolution_.store(false, std::memory_order_relaxed);
+    engine->resolutionDirty_.store(true, std::memory_order_release);
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetDynamicResolution(napi_env env, napi_callback_info info)
+{
+    size_t argc = 3;
+    napi_value args[3];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 3);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setDynamicResolution: invalid parameters");
+        return GetUndefined(env);
+    }
+    double minScale = 0.5;
+    double maxScale = 1.0;
+    if ((argc >= 2 && !GetDouble(env, args[1], &minScale)) || (argc >= 3 && !GetDouble(env, args[2], &maxScale)) ||
+        minScale <= 0.0 || maxScale > 1.0 || minScale > maxScale) {
+        engine->SetError("setDynamicResolution: expected 0 < minScale <= maxScale <= 1");
+        return GetUndefined(env);
+    }
+    engine->minResolutionScale_.store(static_cast<float>(minScale), std::memory_order_relaxed);
+    engine->maxResolutionScale_.store(static_cast<float>(maxScale), std::memory_order_relaxed);
+    engine->dynamicResolution_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        engine->resolutionScale_.store(1.0f, std::memory_order_relaxed);
+    }
+    engine->resolutionDirty_.store(true, std::memory_order_release);
+    engine->MarkDirty();
+    GLEX_LOGI("setDynamicResolution: %{public}s (%{public}.2f - %{public}.2f)",
+              enabled ? "on" : "off", minScale, maxScale);
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiGetRenderResolution(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_value v;
+    napi_create_double(env, engine->currentResolutionScale_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "scale", v);
+    napi_create_int32(env, engine->renderWidth_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "width", v);
+    napi_create_int32(env, engine->renderHeight_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "height", v);
+    napi_get_boolean(env, engine->dynamicResolution_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "dynamic", v);
+    return result;
+}
+
+napi_value GLEXEngine::NapiSetPartialPresent(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setPartialPresent: invalid parameters");
+        return GetUndefined(env);
+    }
+
+    engine->partialPresent_.store(enabled, std::memory_order_relaxed);
+    // 开启后第一帧整帧重绘，建立缓冲区年龄历史
+    engine->damageInvalidated_.store(true, std::memory_order_release);
+    engine->MarkDirty();
+    GLEX_LOGI("setPartialPresent: %{public}s", enabled ? "on" : "off");
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiSetRenderThreadPolicy(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    napi_valuetype type;
+    if (argc < 1 || napi_typeof(env, args[0], &type) != napi_ok || type != napi_object) {
+        engine->SetError("setRenderThreadPolicy: policy must be an object");
+        return GetUndefined(env);
+    }
+
+    ThreadPolicy policy;
+    napi_value v;
+    if (GetNamedProperty(env, args[0], "cpus", &v)) {
+        std::vector<float> cpus;
+        if (!GetFloatArray(env, v, cpus)) {
+            engine->SetError("setRenderThreadPolicy: cpus must be a non-empty number array");
+            return GetUndefined(env);
+        }
+        for (float cpu : cpus) {
+            if (cpu < 0.0f) {
+                engine->SetError("setRenderThreadPolicy: cpu index must be non-negative");
+                return GetUndefined(env);
+            }
+            policy.cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    if (GetNamedProperty(env, args[0], "performanceCores", &v) && !GetBool(env, v, &policy.performanceCores)) {
+        engine->SetError("setRenderThreadPolicy: performanceCores must be a boolean");
+        return GetUndefined(env);
+    }
+    if (GetNamedProperty(env, args[0], "nice", &v)) {
+        int32_t nice = 0;
+        if (!GetInt32(env, v, &nice) || nice < -20 || nice > 19) {
+            engine->SetError("setRenderThreadPolicy: nice must be in [-20, 19]");
+            return GetUndefined(env);
+        }
+        policy.setNice = true;
+        policy.nice = nice;
+    }
+    if (GetNamedProperty(env, args[0], "realtime", &v) && !GetBool(env, v, &policy.realtime)) {
+        engine->SetError("setRenderThreadPolicy: realtime must be a boolean");
+        return GetUndefined(env);
+    }
+    if (GetNamedProperty(env, args[0], "realtimePriority", &v)) {
+        int32_t priority = 0;
+        if (!GetInt32(env, v, &priority) || priority < 1) {
+            engine->SetError("setRenderThreadPolicy: realtimePriority must be a positive integer");
+            return GetUndefined(env);
+        }
+        policy.realtimePriority = priority;
+    }
+    if (GetNamedProperty(env, args[0], "name", &v) && !GetString(env, v, policy.name)) {
+        engine->SetError("setRenderThreadPolicy: name must be a string");
+        return GetUndefined(env);
+    }
+
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->threadPolicy_ = policy;
+    engine->hasThreadPolicy_ = true;
+    if (engine->renderThread_) {
+        engine->renderThread_->setThreadPolicy(policy);
+    }
+    if (engine->sharedRenderThread_) {
+        // 共享模式下作用于调度器的工作线程（进程内所有共享实例）
+        SharedRenderScheduler::Get().setThreadPolicy(policy);
+    }
+    GLEX_LOGI("setRenderThreadPolicy: cpus=%{public}d perf=%{public}d nice=%{public}d realtime=%{public}d",
+              static_cast<int>(policy.cpus.size()), policy.performanceCores ? 1 : 0,
+              policy.setNice ? policy.nice : 0, policy.realtime ? 1 : 0);
+    return GetUndefined(env);
+}
+
 napi_value GLEXEngine::NapiSetShaderSources(napi_env env, napi_callback_info info)
 {
     size_t argc = 2;
@@ -1198,16 +2363,172 @@ napi_value GLEXEngine::NapiSetUniform(napi_env env, napi_callback_info info)
         return GetUndefined(env);
     }
 
+    int handle = engine->uniformTable_.getHandle(name);
+    const float* data = nullptr;
+    size_t count = 0;
     std::vector<float> values;
-    if (!GetFloatArray(env, args[1], values)) {
+    if (GetFloat32Array(env, args[1], &data, &count)) {
+        // Float32Array 直接读取底层存储
+    } else if (GetFloatArray(env, args[1], values)) {
+        data = values.data();
+        count = values.size();
+    } else {
         engine->SetError("setUniform: invalid value");
         return GetUndefined(env);
     }
 
-    engine->RequestUniform(name, values);
+    if (!engine->RequestUniform(handle, data, count)) {
+        engine->SetError("setUniform: invalid uniform '" + name + "'");
+    }
     return GetUndefined(env);
 }
 
+napi_value GLEXEngine::NapiGetUniformHandle(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    std::string name;
+    if (argc < 1 || !GetString(env, args[0], name) || name.empty()) {
+        engine->SetError("getUniformHandle: invalid name");
+        napi_value result;
+        napi_create_int32(env, -1, &result);
+        return result;
+    }
+
+    int handle = engine->uniformTable_.getHandle(name);
+    if (handle < 0) {
+        engine->SetError("getUniformHandle: too many uniforms");
+    }
+    napi_value result;
+    napi_create_int32(env, handle, &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiSetUniformByHandle(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 2);
+    if (!engine) return GetUndefined(env);
+
+    napi_value result;
+    napi_get_boolean(env, false, &result);
+    int32_t handle = -1;
+    if (argc < 2 || !GetInt32(env, args[0], &handle)) {
+        engine->SetError("setUniformByHandle: invalid parameters");
+        return result;
+    }
+
+    // 热路径：按下标定位，从 Float32Array 底层存储直接拷入暂存区，不经过中间数组
+    const float* data = nullptr;
+    size_t count = 0;
+    float scalar = 0.0f;
+    double num = 0.0;
+    if (GetFloat32Array(env, args[1], &data, &count)) {
+        // 零拷贝读取
+    } else if (GetDouble(env, args[1], &num)) {
+        scalar = static_cast<float>(num);
+        data = &scalar;
+        count = 1;
+    } else {
+        engine->SetError("setUniformByHandle: value must be a Float32Array or number");
+        return result;
+    }
+
+    if (!engine->RequestUniform(handle, data, count)) {
+        engine->SetError("setUniformByHandle: invalid handle or value count");
+        return result;
+    }
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiSubmitCommands(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    napi_value result;
+    napi_create_int32(env, -1, &result);
+    if (argc < 1) {
+        engine->SetError("submitCommands: missing buffer");
+        return result;
+    }
+
+    // ArrayBuffer 或 Uint8Array：直接读取底层存储，不逐元素转换
+    void* data = nullptr;
+    size_t size = 0;
+    bool isArrayBuffer = false;
+    bool isTypedArray = false;
+    napi_is_arraybuffer(env, args[0], &isArrayBuffer);
+    if (isArrayBuffer) {
+        napi_get_arraybuffer_info(env, args[0], &data, &size);
+    } else if (napi_is_typedarray(env, args[0], &isTypedArray) == napi_ok && isTypedArray) {
+        napi_typedarray_type type;
+        napi_value arraybuffer;
+        size_t offset = 0;
+        napi_get_typedarray_info(env, args[0], &type, &size, &data, &arraybuffer, &offset);
+        if (type != napi_uint8_array) {
+            engine->SetError("submitCommands: expected ArrayBuffer or Uint8Array");
+            return result;
+        }
+    } else {
+        engine->SetError("submitCommands: expected ArrayBuffer or Uint8Array");
+        return result;
+    }
+    if (size == 0) {
+        napi_create_int32(env, 0, &result);
+        return result;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t count = 0;
+    std::string error;
+    if (!bytes || !ValidateCommands(bytes, size, &count, &error)) {
+        engine->SetError("submitCommands: " + error);
+        return result;
+    }
+
+    // 句柄须由 getUniformHandle 返回过；名字在此登记句柄（表满则失败），应用时不会再因句柄失败而只生效一部分
+    CommandReader reader(bytes, size);
+    Command command;
+    while (reader.next(command)) {
+        if (command.op == CommandOp::SetUniformByHandle && !engine->uniformTable_.isValid(command.handle)) {
+            engine->SetError("submitCommands: unknown uniform handle " + std::to_string(command.handle));
+            return result;
+        }
+        if (command.op == CommandOp::SetUniform && engine->uniformTable_.getHandle(command.getName()) < 0) {
+            engine->SetError("submitCommands: too many uniforms ('" + command.getName() + "')");
+            return result;
+        }
+    }
+
+    // 批量中的触摸与 setTouchEvent() 一样计入 ArkTS 来源的统计（时间戳为 0 的只计数）
+    CommandReader touchReader(bytes, size);
+    while (touchReader.next(command)) {
+        if (command.op == CommandOp::Touch) {
+            engine->arktsTouchStats_.record(command.touch.timestampNs);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(engine->commandMutex_);
+        size_t base = engine->pendingCommands_.size();
+        engine->pendingCommands_.insert(engine->pendingCommands_.end(), bytes, bytes + size);
+        StampTouchTimestamps(engine->pendingCommands_.data() + base, size, TouchQueue::Now());
+    }
+    engine->commandsDirty_.store(true, std::memory_order_release);
+    engine->MarkDirty();
+
+    napi_create_int32(env, static_cast<int32_t>(count), &result);
+    return result;
+}
+
 napi_value GLEXEngine::NapiSetPasses(napi_env env, napi_callback_info info)
 {
     size_t argc = 1;
@@ -1316,9 +2637,9 @@ napi_value GLEXEngine::NapiGetPasses(napi_env env, napi_callback_info info)
 
 napi_value GLEXEngine::NapiSetTouchEvent(napi_env env, napi_callback_info info)
 {
-    size_t argc = 4;
-    napi_value args[4];
-    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 4);
+    size_t argc = 5;
+    napi_value args[5];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 5);
     if (!engine) return GetUndefined(env);
 
     if (argc < 3) {
@@ -1337,19 +2658,89 @@ napi_value GLEXEngine::NapiSetTouchEvent(napi_env env, napi_callback_info info)
     if (argc >= 4) {
         GetInt32(env, args[3], &pointerId);
     }
+    // 可选：事件时间戳（纳秒，单调时钟，即 ArkTS TouchEvent.timestamp）；缺省取当前时刻
+    double timestamp = 0.0;
+    if (argc >= 5) {
+        GetDouble(env, args[4], &timestamp);
+    }
 
     if (!std::isfinite(x) || !std::isfinite(y)) {
         engine->SetError("setTouchEvent: non-finite coordinates");
         return GetUndefined(env);
     }
 
-    engine->touchX_.store(static_cast<float>(x), std::memory_order_relaxed);
-    engine->touchY_.store(static_cast<float>(y), std::memory_order_relaxed);
-    engine->touchAction_.store(action, std::memory_order_relaxed);
-    engine->touchPointerId_.store(pointerId, std::memory_order_relaxed);
-    engine->touchSeq_.fetch_add(1, std::memory_order_relaxed);
+    TouchEvent event;
+    event.x = static_cast<float>(x);
+    event.y = static_cast<float>(y);
+    event.action = action;
+    event.pointerId = pointerId;
+    event.timestampNs = std::isfinite(timestamp) ? static_cast<int64_t>(timestamp) : 0;
+    // false：原生触摸回调已在投递，调用方可停止转发
+    napi_value result;
+    napi_get_boolean(env, engine->PushTouch(event, false), &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiSetNativeTouch(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = true;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setNativeTouch: invalid parameters");
+        return GetUndefined(env);
+    }
+    engine->nativeTouchEnabled_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        engine->nativeTouchActive_.store(false, std::memory_order_relaxed);
+    }
     return GetUndefined(env);
 }
+
+napi_value GLEXEngine::NapiGetTouchStats(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_value v;
+    napi_get_boolean(env, engine->nativeTouchActive_.load(std::memory_order_relaxed) &&
+                     engine->nativeTouchEnabled_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "nativeActive", v);
+
+    const TouchSourceStats* sources[] = { &engine->nativeTouchStats_, &engine->arktsTouchStats_ };
+    const char* names[] = { "native", "arkts" };
+    for (int i = 0; i < 2; i++) {
+        napi_value source;
+        napi_create_object(env, &source);
+        napi_create_double(env, static_cast<double>(sources[i]->events.load(std::memory_order_relaxed)), &v);
+        napi_set_named_property(env, source, "events", v);
+        napi_create_double(env, sources[i]->averageDelayMs(), &v);
+        napi_set_named_property(env, source, "avgDelayMs", v);
+        napi_create_double(env, static_cast<double>(sources[i]->maxDelayNs.load(std::memory_order_relaxed)) / 1e6,
+                           &v);
+        napi_set_named_property(env, source, "maxDelayMs", v);
+        napi_set_named_property(env, result, names[i], source);
+    }
+
+    uint64_t samples = engine->touchDispatchSamples_.load(std::memory_order_relaxed);
+    double dispatchMs = samples > 0 ?
+        static_cast<double>(engine->touchDispatchDelayNs_.load(std::memory_order_relaxed)) / 1e6 /
+        static_cast<double>(samples) : 0.0;
+    napi_create_double(env, dispatchMs, &v);
+    napi_set_named_property(env, result, "avgDispatchDelayMs", v);
+    napi_create_double(env, static_cast<double>(engine->touchEventsDelivered_.load(std::memory_order_relaxed)), &v);
+    napi_set_named_property(env, result, "delivered", v);
+    napi_create_double(env, static_cast<double>(engine->touchQueue_.getOverflowCount()), &v);
+    napi_set_named_property(env, result, "overflows", v);
+    return result;
+}
 napi_value GLEXEngine::NapiGetCurrentFPS(napi_env env, napi_callback_info info)
 {
     size_t argc = 0;
@@ -1363,6 +2754,146 @@ napi_value GLEXEngine::NapiGetCurrentFPS(napi_env env, napi_callback_info info)
     return result;
 }
 
+napi_value GLEXEngine::NapiGetMissedFrames(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    uint64_t missed = engine->renderThread_ ? engine->renderThread_->getMissedFrames() : 0;
+    napi_value result;
+    napi_create_double(env, static_cast<double>(missed), &result);
+    return result;
+}
+
+static napi_value CreatePhaseStats(napi_env env, const PhaseStats& stats)
+{
+    napi_value obj;
+    napi_create_object(env, &obj);
+    auto setNum = [&](const char* key, float value) {
+        napi_value v;
+        napi_create_double(env, static_cast<double>(value), &v);
+        napi_set_named_property(env, obj, key, v);
+    };
+    setNum("p50", stats.p50Ms);
+    setNum("p90", stats.p90Ms);
+    setNum("p99", stats.p99Ms);
+    setNum("max", stats.maxMs);
+    return obj;
+}
+
+napi_value GLEXEngine::NapiGetFrameStats(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    FrameStatsSummary summary;
+    float fps = 0.0f;
+    uint64_t missed = 0;
+    int cpu = -1;
+    uint64_t migrations = 0;
+    uint64_t gpuBusySkips = 0;
+    if (engine->renderThread_) {
+        summary = engine->renderThread_->getFrameStats().summarize();
+        fps = engine->renderThread_->getCurrentFPS();
+        missed = engine->renderThread_->getMissedFrames();
+        cpu = engine->renderThread_->getCurrentCpu();
+        migrations = engine->renderThread_->getMigrationCount();
+        gpuBusySkips = engine->renderThread_->getGpuBusySkips();
+    }
+    uint64_t partialFrames = 0;
+    uint64_t skippedSwaps = 0;
+    uint64_t gpuWaitNs = 0;
+    uint64_t gpuWaitFrames = 0;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        if (engine->glContext_) {
+            partialFrames = engine->glContext_->getPartialFrameCount();
+            skippedSwaps = engine->glContext_->getSkippedSwapCount();
+            gpuWaitNs = engine->glContext_->getGpuWaitNs();
+            gpuWaitFrames = engine->glContext_->getGpuWaitFrames();
+        }
+    }
+
+    napi_value result;
+    napi_create_object(env, &result);
+
+    napi_value v;
+    napi_create_int32(env, summary.sampleCount, &v);
+    napi_set_named_property(env, result, "samples", v);
+    napi_create_double(env, static_cast<double>(fps), &v);
+    napi_set_named_property(env, result, "fps", v);
+    napi_create_double(env, static_cast<double>(missed), &v);
+    napi_set_named_property(env, result, "missedFrames", v);
+    napi_create_int32(env, cpu, &v);
+    napi_set_named_property(env, result, "cpu", v);
+    napi_create_double(env, static_cast<double>(migrations), &v);
+    napi_set_named_property(env, result, "migrations", v);
+    napi_create_double(env, static_cast<double>(partialFrames), &v);
+    napi_set_named_property(env, result, "partialFrames", v);
+    napi_create_double(env, static_cast<double>(skippedSwaps), &v);
+    napi_set_named_property(env, result, "skippedSwaps", v);
+    napi_create_int32(env, engine->maxFramesInFlight_.load(std::memory_order_relaxed), &v);
+    napi_set_named_property(env, result, "maxFramesInFlight", v);
+    napi_create_double(env, static_cast<double>(gpuWaitNs) / 1e6, &v);
+    napi_set_named_property(env, result, "gpuWaitMs", v);
+    napi_create_double(env, static_cast<double>(gpuWaitFrames), &v);
+    napi_set_named_property(env, result, "gpuWaitFrames", v);
+    napi_create_double(env, static_cast<double>(gpuBusySkips), &v);
+    napi_set_named_property(env, result, "gpuBusySkips", v);
+    napi_create_double(env, static_cast<double>(engine->touchEventsDelivered_.load(std::memory_order_relaxed)), &v);
+    napi_set_named_property(env, result, "touchEvents", v);
+    napi_create_double(env, static_cast<double>(engine->touchQueue_.getOverflowCount()), &v);
+    napi_set_named_property(env, result, "touchOverflows", v);
+
+    napi_value phases;
+    napi_create_object(env, &phases);
+    for (int i = 0; i < kFramePhaseCount; i++) {
+        napi_set_named_property(env, phases, GetFramePhaseName(static_cast<FramePhase>(i)),
+                                CreatePhaseStats(env, summary.phases[i]));
+    }
+    napi_set_named_property(env, phases, "frame", CreatePhaseStats(env, summary.frame));
+    napi_set_named_property(env, result, "phases", phases);
+    return result;
+}
+
+napi_value GLEXEngine::NapiGetFrameRateSteps(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    std::vector<FrameRateStep> steps;
+    if (engine->renderThread_) {
+        steps = engine->renderThread_->getFrameRateGovernor().getSteps();
+    }
+
+    napi_value result;
+    napi_create_array_with_length(env, steps.size(), &result);
+    for (size_t i = 0; i < steps.size(); i++) {
+        const FrameRateStep& step = steps[i];
+        napi_value obj;
+        napi_create_object(env, &obj);
+        napi_value v;
+        napi_create_double(env, static_cast<double>(step.timeMs), &v);
+        napi_set_named_property(env, obj, "timeMs", v);
+        napi_create_int32(env, step.fromFps, &v);
+        napi_set_named_property(env, obj, "fromFps", v);
+        napi_create_int32(env, step.toFps, &v);
+        napi_set_named_property(env, obj, "toFps", v);
+        napi_create_double(env, static_cast<double>(step.workP90Ms), &v);
+        napi_set_named_property(env, obj, "workP90Ms", v);
+        napi_create_double(env, static_cast<double>(step.overBudgetRatio), &v);
+        napi_set_named_property(env, obj, "overBudgetRatio", v);
+        napi_set_element(env, result, static_cast<uint32_t>(i), obj);
+    }
+    return result;
+}
+
 napi_value GLEXEngine::NapiGetGLInfo(napi_env env, napi_callback_info info)
 {
     size_t argc = 0;
@@ -1388,6 +2919,10 @@ napi_value GLEXEngine::NapiGetGLInfo(napi_env env, napi_callback_info info)
         napi_create_int32(env, engine->glContext_->getHeight(), &h);
         napi_set_named_property(env, result, "width", w);
         napi_set_named_property(env, result, "height", h);
+
+        napi_value shared;
+        napi_get_boolean(env, engine->glContext_->getShareGroup() != nullptr, &shared);
+        napi_set_named_property(env, result, "shareGroup", shared);
     } else {
         setStr("version", "not initialized");
         setStr("renderer", "not initialized");
@@ -1396,6 +2931,10 @@ napi_value GLEXEngine::NapiGetGLInfo(napi_env env, napi_callback_info info)
         napi_create_int32(env, 0, &h);
         napi_set_named_property(env, result, "width", w);
         napi_set_named_property(env, result, "height", h);
+
+        napi_value shared;
+        napi_get_boolean(env, false, &shared);
+        napi_set_named_property(env, result, "shareGroup", shared);
     }
 
     return result;
@@ -1427,6 +2966,300 @@ napi_value GLEXEngine::NapiGetGpuStats(napi_env env, napi_callback_info info)
     return result;
 }
 
+napi_value GLEXEngine::NapiSetProfilerEnabled(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    bool enabled = false;
+    if (argc < 1 || !GetBool(env, args[0], &enabled)) {
+        engine->SetError("setProfilerEnabled: invalid parameters");
+        return GetUndefined(env);
+    }
+    if (enabled && !PassProfiler::IsCompiledIn()) {
+        engine->SetError("setProfilerEnabled: profiler compiled out (GLEX_ENABLE_PROFILER=OFF)");
+        return GetUndefined(env);
+    }
+
+    engine->profilerEnabled_.store(enabled, std::memory_order_relaxed);
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiGetProfilerTrace(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    std::string trace;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        trace = engine->ExportProfilerTraceLocked();
+    }
+    napi_value result;
+    napi_create_string_utf8(env, trace.c_str(), trace.size(), &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiSaveProfilerTrace(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    std::string path;
+    if (argc < 1 || !GetString(env, args[0], path) || path.empty()) {
+        engine->SetError("saveProfilerTrace: invalid path");
+        return GetUndefined(env);
+    }
+
+    std::string trace;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        trace = engine->ExportProfilerTraceLocked();
+    }
+    // 文件写入在调用线程完成，不占用渲染线程
+    bool ok = PassProfiler::WriteTraceFile(path, trace);
+    if (!ok) {
+        engine->SetError("saveProfilerTrace: failed to write " + path);
+    }
+    napi_value result;
+    napi_get_boolean(env, ok, &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiRequestCapture(napi_env env, napi_callback_info info)
+{
+    size_t argc = 4;
+    napi_value args[4];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 4);
+    if (!engine) return GetUndefined(env);
+
+    CaptureRequest req;
+    if (argc >= 4) {
+        int32_t rect[4] = { 0, 0, 0, 0 };
+        for (size_t i = 0; i < 4; i++) {
+            if (!GetInt32(env, args[i], &rect[i])) {
+                engine->SetError("requestCapture: invalid rect");
+                return GetUndefined(env);
+            }
+        }
+        if (rect[2] <= 0 || rect[3] <= 0) {
+            engine->SetError("requestCapture: width and height must be positive");
+            return GetUndefined(env);
+        }
+        req.fullFrame = false;
+        req.x = rect[0];
+        req.y = rect[1];
+        req.width = rect[2];
+        req.height = rect[3];
+    } else if (argc != 0) {
+        engine->SetError("requestCapture: expected no arguments or (x, y, width, height)");
+        return GetUndefined(env);
+    }
+
+    int64_t id = -1;
+    {
+        std::lock_guard<std::mutex> lock(engine->captureMutex_);
+        if (engine->captureRequests_.size() < kMaxQueuedCaptures) {
+            req.id = engine->nextCaptureId_++;
+            engine->captureRequests_.push_back(req);
+            engine->pendingCaptureIds_.push_back(req.id);
+            engine->captureQueued_.store(true, std::memory_order_release);
+            id = static_cast<int64_t>(req.id);
+        }
+    }
+    if (id < 0) {
+        engine->SetError("requestCapture: too many pending captures");
+    } else {
+        engine->MarkDirty();
+    }
+
+    napi_value result;
+    napi_create_int64(env, id, &result);
+    return result;
+}
+
+napi_value GLEXEngine::NapiTakeCapture(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 1);
+    if (!engine) return GetUndefined(env);
+
+    double idValue = 0.0;
+    if (argc < 1 || !GetDouble(env, args[0], &idValue) || idValue < 1.0) {
+        engine->SetError("takeCapture: invalid id");
+        return GetUndefined(env);
+    }
+    uint64_t id = static_cast<uint64_t>(idValue);
+
+    ReadbackImage image;
+    {
+        std::lock_guard<std::mutex> lock(engine->captureMutex_);
+        auto it = std::find_if(engine->captureResults_.begin(), engine->captureResults_.end(),
+                               [id](const ReadbackImage& item) { return item.id == id; });
+        if (it == engine->captureResults_.end()) {
+            bool pending = std::find(engine->pendingCaptureIds_.begin(), engine->pendingCaptureIds_.end(), id) !=
+                           engine->pendingCaptureIds_.end();
+            if (pending) {
+                // 尚未完成
+                return GetUndefined(env);
+            }
+            engine->SetError("takeCapture: unknown or dropped capture");
+            napi_value nullValue;
+            napi_get_null(env, &nullValue);
+            return nullValue;
+        }
+        image = std::move(*it);
+        engine->captureResults_.erase(it);
+    }
+    if (!image.pixels) {
+        engine->SetError("takeCapture: readback failed");
+        napi_value nullValue;
+        napi_get_null(env, &nullValue);
+        return nullValue;
+    }
+
+    // 像素内存直接作为外部 ArrayBuffer 交给 ArkTS，由 GC 回收时释放
+    size_t length = image.byteLength();
+    uint8_t* data = image.pixels.release();
+    napi_value pixels;
+    if (napi_create_external_arraybuffer(env, data, length, FinalizeCapturePixels, nullptr, &pixels) != napi_ok) {
+        void* buffer = nullptr;
+        napi_create_arraybuffer(env, length, &buffer, &pixels);
+        if (buffer) {
+            memcpy(buffer, data, length);
+        }
+        delete[] data;
+    }
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_value v;
+    napi_create_int64(env, static_cast<int64_t>(image.id), &v);
+    napi_set_named_property(env, result, "id", v);
+    napi_create_int32(env, image.width, &v);
+    napi_set_named_property(env, result, "width", v);
+    napi_create_int32(env, image.height, &v);
+    napi_set_named_property(env, result, "height", v);
+    napi_set_named_property(env, result, "pixels", pixels);
+    return result;
+}
+
+napi_value GLEXEngine::NapiStartStreamCapture(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 2);
+    if (!engine) return GetUndefined(env);
+
+    napi_valuetype callbackType = napi_undefined;
+    if (argc < 2 || napi_typeof(env, args[1], &callbackType) != napi_ok || callbackType != napi_function) {
+        engine->SetError("startStreamCapture: expected (options, callback)");
+        return GetUndefined(env);
+    }
+
+    StreamConfig config;
+    napi_value v;
+    int32_t value = 0;
+    if (GetNamedProperty(env, args[0], "width", &v) && GetInt32(env, v, &value)) {
+        config.width = std::max(value, 0);
+    }
+    if (GetNamedProperty(env, args[0], "height", &v) && GetInt32(env, v, &value)) {
+        config.height = std::max(value, 0);
+    }
+    if (GetNamedProperty(env, args[0], "queueSize", &v) && GetInt32(env, v, &value)) {
+        if (value < 1) {
+            engine->SetError("startStreamCapture: queueSize must be positive");
+            return GetUndefined(env);
+        }
+        config.queueCapacity = static_cast<size_t>(value);
+    }
+
+    napi_value resourceName;
+    napi_create_string_utf8(env, "GLEXStreamCapture", NAPI_AUTO_LENGTH, &resourceName);
+    napi_threadsafe_function tsfn = nullptr;
+    if (napi_create_threadsafe_function(env, args[1], nullptr, resourceName, config.queueCapacity, 1, nullptr,
+                                        nullptr, nullptr, CallStreamCallback, &tsfn) != napi_ok) {
+        engine->SetError("startStreamCapture: failed to create callback");
+        return GetUndefined(env);
+    }
+
+    // JS 回调队列满时拒收（计入 droppedByConsumer），从不阻塞工作线程
+    auto streamer = std::make_unique<FrameStreamer>();
+    streamer->start(config, [tsfn](StreamFrame&& frame) {
+        auto* item = new StreamFrame(std::move(frame));
+        if (napi_call_threadsafe_function(tsfn, item, napi_tsfn_nonblocking) != napi_ok) {
+            delete item;
+            return false;
+        }
+        return true;
+    });
+
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->StopStreamLocked();
+    engine->streamTsfn_ = tsfn;
+    auto install = [engine, &streamer]() {
+        engine->streamer_ = std::move(streamer);
+    };
+    if (!engine->RunOnRenderThreadSync(install)) {
+        install();
+    }
+    engine->MarkDirty();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiStopStreamCapture(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    std::lock_guard<std::mutex> lock(engine->mutex_);
+    engine->StopStreamLocked();
+    return GetUndefined(env);
+}
+
+napi_value GLEXEngine::NapiGetStreamStats(napi_env env, napi_callback_info info)
+{
+    size_t argc = 0;
+    napi_value args[1];
+    GLEXEngine* engine = UnwrapEngine(env, info, &argc, args, 0);
+    if (!engine) return GetUndefined(env);
+
+    StreamStats stats;
+    bool running = false;
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex_);
+        running = engine->streamer_ != nullptr;
+        stats = running ? engine->streamer_->getStats() : engine->lastStreamStats_;
+    }
+
+    napi_value result;
+    napi_create_object(env, &result);
+    napi_value v;
+    napi_get_boolean(env, running, &v);
+    napi_set_named_property(env, result, "running", v);
+    auto setCount = [&](const char* key, uint64_t count) {
+        napi_create_double(env, static_cast<double>(count), &v);
+        napi_set_named_property(env, result, key, v);
+    };
+    setCount("captured", stats.captured);
+    setCount("delivered", stats.delivered);
+    setCount("dropped", stats.dropped());
+    setCount("droppedGpuBusy", stats.droppedGpuBusy);
+    setCount("droppedQueueFull", stats.droppedQueueFull);
+    setCount("droppedByConsumer", stats.droppedByConsumer);
+    return result;
+}
+
 napi_value GLEXEngine::NapiGetLastError(napi_env env, napi_callback_info info)
 {
     size_t argc = 0;
@@ -1552,9 +3385,24 @@ static void OnSurfaceDestroyed(OH_NativeXComponent* component, void* window)
 
 static void OnDispatchTouchEvent(OH_NativeXComponent* component, void* window)
 {
-    (void)component;
-    (void)window;
-    // 预留触摸事件接口
+    std::string id = GetXComponentId(component);
+    if (id.empty()) {
+        return;
+    }
+
+    GLEXEngine* engine = nullptr;
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.engines.find(id);
+        if (it == registry.engines.end()) {
+            // 尚未绑定实例：丢弃（绑定后 ArkTS 转发的事件仍可作为回退）
+            return;
+        }
+        engine = it->second;
+    }
+
+    engine->HandleNativeTouch(component, window);
 }
 
 static OH_NativeXComponent_Callback* GetXComponentCallback()
@@ -1604,18 +3452,48 @@ napi_value Init(napi_env env, napi_value exports)
         { "resize", nullptr, GLEXEngine::NapiResize, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setBackgroundColor", nullptr, GLEXEngine::NapiSetBackgroundColor, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setTargetFPS", nullptr, GLEXEngine::NapiSetTargetFPS, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setRenderMode", nullptr, GLEXEngine::NapiSetRenderMode, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "requestRender", nullptr, GLEXEngine::NapiRequestRender, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setAdaptiveFrameRate", nullptr, GLEXEngine::NapiSetAdaptiveFrameRate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setParallelUpdate", nullptr, GLEXEngine::NapiSetParallelUpdate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setPipelinedUpdate", nullptr, GLEXEngine::NapiSetPipelinedUpdate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setFixedTimestep", nullptr, GLEXEngine::NapiSetFixedTimestep, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setSharedRenderThread", nullptr, GLEXEngine::NapiSetSharedRenderThread, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setShareGroup", nullptr, GLEXEngine::NapiSetShareGroup, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setPartialPresent", nullptr, GLEXEngine::NapiSetPartialPresent, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setMaxFramesInFlight", nullptr, GLEXEngine::NapiSetMaxFramesInFlight, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setResolutionScale", nullptr, GLEXEngine::NapiSetResolutionScale, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setDynamicResolution", nullptr, GLEXEngine::NapiSetDynamicResolution, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getRenderResolution", nullptr, GLEXEngine::NapiGetRenderResolution, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setRenderThreadPolicy", nullptr, GLEXEngine::NapiSetRenderThreadPolicy, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setShaderSources", nullptr, GLEXEngine::NapiSetShaderSources, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "loadShaderFromRawfile", nullptr, GLEXEngine::NapiLoadShaderFromRawfile, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "loadRawfileBytes", nullptr, GLEXEngine::NapiLoadRawfileBytes, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setUniform", nullptr, GLEXEngine::NapiSetUniform, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getUniformHandle", nullptr, GLEXEngine::NapiGetUniformHandle, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setUniformByHandle", nullptr, GLEXEngine::NapiSetUniformByHandle, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "submitCommands", nullptr, GLEXEngine::NapiSubmitCommands, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setPasses", nullptr, GLEXEngine::NapiSetPasses, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "addPass", nullptr, GLEXEngine::NapiAddPass, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "removePass", nullptr, GLEXEngine::NapiRemovePass, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "getPasses", nullptr, GLEXEngine::NapiGetPasses, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "setTouchEvent", nullptr, GLEXEngine::NapiSetTouchEvent, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setNativeTouch", nullptr, GLEXEngine::NapiSetNativeTouch, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getTouchStats", nullptr, GLEXEngine::NapiGetTouchStats, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "getCurrentFPS", nullptr, GLEXEngine::NapiGetCurrentFPS, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getMissedFrames", nullptr, GLEXEngine::NapiGetMissedFrames, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getFrameStats", nullptr, GLEXEngine::NapiGetFrameStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getFrameRateSteps", nullptr, GLEXEngine::NapiGetFrameRateSteps, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "getGLInfo", nullptr, GLEXEngine::NapiGetGLInfo, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "getGpuStats", nullptr, GLEXEngine::NapiGetGpuStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setProfilerEnabled", nullptr, GLEXEngine::NapiSetProfilerEnabled, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getProfilerTrace", nullptr, GLEXEngine::NapiGetProfilerTrace, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "saveProfilerTrace", nullptr, GLEXEngine::NapiSaveProfilerTrace, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "requestCapture", nullptr, GLEXEngine::NapiRequestCapture, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "takeCapture", nullptr, GLEXEngine::NapiTakeCapture, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "startStreamCapture", nullptr, GLEXEngine::NapiStartStreamCapture, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "stopStreamCapture", nullptr, GLEXEngine::NapiStopStreamCapture, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getStreamStats", nullptr, GLEXEngine::NapiGetStreamStats, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "getLastError", nullptr, GLEXEngine::NapiGetLastError, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "clearLastError", nullptr, GLEXEngine::NapiClearLastError, nullptr, nullptr, nullptr, napi_default, nullptr },
     };
@@ -34,14 +34,34 @@ void ShaderPass::setShaderSources(const std::string& vert, const std::string& fr
     vertexSrc_ = vert;
     fragmentSrc_ = frag;
     needsRebuild_ = true;
+    requestRedraw();
 }
 
-void ShaderPass::setUniform(const std::string& name, const std::vector<float>& values)
+void ShaderPass::setUniform(int handle, const std::string& name, const float* values, size_t count)
 {
-    if (name.empty() || values.empty()) {
+    if (handle < 0 || !values || count == 0) {
         return;
     }
-    uniforms_[name] = values;
+    if (static_cast<size_t>(handle) >= slots_.size()) {
+        slots_.resize(static_cast<size_t>(handle) + 1);
+    }
+    UniformSlot& slot = slots_[static_cast<size_t>(handle)];
+    if (slot.name.empty()) {
+        slot.name = name;
+        slot.resolved = false;
+    }
+    // 复用已有存储：同一 uniform 反复设置时不再分配
+    slot.values.assign(values, values + count);
+    slot.dirty = true;
+    requestRedraw();
+}
+
+void ShaderPass::compilePending()
+{
+    if (needsRebuild_ && isInitialized()) {
+        buildProgram();
+        needsRebuild_ = false;
+    }
 }
 
 void ShaderPass::onInitialize(int width, int height)
@@ -75,6 +95,10 @@ void ShaderPass::onResize(int width, int height)
 void ShaderPass::onUpdate(float deltaTime)
 {
     time_ += deltaTime;
+    // 静态着色器在 OnDemand 模式下无需重绘
+    if (animated_) {
+        requestRedraw();
+    }
 }
 
 void ShaderPass::onRender()
@@ -89,8 +113,12 @@ void ShaderPass::onRender()
     }
 
     shader_.use();
-    shader_.setUniform1f("u_time", time_);
-    shader_.setUniform2f("u_resolution", static_cast<float>(width_), static_cast<float>(height_));
+    if (timeLocation_ >= 0) {
+        glUniform1f(timeLocation_, time_);
+    }
+    if (resolutionLocation_ >= 0) {
+        glUniform2f(resolutionLocation_, static_cast<float>(width_), static_cast<float>(height_));
+    }
 
     applyUniforms();
 
@@ -119,27 +147,39 @@ void ShaderPass::buildProgram()
     std::string vert = vertexSrc_.empty() ? kDefaultVert : vertexSrc_;
     std::string frag = fragmentSrc_.empty() ? kDefaultFrag : fragmentSrc_;
 
+    // 新程序的 uniform 位置与值都需重新解析、上传
+    for (auto& slot : slots_) {
+        slot.resolved = false;
+        slot.dirty = !slot.values.empty();
+    }
+    timeLocation_ = -1;
+    resolutionLocation_ = -1;
+
     if (!shader_.build(vert, frag)) {
         GLEX_LOGE("ShaderPass: shader build failed");
+        animated_ = false;
+        return;
+    }
+    timeLocation_ = shader_.getUniformLocation("u_time");
+    resolutionLocation_ = shader_.getUniformLocation("u_resolution");
+    animated_ = timeLocation_ >= 0;
+    if (animated_) {
+        requestRedraw();
     }
 }
 
 void ShaderPass::applyUniforms()
 {
-    for (const auto& item : uniforms_) {
-        const std::string& name = item.first;
-        const std::vector<float>& v = item.second;
-        if (v.size() == 1) {
-            shader_.setUniform1f(name, v[0]);
-        } else if (v.size() == 2) {
-            shader_.setUniform2f(name, v[0], v[1]);
-        } else if (v.size() == 3) {
-            shader_.setUniform3f(name, v[0], v[1], v[2]);
-        } else if (v.size() == 4) {
-            shader_.setUniform4f(name, v[0], v[1], v[2], v[3]);
-        } else if (v.size() == 16) {
-            shader_.setUniformMatrix4fv(name, v.data(), false);
+    for (auto& slot : slots_) {
+        if (!slot.dirty) {
+            continue;
+        }
+        if (!slot.resolved) {
+            shader_.getUniformInfo(slot.name, &slot.info);
+            slot.resolved = true;
         }
+        ShaderProgram::setUniformfv(slot.info, slot.values.data(), slot.values.size());
+        slot.dirty = false;
     }
 }
 
@@ -6,10 +6,14 @@
  *
  * 提供可由 ArkTS 侧传入的自定义顶点/片元着色器，
  * 通过 RenderPass 接入渲染管线，用于替代内置 DemoPass。
+ *
+ * 自定义 uniform 按句柄（UniformTable 分配的整数）存放在数组中：
+ * 位置与类型在每次编译后按名字解析一次，之后每帧只上传被改动过的 uniform，
+ * 渲染路径上没有字符串查找与内存分配。
  */
 
+#include <cstddef>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include <GLES3/gl3.h>
@@ -21,11 +25,18 @@ namespace glex {
 
 class ShaderPass : public RenderPass {
 public:
-    ShaderPass() : RenderPass("ShaderPass") {}
+    ShaderPass() : RenderPass("ShaderPass") { parallelUpdateSafe_ = true; }
 
     void setShaderSources(const std::string& vert, const std::string& frag);
 
-    void setUniform(const std::string& name, const std::vector<float>& values);
+    /** 立即编译待更新的着色器（GL 线程调用；尚未初始化时留到 onInitialize） */
+    void compilePending();
+
+    /**
+     * 按句柄设置 uniform（name 仅在该句柄首次设置时使用）
+     * values 可为数组 uniform 的全部分量，如 vec4[64] 传 256 个 float
+     */
+    void setUniform(int handle, const std::string& name, const float* values, size_t count);
 
 protected:
     void onInitialize(int width, int height) override;
@@ -47,8 +58,18 @@ private:
     GLuint vbo_ = 0;
 
     float time_ = 0.0f;
+    bool animated_ = false;  // 着色器使用 u_time 时需持续重绘
+    GLint timeLocation_ = -1;
+    GLint resolutionLocation_ = -1;
 
-    std::unordered_map<std::string, std::vector<float>> uniforms_;
+    struct UniformSlot {
+        std::string name;
+        std::vector<float> values;          // 容量只增不减
+        ShaderProgram::UniformInfo info;
+        bool resolved = false;              // info 是否对应当前程序
+        bool dirty = false;
+    };
+    std::vector<UniformSlot> slots_;        // 以句柄为下标
 };
 
 } // namespace glex
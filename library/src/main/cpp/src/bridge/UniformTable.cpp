@@ -0,0 +1,52 @@
+#include "UniformTable.h"
+
+#include <cstring>
+
+namespace glex {
+namespace bridge {
+
+int UniformTable::getHandle(const std::string& name)
+{
+    if (name.empty()) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = handles_.find(name);
+    if (it != handles_.end()) {
+        return it->second;
+    }
+    if (static_cast<int>(slots_.size()) >= kMaxHandles) {
+        return -1;
+    }
+    int handle = static_cast<int>(slots_.size());
+    slots_.emplace_back();
+    slots_.back().name = name;
+    handles_.emplace(name, handle);
+    return handle;
+}
+
+bool UniformTable::set(int handle, const float* values, size_t count)
+{
+    if (handle < 0 || !values || count == 0 || count > kMaxValues) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (static_cast<size_t>(handle) >= slots_.size()) {
+        return false;
+    }
+    Slot& slot = slots_[static_cast<size_t>(handle)];
+    if (slot.values.size() < count) {
+        slot.values.resize(count);
+    }
+    std::memcpy(slot.values.data(), values, count * sizeof(float));
+    slot.count = count;
+    if (!slot.dirty) {
+        slot.dirty = true;
+        dirty_.push_back(handle);
+    }
+    hasDirty_.store(true, std::memory_order_release);
+    return true;
+}
+
+} // namespace bridge
+} // namespace glex
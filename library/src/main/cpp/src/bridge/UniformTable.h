@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file UniformTable.h
+ * @brief 按句柄索引的 uniform 暂存表
+ *
+ * ArkTS 线程写入、渲染线程每帧取走：
+ *   - getHandle(name) 只在登记时按名字查找一次，返回稳定的整数句柄（同名同句柄）
+ *   - set(handle, values, count) 按下标定位，从调用方内存（如 Float32Array 的底层存储）
+ *     直接 memcpy 到该句柄的暂存区并记入脏列表；暂存区容量只增不减，稳态下不分配
+ *   - consume() 在渲染线程只遍历脏句柄（或全部），交给 ShaderPass 按句柄应用
+ *
+ * 支持 uniform 数组（如 mat4[16]、vec4[64]），单个 uniform 至多 kMaxValues 个 float。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace glex {
+namespace bridge {
+
+class UniformTable {
+public:
+    /** 单个 uniform 的 float 数上限 */
+    static constexpr size_t kMaxValues = 4096;
+
+    /** 句柄数上限 */
+    static constexpr int kMaxHandles = 1024;
+
+    UniformTable() = default;
+
+    // 禁止拷贝
+    UniformTable(const UniformTable&) = delete;
+    UniformTable& operator=(const UniformTable&) = delete;
+
+    /** 登记 / 查找名字对应的句柄（名字为空或句柄已满时返回 -1） */
+    int getHandle(const std::string& name);
+
+    /** 句柄是否由 getHandle 返回过 */
+    bool isValid(int handle) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return handle >= 0 && static_cast<size_t>(handle) < slots_.size();
+    }
+
+    /** 写入值并标脏（句柄无效或数量越界时返回 false） */
+    bool set(int handle, const float* values, size_t count);
+
+    /** 按名字写入（每次调用查找一次名字） */
+    bool set(const std::string& name, const float* values, size_t count) { return set(getHandle(name), values, count); }
+
+    /**
+     * 取走 uniform：all 为 false 时只遍历脏句柄，为 true 时遍历全部已写入的句柄
+     * fn(handle, name, values, count) 在持锁状态下调用，只应做拷贝
+     */
+    template <typename Fn>
+    void consume(bool all, Fn&& fn)
+    {
+        if (!all && !hasDirty_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        hasDirty_.store(false, std::memory_order_relaxed);
+        if (all) {
+            for (size_t i = 0; i < slots_.size(); i++) {
+                Slot& slot = slots_[i];
+                slot.dirty = false;
+                if (slot.count > 0) {
+                    fn(static_cast<int>(i), slot.name, slot.values.data(), slot.count);
+                }
+            }
+        } else {
+            for (int handle : dirty_) {
+                Slot& slot = slots_[static_cast<size_t>(handle)];
+                slot.dirty = false;
+                fn(handle, slot.name, slot.values.data(), slot.count);
+            }
+        }
+        dirty_.clear();
+    }
+
+private:
+    struct Slot {
+        std::string name;
+        std::vector<float> values;   // 容量只增不减
+        size_t count = 0;
+        bool dirty = false;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, int> handles_;
+    std::vector<Slot> slots_;
+    std::vector<int> dirty_;
+    std::atomic<bool> hasDirty_{false};
+};
+
+} // namespace bridge
+} // namespace glex
@@ -0,0 +1,155 @@
+#include "glex/AsyncReadback.h"
+#include "glex/GLResourceTracker.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace glex {
+
+namespace {
+// 每个标志位至多记录一个错误；上下文丢失时 glGetError 可能一直返回错误，限制清空次数
+constexpr int kMaxDrainedErrors = 16;
+} // namespace
+
+AsyncReadback::AsyncReadback(size_t slots)
+    : slots_(std::max<size_t>(slots, 1))
+{
+}
+
+bool AsyncReadback::request(uint64_t id, int x, int y, int width, int height)
+{
+    // 先检查本次读取自身的前置条件，不依赖 glGetError 判断参数错误
+    if (x < 0 || y < 0 || width <= 0 || height <= 0) {
+        return false;
+    }
+    auto it = std::find_if(slots_.begin(), slots_.end(), [](const Slot& slot) { return !slot.busy; });
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    // 之前残留的错误（可能来自本帧无关的代码）逐条记录后清空，下面的检查只反映本次读取
+    for (int i = 0; i < kMaxDrainedErrors; i++) {
+        GLenum pending = glGetError();
+        if (pending == GL_NO_ERROR) {
+            break;
+        }
+        GLEX_LOGW("AsyncReadback: GL error 0x%{public}X raised before readback", pending);
+    }
+
+    Slot& slot = *it;
+    size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    if (slot.pbo == 0) {
+        glGenBuffers(1, &slot.pbo);
+        GLResourceTracker::Get().OnCreateBuffer();
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (slot.capacity < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    // 绑定 PACK 缓冲时最后一个参数是缓冲内偏移，调用立即返回
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        GLEX_LOGE("AsyncReadback: glReadPixels failed, error=0x%{public}X", err);
+        return false;
+    }
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.id = id;
+    slot.order = nextOrder_++;
+    slot.width = width;
+    slot.height = height;
+    slot.busy = true;
+    return true;
+}
+
+size_t AsyncReadback::poll(std::vector<ReadbackImage>& out)
+{
+    // 按发起顺序检查：先发起的未完成时，后发起的也不会完成
+    std::vector<Slot*> busy;
+    for (auto& slot : slots_) {
+        if (slot.busy) {
+            busy.push_back(&slot);
+        }
+    }
+    std::sort(busy.begin(), busy.end(), [](const Slot* a, const Slot* b) { return a->order < b->order; });
+
+    size_t count = 0;
+    for (Slot* slot : busy) {
+        GLenum status = glClientWaitSync(slot->fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+        ReadbackImage image;
+        image.id = slot->id;
+        if (status == GL_WAIT_FAILED || !resolve(*slot, image)) {
+            GLEX_LOGE("AsyncReadback: readback %{public}llu failed", static_cast<unsigned long long>(slot->id));
+            image.pixels.reset();
+        }
+        glDeleteSync(slot->fence);
+        slot->fence = nullptr;
+        slot->busy = false;
+        out.push_back(std::move(image));
+        count++;
+    }
+    return count;
+}
+
+bool AsyncReadback::resolve(Slot& slot, ReadbackImage& image)
+{
+    size_t rowBytes = static_cast<size_t>(slot.width) * 4;
+    size_t size = rowBytes * static_cast<size_t>(slot.height);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const uint8_t* mapped = static_cast<const uint8_t*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT));
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return false;
+    }
+
+    // GL 行序自下而上：拷贝时翻转为自上而下
+    image.width = slot.width;
+    image.height = slot.height;
+    image.pixels.reset(new uint8_t[size]);
+    for (int row = 0; row < slot.height; row++) {
+        std::memcpy(image.pixels.get() + static_cast<size_t>(row) * rowBytes,
+                    mapped + static_cast<size_t>(slot.height - 1 - row) * rowBytes,
+                    rowBytes);
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+bool AsyncReadback::hasFreeSlot() const
+{
+    return std::any_of(slots_.begin(), slots_.end(), [](const Slot& slot) { return !slot.busy; });
+}
+
+size_t AsyncReadback::getInFlightCount() const
+{
+    return static_cast<size_t>(std::count_if(slots_.begin(), slots_.end(),
+                                             [](const Slot& slot) { return slot.busy; }));
+}
+
+void AsyncReadback::release()
+{
+    for (auto& slot : slots_) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        if (slot.pbo) {
+            glDeleteBuffers(1, &slot.pbo);
+            GLResourceTracker::Get().OnDeleteBuffer();
+        }
+        slot = Slot();
+    }
+}
+
+} // namespace glex
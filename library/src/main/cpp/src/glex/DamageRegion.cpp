@@ -0,0 +1,107 @@
+#include "glex/DamageRegion.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace glex {
+
+namespace {
+
+int64_t Area(const DamageRect& rect)
+{
+    return rect.isEmpty() ? 0 : static_cast<int64_t>(rect.width) * static_cast<int64_t>(rect.height);
+}
+
+bool Intersects(const DamageRect& a, const DamageRect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+} // namespace
+
+DamageRect UnionDamage(const DamageRect& a, const DamageRect& b)
+{
+    if (a.isEmpty()) {
+        return b;
+    }
+    if (b.isEmpty()) {
+        return a;
+    }
+    int left = std::min(a.x, b.x);
+    int bottom = std::min(a.y, b.y);
+    int right = std::max(a.x + a.width, b.x + b.width);
+    int top = std::max(a.y + a.height, b.y + b.height);
+    return { left, bottom, right - left, top - bottom };
+}
+
+DamageRect BoundingDamage(const std::vector<DamageRect>& rects)
+{
+    DamageRect bounds;
+    for (const auto& rect : rects) {
+        bounds = UnionDamage(bounds, rect);
+    }
+    return bounds;
+}
+
+DamageRect ClipDamage(const DamageRect& rect, int width, int height)
+{
+    int left = std::max(rect.x, 0);
+    int bottom = std::max(rect.y, 0);
+    int right = std::min(rect.x + rect.width, width);
+    int top = std::min(rect.y + rect.height, height);
+    if (right <= left || top <= bottom) {
+        return {};
+    }
+    return { left, bottom, right - left, top - bottom };
+}
+
+void MergeDamage(std::vector<DamageRect>& rects, int width, int height, size_t maxRects)
+{
+    // 裁剪并去掉空矩形
+    size_t count = 0;
+    for (const auto& rect : rects) {
+        DamageRect clipped = ClipDamage(rect, width, height);
+        if (!clipped.isEmpty()) {
+            rects[count++] = clipped;
+        }
+    }
+    rects.resize(count);
+
+    // 相交的矩形直接合并，直到没有相交
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; i++) {
+            for (size_t j = i + 1; j < rects.size(); j++) {
+                if (Intersects(rects[i], rects[j])) {
+                    rects[i] = UnionDamage(rects[i], rects[j]);
+                    rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(j));
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    maxRects = std::max<size_t>(maxRects, 1);
+    while (rects.size() > maxRects) {
+        size_t bestI = 0;
+        size_t bestJ = 1;
+        int64_t bestGrowth = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < rects.size(); i++) {
+            for (size_t j = i + 1; j < rects.size(); j++) {
+                int64_t growth = Area(UnionDamage(rects[i], rects[j])) - Area(rects[i]) - Area(rects[j]);
+                if (growth < bestGrowth) {
+                    bestGrowth = growth;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+        rects[bestI] = UnionDamage(rects[bestI], rects[bestJ]);
+        rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestJ));
+    }
+}
+
+} // namespace glex
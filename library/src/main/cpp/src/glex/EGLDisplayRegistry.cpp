@@ -0,0 +1,116 @@
+#include "glex/EGLDisplayRegistry.h"
+#include "glex/Log.h"
+
+namespace glex {
+
+EGLDisplayRegistry& EGLDisplayRegistry::Get()
+{
+    static EGLDisplayRegistry registry;
+    return registry;
+}
+
+bool EGLDisplayRegistry::acquire(EGLDisplay display)
+{
+    if (display == EGL_NO_DISPLAY) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = displays_.find(display);
+    if (it != displays_.end()) {
+        // 已初始化（包括引用计数归零后保留的 Display）
+        it->second.refs++;
+        return true;
+    }
+
+    EGLint major = 0;
+    EGLint minor = 0;
+    if (!eglInitialize(display, &major, &minor)) {
+        GLEX_LOGE("Failed to initialize EGL, error=0x%{public}X", eglGetError());
+        return false;
+    }
+    stats_.initializations++;
+    displays_[display].refs = 1;
+    GLEX_LOGI("EGL version: %{public}d.%{public}d", major, minor);
+    return true;
+}
+
+void EGLDisplayRegistry::release(EGLDisplay display)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = displays_.find(display);
+    if (it == displays_.end() || it->second.refs <= 0) {
+        GLEX_LOGW("EGLDisplayRegistry: release without acquire");
+        return;
+    }
+    it->second.refs--;
+}
+
+bool EGLDisplayRegistry::chooseConfig(EGLDisplay display, const EGLint* attribs, EGLConfig* config)
+{
+    std::vector<EGLint> key;
+    for (const EGLint* attr = attribs; *attr != EGL_NONE; attr += 2) {
+        key.push_back(attr[0]);
+        key.push_back(attr[1]);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = displays_.find(display);
+    if (it == displays_.end()) {
+        return false;
+    }
+    auto cached = it->second.configs.find(key);
+    if (cached != it->second.configs.end()) {
+        stats_.configHits++;
+        *config = cached->second;
+        return true;
+    }
+
+    stats_.configMisses++;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, attribs, config, 1, &numConfigs) || numConfigs <= 0) {
+        return false;
+    }
+    it->second.configs.emplace(std::move(key), *config);
+    return true;
+}
+
+int EGLDisplayRegistry::terminateIdle()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    int count = 0;
+    for (auto it = displays_.begin(); it != displays_.end();) {
+        if (it->second.refs > 0) {
+            ++it;
+            continue;
+        }
+        eglTerminate(it->first);
+        stats_.terminations++;
+        count++;
+        it = displays_.erase(it);
+    }
+    if (count > 0) {
+        GLEX_LOGI("EGLDisplayRegistry: terminated %{public}d idle display(s)", count);
+    }
+    return count;
+}
+
+int EGLDisplayRegistry::getRefCount(EGLDisplay display) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = displays_.find(display);
+    return it == displays_.end() ? 0 : it->second.refs;
+}
+
+EGLDisplayStats EGLDisplayRegistry::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    EGLDisplayStats stats = stats_;
+    stats.activeDisplays = 0;
+    for (const auto& item : displays_) {
+        stats.activeDisplays += item.second.refs > 0 ? 1 : 0;
+    }
+    return stats;
+}
+
+} // namespace glex
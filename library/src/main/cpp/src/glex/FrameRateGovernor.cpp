@@ -0,0 +1,194 @@
+#include "glex/FrameRateGovernor.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace glex {
+
+namespace {
+
+float ToMs(FrameRateGovernor::Clock::duration d)
+{
+    return std::chrono::duration<float, std::milli>(d).count();
+}
+
+float BudgetMs(int fps)
+{
+    return 1000.0f / static_cast<float>(fps > 0 ? fps : 1);
+}
+
+} // namespace
+
+void FrameRateGovernor::setEnabled(bool enabled)
+{
+    bool was = enabled_.exchange(enabled, std::memory_order_relaxed);
+    if (enabled && !was) {
+        restartPending_.store(true, std::memory_order_release);
+    }
+    if (!enabled) {
+        currentFps_.store(0, std::memory_order_relaxed);
+    }
+}
+
+void FrameRateGovernor::configure(const Config& config)
+{
+    Config normalized = config;
+    std::vector<int>& ladder = normalized.ladder;
+    ladder.erase(std::remove_if(ladder.begin(), ladder.end(), [](int fps) { return fps <= 0; }), ladder.end());
+    std::sort(ladder.begin(), ladder.end(), std::greater<int>());
+    ladder.erase(std::unique(ladder.begin(), ladder.end()), ladder.end());
+    normalized.windowFrames = std::max(normalized.windowFrames, 1);
+    normalized.upStableWindows = std::max(normalized.upStableWindows, 1);
+    normalized.maxStableWindows = std::max(normalized.maxStableWindows, normalized.upStableWindows);
+    {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        config_ = std::move(normalized);
+    }
+    configDirty_.store(true, std::memory_order_release);
+}
+
+FrameRateGovernor::Config FrameRateGovernor::getConfig() const
+{
+    std::lock_guard<std::mutex> lock(configMutex_);
+    return config_;
+}
+
+std::vector<FrameRateStep> FrameRateGovernor::getSteps() const
+{
+    std::lock_guard<std::mutex> lock(stepsMutex_);
+    return steps_;
+}
+
+int FrameRateGovernor::onFrame(int ceilingFps, Clock::duration workTime, bool missedDeadline)
+{
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return ceilingFps;
+    }
+
+    bool configChanged = configDirty_.exchange(false, std::memory_order_acq_rel);
+    if (configChanged) {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        active_ = config_;
+    }
+    bool restartRequested = restartPending_.exchange(false, std::memory_order_acq_rel);
+    if (restartRequested || configChanged || ceilingFps != ceilingFps_) {
+        restart(ceilingFps, restartRequested);
+    }
+
+    int fps = levels_[level_];
+    float workMs = ToMs(workTime);
+    windowWorkMs_.push_back(workMs);
+    if (workMs > BudgetMs(fps)) {
+        windowOverBudget_++;
+    }
+    if (missedDeadline) {
+        windowMissed_++;
+    }
+
+    if (static_cast<int>(windowWorkMs_.size()) >= active_.windowFrames) {
+        evaluateWindow();
+    }
+    return levels_[level_];
+}
+
+void FrameRateGovernor::restart(int ceilingFps, bool newSession)
+{
+    ceilingFps_ = ceilingFps;
+    buildLevels(ceilingFps);
+    level_ = 0;
+    windowWorkMs_.clear();
+    windowWorkMs_.reserve(static_cast<size_t>(active_.windowFrames));
+    windowOverBudget_ = 0;
+    windowMissed_ = 0;
+    stableWindows_ = 0;
+    requiredStableWindows_ = active_.upStableWindows;
+    if (newSession) {
+        startTime_ = Clock::now();
+        std::lock_guard<std::mutex> lock(stepsMutex_);
+        steps_.clear();
+    }
+    lastDownTime_ = Clock::time_point{};
+    lastUpTime_ = Clock::time_point{};
+    currentFps_.store(levels_[level_], std::memory_order_relaxed);
+}
+
+void FrameRateGovernor::buildLevels(int ceilingFps)
+{
+    int ceiling = ceilingFps > 0 ? ceilingFps : 1;
+    levels_.clear();
+    levels_.push_back(ceiling);
+    for (int fps : active_.ladder) {
+        if (fps < ceiling) {
+            levels_.push_back(fps);
+        }
+    }
+}
+
+void FrameRateGovernor::evaluateWindow()
+{
+    size_t count = windowWorkMs_.size();
+    size_t p90Index = std::min(count - 1, (count * 9) / 10);
+    std::nth_element(windowWorkMs_.begin(), windowWorkMs_.begin() + p90Index, windowWorkMs_.end());
+    float p90Ms = windowWorkMs_[p90Index];
+    float overRatio = static_cast<float>(std::max(windowOverBudget_, windowMissed_)) / static_cast<float>(count);
+    int missed = windowMissed_;
+
+    windowWorkMs_.clear();
+    windowOverBudget_ = 0;
+    windowMissed_ = 0;
+
+    Clock::time_point now = Clock::now();
+    int fps = levels_[level_];
+
+    if (overRatio >= active_.downOverBudgetRatio && level_ + 1 < levels_.size()) {
+        // 升档后冷却期内又撑不住：视为振荡，提高下次升档门槛
+        if (lastUpTime_ > lastDownTime_ && now - lastUpTime_ < active_.downCooldown) {
+            requiredStableWindows_ = std::min(requiredStableWindows_ * 2, active_.maxStableWindows);
+        }
+        level_++;
+        stableWindows_ = 0;
+        lastDownTime_ = now;
+        recordStep(fps, levels_[level_], p90Ms, overRatio);
+        return;
+    }
+
+    if (level_ == 0) {
+        stableWindows_ = 0;
+        return;
+    }
+
+    int higherFps = levels_[level_ - 1];
+    bool stable = missed == 0 && p90Ms < BudgetMs(higherFps) * active_.upHeadroom;
+    stableWindows_ = stable ? stableWindows_ + 1 : 0;
+    bool cooledDown = lastDownTime_ == Clock::time_point{} || now - lastDownTime_ >= active_.downCooldown;
+    if (stableWindows_ >= requiredStableWindows_ && cooledDown) {
+        level_--;
+        stableWindows_ = 0;
+        lastUpTime_ = now;
+        recordStep(fps, higherFps, p90Ms, overRatio);
+    }
+}
+
+void FrameRateGovernor::recordStep(int fromFps, int toFps, float p90Ms, float ratio)
+{
+    currentFps_.store(toFps, std::memory_order_relaxed);
+
+    FrameRateStep step;
+    step.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime_).count();
+    step.fromFps = fromFps;
+    step.toFps = toFps;
+    step.workP90Ms = p90Ms;
+    step.overBudgetRatio = ratio;
+    {
+        std::lock_guard<std::mutex> lock(stepsMutex_);
+        if (steps_.size() >= kMaxSteps) {
+            steps_.erase(steps_.begin());
+        }
+        steps_.push_back(step);
+    }
+    GLEX_LOGI("FrameRateGovernor: %{public}d -> %{public}d FPS (work p90 %{public}.2f ms, over budget %{public}.0f%%)",
+              fromFps, toFps, p90Ms, ratio * 100.0f);
+}
+
+} // namespace glex
@@ -0,0 +1,84 @@
+#include "glex/FrameScheduler.h"
+
+#include <thread>
+
+namespace glex {
+
+void FrameScheduler::setTargetFPS(int fps)
+{
+    fps = fps > 0 ? fps : 1;
+    if (fps == fps_) {
+        return;
+    }
+    fps_ = fps;
+    period_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(1000000000LL / static_cast<long long>(fps)));
+}
+
+void FrameScheduler::reset(Clock::time_point now)
+{
+    deadline_ = now + period_;
+    missedFrames_.store(0, std::memory_order_relaxed);
+    // 上次停止时留下的中断不属于这一轮
+    if (vsync_) {
+        vsync_->clearInterrupt();
+    }
+}
+
+FrameScheduler::Clock::time_point FrameScheduler::waitForNextFrame()
+{
+    auto now = Clock::now();
+    if (now >= deadline_) {
+        auto late = now - deadline_;
+        if (late < period_ / 4) {
+            // 轻微超时：立即开始下一帧，保持原有节拍
+            deadline_ += period_;
+            return now;
+        }
+        // 错过了一个或多个截止时间：计数并跳到下一个对齐的截止时间，避免追帧
+        auto skipped = late / period_ + 1;
+        missedFrames_.fetch_add(static_cast<uint64_t>(skipped), std::memory_order_relaxed);
+        deadline_ += period_ * skipped;
+    }
+
+    Clock::time_point frameStart = deadline_;
+    if (vsync_) {
+        frameStart = waitForVsyncAligned(deadline_);
+    } else {
+        SleepUntil(deadline_);
+    }
+    deadline_ = frameStart + period_;
+    return frameStart;
+}
+
+FrameScheduler::Clock::time_point FrameScheduler::waitForVsyncAligned(Clock::time_point deadline)
+{
+    auto vsyncPeriod = std::chrono::duration_cast<Clock::duration>(vsync_->getPeriod());
+    auto tolerance = vsyncPeriod / 2;
+
+    // 逐个等待 vsync，直到到达截止时间附近（目标帧率低于刷新率时跳过中间的 vsync）
+    while (true) {
+        Clock::time_point stamp;
+        if (!vsync_->waitForVsync(&stamp)) {
+            // 信号源不可用：回退为纯计时
+            SleepUntil(deadline);
+            return deadline;
+        }
+        if (stamp + tolerance >= deadline) {
+            return stamp;
+        }
+    }
+}
+
+void FrameScheduler::SleepUntil(Clock::time_point deadline)
+{
+    auto wake = deadline - kSpinTail;
+    if (Clock::now() < wake) {
+        std::this_thread::sleep_until(wake);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace glex
@@ -0,0 +1,132 @@
+#include "glex/FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace glex {
+
+namespace {
+
+float ToMs(FrameStatsRecorder::Clock::duration d)
+{
+    return std::chrono::duration<float, std::milli>(d).count();
+}
+
+PhaseStats ComputePercentiles(std::vector<float>& values)
+{
+    PhaseStats stats;
+    if (values.empty()) {
+        return stats;
+    }
+    std::sort(values.begin(), values.end());
+    auto rank = [&values](float p) {
+        size_t idx = static_cast<size_t>(std::ceil(p * static_cast<float>(values.size())));
+        return values[idx > 0 ? std::min(idx - 1, values.size() - 1) : 0];
+    };
+    stats.p50Ms = rank(0.50f);
+    stats.p90Ms = rank(0.90f);
+    stats.p99Ms = rank(0.99f);
+    stats.maxMs = values.back();
+    return stats;
+}
+
+} // namespace
+
+const char* GetFramePhaseName(FramePhase phase)
+{
+    switch (phase) {
+        case FramePhase::TaskDrain: return "taskDrain";
+        case FramePhase::PassChanges: return "passChanges";
+        case FramePhase::Update: return "update";
+        case FramePhase::Render: return "render";
+        case FramePhase::Swap: return "swap";
+        case FramePhase::GpuWait: return "gpuWait";
+        default: return "unknown";
+    }
+}
+
+void FrameStatsRecorder::beginFrame()
+{
+    frameStart_ = Clock::now();
+    for (auto& d : current_) {
+        d = Clock::duration::zero();
+    }
+}
+
+void FrameStatsRecorder::addPhase(FramePhase phase, Clock::duration duration)
+{
+    int idx = static_cast<int>(phase);
+    if (idx >= 0 && idx < kFramePhaseCount) {
+        current_[idx] += duration;
+    }
+}
+
+void FrameStatsRecorder::endFrame()
+{
+    uint64_t index = published_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index & (kCapacity - 1)];
+
+    // 单写者 seqlock：奇数表示写入中
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < kFramePhaseCount; i++) {
+        slot.valuesMs[i].store(ToMs(current_[i]), std::memory_order_relaxed);
+    }
+    slot.valuesMs[kFramePhaseCount].store(ToMs(Clock::now() - frameStart_), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    published_.store(index + 1, std::memory_order_release);
+}
+
+FrameStatsSummary FrameStatsRecorder::summarize() const
+{
+    FrameStatsSummary summary;
+    uint64_t published = published_.load(std::memory_order_acquire);
+    size_t count = static_cast<size_t>(std::min<uint64_t>(published, kCapacity));
+    if (count == 0) {
+        return summary;
+    }
+
+    std::vector<float> samples[kValueCount];
+    for (auto& v : samples) {
+        v.reserve(count);
+    }
+
+    float values[kValueCount];
+    for (size_t i = 0; i < count; i++) {
+        const Slot& slot = slots_[(published - 1 - i) & (kCapacity - 1)];
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        for (int k = 0; k < kValueCount; k++) {
+            values[k] = slot.valuesMs[k].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+        for (int k = 0; k < kValueCount; k++) {
+            samples[k].push_back(values[k]);
+        }
+    }
+
+    summary.sampleCount = static_cast<int>(samples[0].size());
+    for (int k = 0; k < kFramePhaseCount; k++) {
+        summary.phases[k] = ComputePercentiles(samples[k]);
+    }
+    summary.frame = ComputePercentiles(samples[kFramePhaseCount]);
+    return summary;
+}
+
+void FrameStatsRecorder::reset()
+{
+    for (auto& slot : slots_) {
+        slot.seq.store(0, std::memory_order_relaxed);
+    }
+    published_.store(0, std::memory_order_release);
+}
+
+} // namespace glex
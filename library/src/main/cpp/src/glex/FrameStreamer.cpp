@@ -0,0 +1,237 @@
+#include "glex/FrameStreamer.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace glex {
+
+FrameStreamer::~FrameStreamer()
+{
+    stop();
+}
+
+bool FrameStreamer::start(const StreamConfig& config, Consumer consumer)
+{
+    if (running_.load(std::memory_order_acquire) || !consumer) {
+        return false;
+    }
+    config_ = config;
+    config_.queueCapacity = std::max<size_t>(config_.queueCapacity, 1);
+    config_.readbackSlots = std::max<size_t>(config_.readbackSlots, 1);
+    consumer_ = std::move(consumer);
+    queue_.reset(new SpscRing<StreamFrame>(config_.queueCapacity));
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopRequested_ = false;
+    }
+    running_.store(true, std::memory_order_release);
+    worker_ = std::thread(&FrameStreamer::workerLoop, this);
+    GLEX_LOGI("FrameStreamer started: %{public}dx%{public}d, queue %{public}d, %{public}d PBOs",
+              config_.width, config_.height, static_cast<int>(config_.queueCapacity),
+              static_cast<int>(config_.readbackSlots));
+    return true;
+}
+
+void FrameStreamer::stop()
+{
+    if (!worker_.joinable()) {
+        return;
+    }
+    running_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopRequested_ = true;
+    }
+    wakeCv_.notify_one();
+    worker_.join();
+    consumer_ = nullptr;
+    StreamStats stats = getStats();
+    GLEX_LOGI("FrameStreamer stopped: captured=%{public}llu delivered=%{public}llu dropped=%{public}llu",
+              static_cast<unsigned long long>(stats.captured), static_cast<unsigned long long>(stats.delivered),
+              static_cast<unsigned long long>(stats.dropped()));
+}
+
+void FrameStreamer::computeOutputSize(int sourceWidth, int sourceHeight, int* width, int* height) const
+{
+    int w = config_.width;
+    int h = config_.height;
+    if (w <= 0 && h <= 0) {
+        w = sourceWidth;
+        h = sourceHeight;
+    } else if (w <= 0) {
+        w = static_cast<int>(static_cast<int64_t>(sourceWidth) * h / sourceHeight);
+    } else if (h <= 0) {
+        h = static_cast<int>(static_cast<int64_t>(sourceHeight) * w / sourceWidth);
+    }
+    *width = std::max(w, 1);
+    *height = std::max(h, 1);
+}
+
+bool FrameStreamer::ensureTarget(int width, int height)
+{
+    if (fbo_ != 0 && width == targetWidth_ && height == targetHeight_) {
+        return true;
+    }
+    if (fbo_ == 0) {
+        glGenFramebuffers(1, &fbo_);
+        glGenRenderbuffers(1, &colorRb_);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLint drawFbo = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb_);
+    GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFbo));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        GLEX_LOGE("FrameStreamer: target framebuffer incomplete, status=0x%{public}X", status);
+        return false;
+    }
+    targetWidth_ = width;
+    targetHeight_ = height;
+    return true;
+}
+
+void FrameStreamer::collect()
+{
+    std::vector<ReadbackImage> done;
+    readback_->poll(done);
+    bool pushed = false;
+    for (auto& image : done) {
+        int64_t timestamp = 0;
+        if (!inFlight_.empty() && inFlight_.front().first == image.id) {
+            timestamp = inFlight_.front().second;
+            inFlight_.pop_front();
+        }
+        if (!image.pixels) {
+            continue;
+        }
+        StreamFrame frame;
+        frame.seq = image.id;
+        frame.timestampNs = timestamp;
+        frame.width = image.width;
+        frame.height = image.height;
+        frame.pixels = std::move(image.pixels);
+        if (!queue_->tryPush(frame)) {
+            // 消费跟不上：丢弃新帧，不阻塞渲染线程
+            droppedQueueFull_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        pushed = true;
+    }
+    if (pushed) {
+        // 空的加锁 / 解锁与工作线程在锁内检查队列配对：要么它看到新帧，要么已在等待并收到通知
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+        }
+        wakeCv_.notify_one();
+    }
+}
+
+void FrameStreamer::captureFrame(int sourceWidth, int sourceHeight)
+{
+    if (!running_.load(std::memory_order_acquire) || sourceWidth <= 0 || sourceHeight <= 0) {
+        return;
+    }
+    if (!readback_) {
+        readback_.reset(new AsyncReadback(config_.readbackSlots));
+    }
+    collect();
+
+    if (!readback_->hasFreeSlot()) {
+        droppedGpuBusy_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    int width = 0;
+    int height = 0;
+    computeOutputSize(sourceWidth, sourceHeight, &width, &height);
+
+    GLint readFbo = 0;
+    GLint drawFbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFbo);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+    if (!ensureTarget(width, height)) {
+        return;
+    }
+
+    // GPU 上缩放：从当前读帧缓冲 blit 到输出尺寸的 FBO，再从该 FBO 异步读取
+    GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+    glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT,
+                      (width == sourceWidth && height == sourceHeight) ? GL_NEAREST : GL_LINEAR);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+
+    uint64_t seq = nextSeq_++;
+    if (readback_->request(seq, 0, 0, width, height)) {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        inFlight_.emplace_back(seq, now);
+        captured_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFbo));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFbo));
+    if (scissor) {
+        glEnable(GL_SCISSOR_TEST);
+    }
+}
+
+void FrameStreamer::releaseGpu()
+{
+    if (readback_) {
+        readback_->release();
+        readback_.reset();
+    }
+    inFlight_.clear();
+    if (colorRb_) {
+        glDeleteRenderbuffers(1, &colorRb_);
+        colorRb_ = 0;
+    }
+    if (fbo_) {
+        glDeleteFramebuffers(1, &fbo_);
+        fbo_ = 0;
+    }
+    targetWidth_ = 0;
+    targetHeight_ = 0;
+}
+
+void FrameStreamer::workerLoop()
+{
+    StreamFrame frame;
+    while (true) {
+        if (queue_->tryPop(frame)) {
+            bool accepted = consumer_(std::move(frame));
+            (accepted ? delivered_ : droppedByConsumer_).fetch_add(1, std::memory_order_relaxed);
+            frame = StreamFrame();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCv_.wait(lock, [this]() { return stopRequested_ || queue_->sizeApprox() > 0; });
+        if (stopRequested_) {
+            break;
+        }
+    }
+    // 停止时丢弃未消费的帧
+    while (queue_->tryPop(frame)) {
+        frame = StreamFrame();
+    }
+}
+
+StreamStats FrameStreamer::getStats() const
+{
+    StreamStats stats;
+    stats.captured = captured_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.droppedGpuBusy = droppedGpuBusy_.load(std::memory_order_relaxed);
+    stats.droppedQueueFull = droppedQueueFull_.load(std::memory_order_relaxed);
+    stats.droppedByConsumer = droppedByConsumer_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace glex
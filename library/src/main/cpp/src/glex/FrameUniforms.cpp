@@ -0,0 +1,61 @@
+#include "glex/FrameUniforms.h"
+#include "glex/GLResourceTracker.h"
+#include "glex/Log.h"
+
+namespace glex {
+
+static_assert(sizeof(FrameUniformData) == 80, "FrameUniformData must match the std140 GlexFrame block");
+
+bool FrameUniforms::BindProgram(const ShaderProgram& program)
+{
+    if (!program.isValid()) {
+        return false;
+    }
+    GLuint index = glGetUniformBlockIndex(program.getId(), kBlockName);
+    if (index == GL_INVALID_INDEX) {
+        GLEX_LOGW("FrameUniforms: program %{public}u has no %{public}s block", program.getId(), kBlockName);
+        return false;
+    }
+    glUniformBlockBinding(program.getId(), index, kBinding);
+    return true;
+}
+
+bool FrameUniforms::initialize()
+{
+    if (ubo_) {
+        return true;
+    }
+    glGenBuffers(1, &ubo_);
+    if (!ubo_) {
+        GLEX_LOGE("FrameUniforms: glGenBuffers failed");
+        return false;
+    }
+    GLResourceTracker::Get().OnCreateBuffer();
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return true;
+}
+
+void FrameUniforms::upload(const FrameUniformData& data)
+{
+    if (!ubo_) {
+        return;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+    // 整块重新指定存储：上一帧仍在读取旧内容时驱动可另分配，不必等待
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), &data, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, kBinding, ubo_);
+}
+
+void FrameUniforms::release()
+{
+    if (ubo_) {
+        GLResourceTracker::Get().OnDeleteBuffer();
+        glDeleteBuffers(1, &ubo_);
+        ubo_ = 0;
+    }
+}
+
+} // namespace glex
@@ -1,7 +1,12 @@
 #include "glex/GLContext.h"
+#include "glex/EGLDisplayRegistry.h"
 #include "glex/Log.h"
+#include "glex/ShareGroup.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 
 namespace glex {
 
@@ -34,25 +39,22 @@ bool GLContext::initialize(EGLNativeWindowType window, const GLContextConfig& co
 
     GLEX_LOGI("GLContext::initialize window=%{public}p", window);
 
-    // 1. 获取 EGL Display
-    display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    if (display_ == EGL_NO_DISPLAY) {
-        GLEX_LOGE("Failed to get EGL display, error=0x%{public}X", eglGetError());
-        return false;
-    }
-
-    // 2. 初始化 EGL
-    EGLint major = 0;
-    EGLint minor = 0;
-    if (!eglInitialize(display_, &major, &minor)) {
-        GLEX_LOGE("Failed to initialize EGL, error=0x%{public}X", eglGetError());
-        return false;
-    }
-    GLEX_LOGI("EGL version: %{public}d.%{public}d", major, minor);
-
-    // 3. 选择 EGL 配置
-    if (!chooseConfig(config)) {
-        return false;
+    if (config.shareGroup) {
+        // 1-3. 共享组：沿用组内 Display
+        if (!useShareGroup(config, EGL_WINDOW_BIT)) {
+            destroy();
+            return false;
+        }
+    } else {
+        // 1-2. 获取并初始化 EGL Display
+        if (!openDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY))) {
+            return false;
+        }
+
+        // 3. 选择 EGL 配置
+        if (!chooseConfig(config, EGL_WINDOW_BIT)) {
+            return false;
+        }
     }
 
     // 4. 创建窗口 Surface
@@ -65,27 +67,7 @@ bool GLContext::initialize(EGLNativeWindowType window, const GLContextConfig& co
     eglBindAPI(EGL_OPENGL_ES_API);
 
     // 5. 创建 EGL 上下文（ES 3.2 → 3.0 → 2.0 逐级回退）
-    EGLint contextAttribs32[] = {
-        EGL_CONTEXT_MAJOR_VERSION, 3,
-        EGL_CONTEXT_MINOR_VERSION, 2,
-        EGL_NONE
-    };
-    context_ = eglCreateContext(display_, eglConfig_, EGL_NO_CONTEXT, contextAttribs32);
-
-    if (context_ == EGL_NO_CONTEXT) {
-        GLEX_LOGW("ES 3.2 unavailable (0x%{public}X), trying 3.0", eglGetError());
-        EGLint contextAttribs30[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
-        context_ = eglCreateContext(display_, eglConfig_, EGL_NO_CONTEXT, contextAttribs30);
-    }
-
-    if (context_ == EGL_NO_CONTEXT) {
-        GLEX_LOGW("ES 3.0 unavailable (0x%{public}X), trying 2.0", eglGetError());
-        EGLint contextAttribs20[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
-        context_ = eglCreateContext(display_, eglConfig_, EGL_NO_CONTEXT, contextAttribs20);
-    }
-
-    if (context_ == EGL_NO_CONTEXT) {
-        GLEX_LOGE("Failed to create any EGL context, error=0x%{public}X", eglGetError());
+    if (!createContext()) {
         return false;
     }
 
@@ -106,30 +88,135 @@ bool GLContext::initialize(EGLNativeWindowType window, const GLContextConfig& co
     height_.store(height, std::memory_order_relaxed);
 
     // 8. 设置 VSync
-    eglSwapInterval(display_, config.vsyncEnabled ? 1 : 0);
+    vsyncEnabled_ = config.vsyncEnabled;
+    eglSwapInterval(display_, vsyncEnabled_ ? 1 : 0);
 
     GLEX_LOGI("GL initialized: surface %{public}dx%{public}d", width, height);
-    const char* vendorStr = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
-    const char* rendererStr = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
-    const char* versionStr = reinterpret_cast<const char*>(glGetString(GL_VERSION));
-    glRendererStr_ = rendererStr ? rendererStr : "unknown";
-    glVersionStr_ = versionStr ? versionStr : "unknown";
-    const char* vendorSafe = vendorStr ? vendorStr : "unknown";
-    GLEX_LOGI("GL_VENDOR:   %{public}s", vendorSafe);
-    GLEX_LOGI("GL_RENDERER: %{public}s", glRendererStr_.c_str());
-    GLEX_LOGI("GL_VERSION:  %{public}s", glVersionStr_.c_str());
-    ParseGLESVersion(glVersionStr_.c_str(), &glMajor_, &glMinor_);
+    queryGLInfo();
+    queryPresentExtensions();
 
     initialized_ = true;
     return true;
 }
 
+bool GLContext::initializeOffscreen(int width, int height, const GLContextConfig& config)
+{
+    if (initialized_) {
+        GLEX_LOGW("GLContext already initialized");
+        return true;
+    }
+    if (width <= 0 || height <= 0) {
+        GLEX_LOGE("GLContext::initializeOffscreen invalid size %{public}dx%{public}d", width, height);
+        return false;
+    }
+
+    GLEX_LOGI("GLContext::initializeOffscreen %{public}dx%{public}d", width, height);
+    offscreen_ = true;
+
+    // 共享组：与根上下文使用相同的 Display 和 surface 类型
+    bool ready = false;
+    if (config.shareGroup) {
+        bool surfaceless = config.shareGroup->isSurfaceless();
+        if (!useShareGroup(config, surfaceless ? 0 : EGL_PBUFFER_BIT)) {
+            destroy();
+            return false;
+        }
+        if (surfaceless) {
+            ready = true;
+        } else {
+            const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            surface_ = eglCreatePbufferSurface(display_, eglConfig_, pbufferAttribs);
+            ready = surface_ != EGL_NO_SURFACE;
+        }
+        if (!ready) {
+            GLEX_LOGE("Offscreen: failed to create surface in share group, error=0x%{public}X", eglGetError());
+            destroy();
+            return false;
+        }
+    }
+
+    // 优先默认 Display + 1x1 pbuffer（真实渲染目标是 FBO）
+    if (!ready && openDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY)) && chooseConfig(config, EGL_PBUFFER_BIT)) {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        surface_ = eglCreatePbufferSurface(display_, eglConfig_, pbufferAttribs);
+        if (surface_ != EGL_NO_SURFACE) {
+            ready = true;
+            GLEX_LOGI("Offscreen: using pbuffer surface");
+        } else {
+            GLEX_LOGW("Failed to create pbuffer, error=0x%{public}X", eglGetError());
+        }
+    }
+
+    // 回退：无窗口系统时使用 surfaceless 平台（EGL_MESA_platform_surfaceless + EGL_KHR_surfaceless_context）
+    if (!ready) {
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+        if (display_ != EGL_NO_DISPLAY) {
+            EGLDisplayRegistry::Get().release(display_);
+            display_ = EGL_NO_DISPLAY;
+        }
+        const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (clientExts && std::strstr(clientExts, "EGL_MESA_platform_surfaceless") && getPlatformDisplay &&
+            openDisplay(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr))) {
+            const char* exts = eglQueryString(display_, EGL_EXTENSIONS);
+            if (exts && std::strstr(exts, "EGL_KHR_surfaceless_context") && chooseConfig(config, 0)) {
+                ready = true;
+                GLEX_LOGI("Offscreen: using surfaceless context");
+            }
+        }
+    }
+
+    if (!ready) {
+        GLEX_LOGE("Offscreen: no pbuffer or surfaceless EGL available");
+        destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+    if (!createContext()) {
+        destroy();
+        return false;
+    }
+    if (!makeCurrent()) {
+        GLEX_LOGE("Failed to make context current, error=0x%{public}X", eglGetError());
+        destroy();
+        return false;
+    }
+
+    queryGLInfo();
+    if (glMajor_ < 3) {
+        GLEX_LOGE("Offscreen: requires OpenGL ES 3.0+, got %{public}d.%{public}d", glMajor_, glMinor_);
+        destroy();
+        return false;
+    }
+    if (!createOffscreenTarget(width, height, config)) {
+        destroy();
+        return false;
+    }
+
+    GLEX_LOGI("GL initialized: offscreen %{public}dx%{public}d", width, height);
+    initialized_ = true;
+    return true;
+}
+
 void GLContext::destroy()
 {
-    if (!initialized_) {
+    // 初始化中途失败时也需释放已创建的部分
+    if (!initialized_ && display_ == EGL_NO_DISPLAY) {
         return;
     }
 
+    // 栅栏属于上下文：能绑定时逐个删除，否则随上下文一起释放
+    if (!frameFences_.empty() && makeCurrent()) {
+        for (GLsync fence : frameFences_) {
+            glDeleteSync(fence);
+        }
+    }
+    frameFences_.clear();
+    destroyOffscreenTarget();
     clearCurrent();
 
     if (context_ != EGL_NO_CONTEXT) {
@@ -142,10 +229,12 @@ void GLContext::destroy()
         surface_ = EGL_NO_SURFACE;
     }
 
+    // Display 是进程级对象，其他实例可能仍在使用：只释放引用，不 eglTerminate
     if (display_ != EGL_NO_DISPLAY) {
-        eglTerminate(display_);
+        EGLDisplayRegistry::Get().release(display_);
         display_ = EGL_NO_DISPLAY;
     }
+    shareGroup_.reset();
 
     width_.store(0, std::memory_order_relaxed);
     height_.store(0, std::memory_order_relaxed);
@@ -153,16 +242,33 @@ void GLContext::destroy()
     glMinor_ = 0;
     glVersionStr_ = "unknown";
     glRendererStr_ = "unknown";
+    offscreen_ = false;
+    vsyncEnabled_ = true;
+    bufferAgeSupported_ = false;
+    swapWithDamage_ = nullptr;
+    setDamageRegion_ = nullptr;
+    framePartial_ = false;
+    frameDamage_.clear();
+    damageHistory_.clear();
+    historyWidth_ = 0;
+    historyHeight_ = 0;
     initialized_ = false;
     GLEX_LOGI("GLContext destroyed");
 }
 
 bool GLContext::makeCurrent()
 {
-    if (display_ == EGL_NO_DISPLAY || surface_ == EGL_NO_SURFACE || context_ == EGL_NO_CONTEXT) {
+    // surfaceless 离屏上下文没有 surface
+    if (display_ == EGL_NO_DISPLAY || context_ == EGL_NO_CONTEXT || (surface_ == EGL_NO_SURFACE && !offscreen_)) {
+        return false;
+    }
+    if (eglMakeCurrent(display_, surface_, surface_, context_) != EGL_TRUE) {
         return false;
     }
-    return eglMakeCurrent(display_, surface_, surface_, context_) == EGL_TRUE;
+    if (fbo_ != 0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    }
+    return true;
 }
 
 void GLContext::clearCurrent()
@@ -172,17 +278,274 @@ void GLContext::clearCurrent()
     }
 }
 
+void GLContext::setMaxFramesInFlight(int frames)
+{
+    int clamped = std::min(std::max(frames, 0), kMaxFramesInFlightLimit);
+    if (maxFramesInFlight_.exchange(clamped, std::memory_order_relaxed) != clamped) {
+        GLEX_LOGI("GLContext: max frames in flight %{public}d", clamped);
+    }
+}
+
+int64_t GLContext::waitForFrameSlot()
+{
+    int limit = maxFramesInFlight_.load(std::memory_order_relaxed);
+    size_t keep = limit > 0 ? static_cast<size_t>(limit - 1) : 0;
+    if (frameFences_.size() <= keep) {
+        return 0;
+    }
+
+    // 上限为 N 时本帧开始前最多保留 N - 1 帧在途；关闭上限时不等待，直接丢弃栅栏
+    auto start = std::chrono::steady_clock::now();
+    bool blocked = false;
+    while (frameFences_.size() > keep) {
+        GLsync fence = frameFences_.front();
+        frameFences_.pop_front();
+        if (limit > 0) {
+            GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                blocked = true;
+                status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs);
+            }
+            if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+                GLEX_LOGW("GLContext: frame fence wait %{public}s", status == GL_WAIT_FAILED ? "failed" : "timed out");
+            }
+        }
+        glDeleteSync(fence);
+    }
+    if (!blocked) {
+        return 0;
+    }
+    int64_t waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    gpuWaitNs_.fetch_add(static_cast<uint64_t>(waited), std::memory_order_relaxed);
+    gpuWaitFrames_.fetch_add(1, std::memory_order_relaxed);
+    return waited;
+}
+
+bool GLContext::pollFrameSlot()
+{
+    int limit = maxFramesInFlight_.load(std::memory_order_relaxed);
+    if (limit <= 0) {
+        return true;
+    }
+    size_t keep = static_cast<size_t>(limit - 1);
+    while (frameFences_.size() > keep) {
+        GLsync fence = frameFences_.front();
+        GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+        if (status == GL_WAIT_FAILED) {
+            GLEX_LOGW("GLContext: frame fence poll failed");
+        }
+        frameFences_.pop_front();
+        glDeleteSync(fence);
+    }
+    return true;
+}
+
 bool GLContext::swapBuffers()
 {
     if (!initialized_) {
         return false;
     }
-    return eglSwapBuffers(display_, surface_) == EGL_TRUE;
+    if (maxFramesInFlight_.load(std::memory_order_relaxed) > 0) {
+        // 交换前插入：栅栏在本帧全部绘制命令完成后触发
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        if (fence) {
+            frameFences_.push_back(fence);
+        }
+    }
+    if (offscreen_) {
+        // 没有可呈现的窗口：提交命令即可
+        glFlush();
+        return true;
+    }
+
+    bool partial = framePartial_;
+    framePartial_ = false;
+    if (partial && frameDamage_.empty()) {
+        // 画面无变化：不交换，后缓冲保持不变，历史也无需记录
+        skippedSwaps_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    EGLBoolean ok = EGL_FALSE;
+    if (partial && swapWithDamage_) {
+        swapRects_.clear();
+        for (const auto& rect : frameDamage_) {
+            swapRects_.insert(swapRects_.end(), { rect.x, rect.y, rect.width, rect.height });
+        }
+        ok = swapWithDamage_(display_, surface_, swapRects_.data(), static_cast<EGLint>(frameDamage_.size()));
+    } else {
+        ok = eglSwapBuffers(display_, surface_);
+    }
+    if (partial) {
+        partialFrames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    DamageRect presented = partial ? BoundingDamage(frameDamage_) : DamageRect{ 0, 0, getWidth(), getHeight() };
+    damageHistory_.push_front(presented);
+    if (damageHistory_.size() > kMaxDamageHistory) {
+        damageHistory_.pop_back();
+    }
+    return ok == EGL_TRUE;
+}
+
+bool GLContext::beginFrame(const std::vector<DamageRect>* damage, DamageRect* repaint)
+{
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+    framePartial_ = false;
+    frameDamage_.clear();
+    int width = getWidth();
+    int height = getHeight();
+    if (repaint) {
+        *repaint = { 0, 0, width, height };
+    }
+    if (!initialized_ || offscreen_ || surface_ == EGL_NO_SURFACE) {
+        return false;
+    }
+    // 尺寸变化后历史帧的内容不再可用
+    if (width != historyWidth_ || height != historyHeight_) {
+        damageHistory_.clear();
+        historyWidth_ = width;
+        historyHeight_ = height;
+    }
+    if (!damage) {
+        return false;
+    }
+
+    frameDamage_ = *damage;
+    framePartial_ = true;
+    if (frameDamage_.empty()) {
+        if (repaint) {
+            *repaint = {};
+        }
+        return true;
+    }
+
+    // 后缓冲是 age 帧之前呈现的内容：需要补画其后各帧的损坏
+    EGLint age = 0;
+    if (bufferAgeSupported_) {
+        eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age);
+    }
+    if (age <= 0 || static_cast<size_t>(age) - 1 > damageHistory_.size()) {
+        return false;
+    }
+    DamageRect bounds = BoundingDamage(frameDamage_);
+    for (EGLint i = 0; i < age - 1; i++) {
+        bounds = UnionDamage(bounds, damageHistory_[static_cast<size_t>(i)]);
+    }
+    bounds = ClipDamage(bounds, width, height);
+
+    if (setDamageRegion_) {
+        EGLint rect[4] = { bounds.x, bounds.y, bounds.width, bounds.height };
+        setDamageRegion_(display_, surface_, rect, 1);
+    }
+    if (repaint) {
+        *repaint = bounds;
+    }
+    return true;
+}
+
+bool GLContext::replaceSurface(EGLNativeWindowType window)
+{
+    if (!initialized_ || offscreen_) {
+        return false;
+    }
+
+    EGLSurface surface = eglCreateWindowSurface(display_, eglConfig_, window, nullptr);
+    if (surface == EGL_NO_SURFACE) {
+        GLEX_LOGW("replaceSurface: create surface failed, error=0x%{public}X", eglGetError());
+        return false;
+    }
+
+    bool wasCurrent = eglGetCurrentContext() == context_;
+    if (eglMakeCurrent(display_, surface, surface, context_) != EGL_TRUE) {
+        GLEX_LOGW("replaceSurface: make current failed, error=0x%{public}X", eglGetError());
+        eglDestroySurface(display_, surface);
+        return false;
+    }
+    if (surface_ != EGL_NO_SURFACE) {
+        eglDestroySurface(display_, surface_);
+    }
+    surface_ = surface;
+
+    EGLint eglWidth = 0;
+    EGLint eglHeight = 0;
+    eglQuerySurface(display_, surface_, EGL_WIDTH, &eglWidth);
+    eglQuerySurface(display_, surface_, EGL_HEIGHT, &eglHeight);
+    setSurfaceSize(static_cast<int>(eglWidth), static_cast<int>(eglHeight));
+    // 交换间隔作用于当前绑定的 Surface，需重新设置
+    eglSwapInterval(display_, vsyncEnabled_ ? 1 : 0);
+    damageHistory_.clear();
+    framePartial_ = false;
+
+    if (!wasCurrent) {
+        clearCurrent();
+    }
+    GLEX_LOGI("Surface replaced: %{public}dx%{public}d", getWidth(), getHeight());
+    return true;
+}
+
+void GLContext::releaseSurface()
+{
+    if (offscreen_ || surface_ == EGL_NO_SURFACE) {
+        return;
+    }
+    if (eglGetCurrentContext() == context_) {
+        clearCurrent();
+    }
+    eglDestroySurface(display_, surface_);
+    surface_ = EGL_NO_SURFACE;
+    damageHistory_.clear();
+    framePartial_ = false;
+    GLEX_LOGI("Surface released, context kept");
+}
+
+bool GLContext::resizeOffscreen(int width, int height)
+{
+    if (!offscreen_ || fbo_ == 0 || width <= 0 || height <= 0) {
+        return false;
+    }
+    if (width == getWidth() && height == getHeight()) {
+        return true;
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    if (depthRb_ != 0) {
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRb_);
+        glRenderbufferStorage(GL_RENDERBUFFER, depthFormat_, width, height);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    setSurfaceSize(width, height);
+    GLEX_LOGI("Offscreen resized: %{public}dx%{public}d", width, height);
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+bool GLContext::readPixels(std::vector<uint8_t>& rgba)
+{
+    if (!initialized_) {
+        return false;
+    }
+    int width = getWidth();
+    int height = getHeight();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    rgba.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    return glGetError() == GL_NO_ERROR;
 }
 
 void GLContext::setVSyncEnabled(bool enabled)
 {
-    if (initialized_) {
+    vsyncEnabled_ = enabled;
+    if (initialized_ && !offscreen_ && surface_ != EGL_NO_SURFACE) {
         eglSwapInterval(display_, enabled ? 1 : 0);
     }
 }
@@ -197,7 +560,151 @@ const char* GLContext::getGLRenderer() const
     return glRendererStr_.c_str();
 }
 
-bool GLContext::chooseConfig(const GLContextConfig& config)
+bool GLContext::openDisplay(EGLDisplay display)
+{
+    if (display == EGL_NO_DISPLAY) {
+        GLEX_LOGE("Failed to get EGL display, error=0x%{public}X", eglGetError());
+        return false;
+    }
+    // 首次使用时 eglInitialize，之后复用已初始化的 Display
+    if (!EGLDisplayRegistry::Get().acquire(display)) {
+        return false;
+    }
+    display_ = display;
+    return true;
+}
+
+bool GLContext::useShareGroup(const GLContextConfig& config, EGLint surfaceType)
+{
+    shareGroup_ = config.shareGroup;
+    if (!openDisplay(shareGroup_->getDisplay())) {
+        GLEX_LOGE("Share group has no usable EGL display");
+        return false;
+    }
+    return chooseConfig(config, surfaceType);
+}
+
+bool GLContext::createContext()
+{
+    EGLContext shareContext = shareGroup_ ? shareGroup_->getRootContext() : EGL_NO_CONTEXT;
+    EGLint contextAttribs32[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 2,
+        EGL_NONE
+    };
+    context_ = eglCreateContext(display_, eglConfig_, shareContext, contextAttribs32);
+
+    if (context_ == EGL_NO_CONTEXT) {
+        GLEX_LOGW("ES 3.2 unavailable (0x%{public}X), trying 3.0", eglGetError());
+        EGLint contextAttribs30[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+        context_ = eglCreateContext(display_, eglConfig_, shareContext, contextAttribs30);
+    }
+
+    if (context_ == EGL_NO_CONTEXT) {
+        GLEX_LOGW("ES 3.0 unavailable (0x%{public}X), trying 2.0", eglGetError());
+        EGLint contextAttribs20[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+        context_ = eglCreateContext(display_, eglConfig_, shareContext, contextAttribs20);
+    }
+
+    if (context_ == EGL_NO_CONTEXT) {
+        GLEX_LOGE("Failed to create any EGL context, error=0x%{public}X", eglGetError());
+        return false;
+    }
+    return true;
+}
+
+void GLContext::queryGLInfo()
+{
+    const char* vendorStr = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+    const char* rendererStr = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    const char* versionStr = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    glRendererStr_ = rendererStr ? rendererStr : "unknown";
+    glVersionStr_ = versionStr ? versionStr : "unknown";
+    const char* vendorSafe = vendorStr ? vendorStr : "unknown";
+    GLEX_LOGI("GL_VENDOR:   %{public}s", vendorSafe);
+    GLEX_LOGI("GL_RENDERER: %{public}s", glRendererStr_.c_str());
+    GLEX_LOGI("GL_VERSION:  %{public}s", glVersionStr_.c_str());
+    ParseGLESVersion(glVersionStr_.c_str(), &glMajor_, &glMinor_);
+}
+
+void GLContext::queryPresentExtensions()
+{
+    const char* exts = eglQueryString(display_, EGL_EXTENSIONS);
+    auto has = [exts](const char* name) {
+        return exts && std::strstr(exts, name) != nullptr;
+    };
+    bufferAgeSupported_ = has("EGL_EXT_buffer_age") || has("EGL_KHR_partial_update");
+    if (has("EGL_KHR_swap_buffers_with_damage")) {
+        swapWithDamage_ = reinterpret_cast<SwapWithDamageProc>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+    } else if (has("EGL_EXT_swap_buffers_with_damage")) {
+        swapWithDamage_ = reinterpret_cast<SwapWithDamageProc>(eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+    }
+    if (has("EGL_KHR_partial_update")) {
+        setDamageRegion_ = reinterpret_cast<SetDamageRegionProc>(eglGetProcAddress("eglSetDamageRegionKHR"));
+    }
+    GLEX_LOGI("Present extensions: buffer_age=%{public}d swap_with_damage=%{public}d partial_update=%{public}d",
+              bufferAgeSupported_ ? 1 : 0, swapWithDamage_ ? 1 : 0, setDamageRegion_ ? 1 : 0);
+}
+
+bool GLContext::createOffscreenTarget(int width, int height, const GLContextConfig& config)
+{
+    glGenRenderbuffers(1, &colorRb_);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    if (config.depthSize > 0 || config.stencilSize > 0) {
+        depthFormat_ = config.stencilSize > 0 ? GL_DEPTH24_STENCIL8
+                       : (config.depthSize > 16 ? GL_DEPTH_COMPONENT24 : GL_DEPTH_COMPONENT16);
+        glGenRenderbuffers(1, &depthRb_);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRb_);
+        glRenderbufferStorage(GL_RENDERBUFFER, depthFormat_, width, height);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb_);
+    if (depthRb_ != 0) {
+        GLenum attachment = depthFormat_ == GL_DEPTH24_STENCIL8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, depthRb_);
+    }
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        GLEX_LOGE("Offscreen framebuffer incomplete, status=0x%{public}X", status);
+        return false;
+    }
+
+    glViewport(0, 0, width, height);
+    setSurfaceSize(width, height);
+    return true;
+}
+
+void GLContext::destroyOffscreenTarget()
+{
+    if (fbo_ == 0 && colorRb_ == 0 && depthRb_ == 0) {
+        return;
+    }
+    // GL 对象需在上下文绑定时删除；绑定失败时随上下文一起释放
+    if (makeCurrent()) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (fbo_ != 0) {
+            glDeleteFramebuffers(1, &fbo_);
+        }
+        if (colorRb_ != 0) {
+            glDeleteRenderbuffers(1, &colorRb_);
+        }
+        if (depthRb_ != 0) {
+            glDeleteRenderbuffers(1, &depthRb_);
+        }
+    }
+    fbo_ = 0;
+    colorRb_ = 0;
+    depthRb_ = 0;
+    depthFormat_ = 0;
+}
+
+bool GLContext::chooseConfig(const GLContextConfig& config, EGLint surfaceType)
 {
 #ifndef EGL_OPENGL_ES3_BIT
 #define EGL_OPENGL_ES3_BIT 0x00000040
@@ -208,7 +715,7 @@ bool GLContext::chooseConfig(const GLContextConfig& config)
 
     // 优先 ES3 配置
     const EGLint es3Attribs[] = {
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_SURFACE_TYPE, surfaceType,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
         EGL_RED_SIZE, config.redSize,
         EGL_GREEN_SIZE, config.greenSize,
@@ -219,8 +726,9 @@ bool GLContext::chooseConfig(const GLContextConfig& config)
         EGL_NONE
     };
 
-    EGLint numConfigs = 0;
-    if (eglChooseConfig(display_, es3Attribs, &eglConfig_, 1, &numConfigs) && numConfigs > 0) {
+    // 结果按属性缓存，重建 Surface 时不再重复 eglChooseConfig
+    EGLDisplayRegistry& registry = EGLDisplayRegistry::Get();
+    if (registry.chooseConfig(display_, es3Attribs, &eglConfig_)) {
         GLEX_LOGI("Using ES3 EGL config");
         return true;
     }
@@ -229,7 +737,7 @@ bool GLContext::chooseConfig(const GLContextConfig& config)
 
     // 回退 ES2
     const EGLint es2Attribs[] = {
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_SURFACE_TYPE, surfaceType,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
         EGL_RED_SIZE, config.redSize,
         EGL_GREEN_SIZE, config.greenSize,
@@ -240,7 +748,7 @@ bool GLContext::chooseConfig(const GLContextConfig& config)
         EGL_NONE
     };
 
-    if (eglChooseConfig(display_, es2Attribs, &eglConfig_, 1, &numConfigs) && numConfigs > 0) {
+    if (registry.chooseConfig(display_, es2Attribs, &eglConfig_)) {
         GLEX_LOGI("Using ES2 fallback config");
         return true;
     }
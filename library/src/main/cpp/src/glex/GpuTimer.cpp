@@ -0,0 +1,203 @@
+#include "glex/GpuTimer.h"
+#include "glex/Log.h"
+
+#include <EGL/egl.h>
+
+#include <cstring>
+#include <mutex>
+
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+namespace glex {
+
+namespace {
+
+using GetQueryObjectui64vProc = void (*)(GLuint, GLenum, GLuint64*);
+
+// 函数地址与上下文无关，进程内只解析一次（多个引擎可能在不同线程上同时初始化）
+GetQueryObjectui64vProc GetQueryObjectui64v()
+{
+    static std::once_flag once;
+    static GetQueryObjectui64vProc proc = nullptr;
+    std::call_once(once, []() {
+        proc = reinterpret_cast<GetQueryObjectui64vProc>(eglGetProcAddress("glGetQueryObjectui64vEXT"));
+    });
+    return proc;
+}
+
+} // namespace
+
+bool GpuTimer::isSupported()
+{
+    if (supported_ < 0) {
+        const char* exts = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        bool hasExtension = exts && std::strstr(exts, "GL_EXT_disjoint_timer_query");
+        supported_ = hasExtension && GetQueryObjectui64v() ? 1 : 0;
+        GLEX_LOGI("GpuTimer: GPU timing %{public}s", supported_ ? "available" : "unavailable");
+        // 清除残留的 disjoint 状态
+        GLint disjoint = 0;
+        if (supported_) {
+            glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        }
+    }
+    return supported_ == 1;
+}
+
+void GpuTimer::startQuery()
+{
+    GLuint query = 0;
+    if (!freeQueries_.empty()) {
+        query = freeQueries_.back();
+        freeQueries_.pop_back();
+    } else {
+        glGenQueries(1, &query);
+    }
+    glBeginQuery(GL_TIME_ELAPSED_EXT, query);
+    activeQuery_ = query;
+}
+
+void GpuTimer::finishQuery(uint64_t tag, bool tagged, bool last)
+{
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    Pending pending;
+    pending.query = activeQuery_;
+    pending.frame = frameActive_ ? activeFrame_ : kNoFrame;
+    pending.tag = tag;
+    pending.tagged = tagged;
+    pending.last = last;
+    pending_.push_back(pending);
+    activeQuery_ = 0;
+}
+
+bool GpuTimer::beginFrame(uint64_t frame)
+{
+    if (activeQuery_ != 0 || !isSupported() || pending_.size() >= maxPending_) {
+        return false;
+    }
+    activeFrame_ = frame;
+    frameActive_ = true;
+    startQuery();
+    return true;
+}
+
+void GpuTimer::endFrame()
+{
+    if (!frameActive_) {
+        return;
+    }
+    // 未配对的标记段按未标记处理
+    finishQuery(0, false, true);
+    segmentActive_ = false;
+    frameActive_ = false;
+}
+
+bool GpuTimer::beginSegment()
+{
+    if (segmentActive_) {
+        return false;
+    }
+    if (frameActive_) {
+        // 帧内：结束前一个未标记段，段之间首尾相接
+        finishQuery(0, false, false);
+    } else if (activeQuery_ != 0 || !isSupported() || pending_.size() >= maxPending_) {
+        return false;
+    }
+    startQuery();
+    segmentActive_ = true;
+    return true;
+}
+
+void GpuTimer::endSegment(uint64_t tag)
+{
+    if (!segmentActive_) {
+        return;
+    }
+    finishQuery(tag, true, false);
+    segmentActive_ = false;
+    if (frameActive_) {
+        startQuery();
+    }
+}
+
+void GpuTimer::collect()
+{
+    if (pending_.empty()) {
+        return;
+    }
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint) {
+        discardPending();
+    }
+
+    // 查询按提交顺序完成：遇到未就绪的即停止
+    while (!pending_.empty()) {
+        const Pending& pending = pending_.front();
+        GLuint available = 0;
+        glGetQueryObjectuiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        GLuint64 elapsed = 0;
+        GetQueryObjectui64v()(pending.query, GL_QUERY_RESULT, &elapsed);
+        int64_t ns = static_cast<int64_t>(elapsed);
+        if (pending.tagged && !pending.discard && segmentSink_) {
+            segmentSink_(pending.tag, ns);
+        }
+        if (pending.frame != kNoFrame) {
+            accumulating_ = true;
+            frameSumNs_ += ns;
+            frameDiscarded_ = frameDiscarded_ || pending.discard;
+            if (pending.last) {
+                if (!frameDiscarded_ && frameSink_) {
+                    frameSink_(pending.frame, frameSumNs_);
+                }
+                accumulating_ = false;
+                frameDiscarded_ = false;
+                frameSumNs_ = 0;
+            }
+        }
+        freeQueries_.push_back(pending.query);
+        pending_.pop_front();
+    }
+}
+
+void GpuTimer::discardPending()
+{
+    for (auto& pending : pending_) {
+        pending.discard = true;
+    }
+    // 已累加了一部分的帧同样不完整
+    frameDiscarded_ = frameDiscarded_ || accumulating_;
+}
+
+void GpuTimer::release()
+{
+    if (activeQuery_ != 0) {
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+        freeQueries_.push_back(activeQuery_);
+        activeQuery_ = 0;
+    }
+    for (const auto& pending : pending_) {
+        freeQueries_.push_back(pending.query);
+    }
+    pending_.clear();
+    if (!freeQueries_.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(freeQueries_.size()), freeQueries_.data());
+        freeQueries_.clear();
+    }
+    frameActive_ = false;
+    segmentActive_ = false;
+    accumulating_ = false;
+    frameDiscarded_ = false;
+    frameSumNs_ = 0;
+    // 下一个上下文重新检测扩展
+    supported_ = -1;
+}
+
+} // namespace glex
@@ -0,0 +1,283 @@
+#include "glex/JobSystem.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+
+namespace glex {
+
+namespace {
+
+// 当前线程所属的工作线程下标（非工作线程为 -1）
+thread_local int t_workerIndex = -1;
+
+// wait 无任务可帮时先让出这么多次再挂起：目标任务通常很快完成，挂起 / 唤醒的开销更大
+constexpr int kWaitSpins = 32;
+
+} // namespace
+
+JobSystem& JobSystem::Get()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem()
+{
+    unsigned int hw = std::thread::hardware_concurrency();
+    size_t workerCount = hw > 1 ? static_cast<size_t>(hw - 1) : 0;
+
+    size_t queueCount = std::max<size_t>(workerCount, 1);
+    queues_.reserve(queueCount);
+    for (size_t i = 0; i < queueCount; i++) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+    GLEX_LOGI("JobSystem started with %{public}d workers", static_cast<int>(workerCount));
+}
+
+JobSystem::~JobSystem()
+{
+    stopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCv_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+JobHandle JobSystem::submit(Task fn, std::initializer_list<JobHandle> deps)
+{
+    return submit(std::move(fn), std::vector<JobHandle>(deps));
+}
+
+JobHandle JobSystem::submit(Task fn, const std::vector<JobHandle>& deps)
+{
+    auto job = std::make_shared<detail::JobState>();
+    job->fn = std::move(fn);
+    // 额外的 1 作为注册依赖期间的保护，避免依赖在注册过程中完成导致提前调度
+    job->remainingDeps.store(1, std::memory_order_relaxed);
+
+    for (const JobHandle& dep : deps) {
+        if (!dep.state_) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dep.state_->mutex);
+        if (!dep.state_->done.load(std::memory_order_acquire)) {
+            job->remainingDeps.fetch_add(1, std::memory_order_relaxed);
+            dep.state_->dependents.push_back(job);
+        }
+    }
+
+    if (job->remainingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(job);
+    }
+    return JobHandle(job);
+}
+
+void JobSystem::schedule(std::shared_ptr<detail::JobState> job)
+{
+    size_t index = t_workerIndex >= 0
+        ? static_cast<size_t>(t_workerIndex)
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+    // seq_cst：与 workerLoop 中 sleepers_/queued_ 的顺序配对，避免丢失唤醒
+    queued_.fetch_add(1);
+
+    if (sleepers_.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        sleepCv_.notify_one();
+    }
+    // 挂起的等待者也可以帮忙执行（任务内嵌套 wait 时所有工作线程都可能在等待）
+    wakeWaiters();
+}
+
+void JobSystem::wakeWaiters()
+{
+    // 与 wait() 中的 fence 配对：要么等待者看到新状态，要么这里看到 waiters_
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+        }
+        waitCv_.notify_all();
+    }
+}
+
+std::shared_ptr<detail::JobState> JobSystem::popLocal(size_t index)
+{
+    WorkerQueue& q = *queues_[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.jobs.empty()) {
+        return nullptr;
+    }
+    auto job = std::move(q.jobs.back());
+    q.jobs.pop_back();
+    return job;
+}
+
+std::shared_ptr<detail::JobState> JobSystem::steal(size_t thief)
+{
+    size_t count = queues_.size();
+    for (size_t i = 1; i <= count; i++) {
+        WorkerQueue& q = *queues_[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.jobs.empty()) {
+            auto job = std::move(q.jobs.front());
+            q.jobs.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::tryRunOne(size_t preferredQueue)
+{
+    if (queued_.load(std::memory_order_acquire) <= 0) {
+        return false;
+    }
+    auto job = popLocal(preferredQueue);
+    if (!job) {
+        job = steal(preferredQueue);
+    }
+    if (!job) {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const std::shared_ptr<detail::JobState>& job)
+{
+    job->fn();
+    job->fn.reset();
+
+    std::vector<std::shared_ptr<detail::JobState>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done.store(true, std::memory_order_release);
+        dependents.swap(job->dependents);
+    }
+    for (auto& dependent : dependents) {
+        if (dependent->remainingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            schedule(std::move(dependent));
+        }
+    }
+    wakeWaiters();
+}
+
+void JobSystem::workerLoop(size_t index)
+{
+    t_workerIndex = static_cast<int>(index);
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        if (tryRunOne(index)) {
+            continue;
+        }
+        sleepers_.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCv_.wait(lock, [this]() {
+                return stopping_.load(std::memory_order_relaxed) || queued_.load() > 0;
+            });
+        }
+        sleepers_.fetch_sub(1);
+    }
+}
+
+void JobSystem::wait(const JobHandle& handle)
+{
+    size_t preferred = t_workerIndex >= 0 ? static_cast<size_t>(t_workerIndex) : 0;
+    int idleSpins = 0;
+    while (!handle.isDone()) {
+        if (tryRunOne(preferred)) {
+            idleSpins = 0;
+            continue;
+        }
+        // 目标任务正在其他线程上执行：短暂让出，仍未完成则挂起，不长时间占用核心
+        if (idleSpins < kWaitSpins) {
+            idleSpins++;
+            std::this_thread::yield();
+            continue;
+        }
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            waitCv_.wait(lock, [this, &handle]() {
+                return handle.isDone() || queued_.load() > 0;
+            });
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        idleSpins = 0;
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle>& handles)
+{
+    for (const JobHandle& handle : handles) {
+        wait(handle);
+    }
+}
+
+void JobSystem::parallelForImpl(size_t begin, size_t end, size_t grain, RangeFn fn, void* ctx)
+{
+    if (end <= begin) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t chunkCount = (end - begin + grain - 1) / grain;
+    if (chunkCount == 1 || workers_.empty()) {
+        fn(ctx, begin, end);
+        return;
+    }
+
+    // 块由调用方与辅助任务共同领取；辅助任务引用栈上状态，返回前必须全部结束
+    struct Range {
+        std::atomic<size_t> nextChunk{0};
+        size_t begin;
+        size_t end;
+        size_t grain;
+        size_t chunkCount;
+        RangeFn fn;
+        void* ctx;
+
+        void run()
+        {
+            size_t chunk;
+            while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+                size_t b = begin + chunk * grain;
+                fn(ctx, b, std::min(b + grain, end));
+            }
+        }
+    } range;
+    range.begin = begin;
+    range.end = end;
+    range.grain = grain;
+    range.chunkCount = chunkCount;
+    range.fn = fn;
+    range.ctx = ctx;
+
+    size_t helperCount = std::min(workers_.size(), chunkCount - 1);
+    std::vector<JobHandle> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; i++) {
+        helpers.push_back(submit([&range]() { range.run(); }));
+    }
+    range.run();
+    waitAll(helpers);
+}
+
+} // namespace glex
@@ -0,0 +1,225 @@
+#include "glex/PassProfiler.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace glex {
+
+namespace {
+
+/** 线程在 Trace 中的编号（GPU 轨道占用 0） */
+uint32_t CurrentThreadId()
+{
+    static std::atomic<uint32_t> nextId{1};
+    thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void AppendJsonString(std::string& out, const char* str)
+{
+    out.push_back('"');
+    for (const char* p = str; *p != '\0'; p++) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            out.append(buf);
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+} // namespace
+
+const char* GetProfileScopeName(ProfileScope scope)
+{
+    switch (scope) {
+        case ProfileScope::Update: return "update";
+        case ProfileScope::FixedUpdate: return "fixedUpdate";
+        case ProfileScope::PrepareRender: return "prepareRender";
+        case ProfileScope::Render: return "render";
+        case ProfileScope::Pipeline: return "pipeline";
+    }
+    return "unknown";
+}
+
+PassProfiler::PassProfiler(size_t capacity)
+    : origin_(Clock::now()),
+      events_(std::max<size_t>(capacity, 1))
+{
+    ownTimer_.setSegmentSink([this](uint64_t seq, int64_t ns) { onGpuResult(seq, ns); });
+}
+
+PassProfiler::~PassProfiler()
+{
+    if (gpuTimer_ != &ownTimer_) {
+        gpuTimer_->setSegmentSink(nullptr);
+    }
+}
+
+void PassProfiler::setGpuTimer(GpuTimer* timer)
+{
+    GpuTimer* next = timer ? timer : &ownTimer_;
+    if (next == gpuTimer_) {
+        return;
+    }
+    if (gpuTimer_ != &ownTimer_) {
+        gpuTimer_->setSegmentSink(nullptr);
+    }
+    gpuTimer_ = next;
+    gpuTimer_->setSegmentSink([this](uint64_t seq, int64_t ns) { onGpuResult(seq, ns); });
+}
+
+void PassProfiler::setEnabled(bool enabled)
+{
+    if (enabled && !IsCompiledIn()) {
+        GLEX_LOGW("PassProfiler: compiled out (GLEX_ENABLE_PROFILER=0)");
+        return;
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+    GLEX_LOGI("PassProfiler: %{public}s", enabled ? "on" : "off");
+}
+
+int64_t PassProfiler::sinceOrigin(Clock::time_point t) const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin_).count();
+}
+
+uint64_t PassProfiler::record(const char* name, ProfileScope scope, Clock::time_point start, Clock::time_point end)
+{
+    uint32_t threadId = CurrentThreadId();
+    uint64_t frame = frame_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t seq = nextSeq_++;
+    ProfileEvent& event = events_[seq % events_.size()];
+    std::strncpy(event.name, name ? name : "", ProfileEvent::kMaxNameLength - 1);
+    event.name[ProfileEvent::kMaxNameLength - 1] = '\0';
+    event.scope = scope;
+    event.threadId = threadId;
+    event.frame = frame;
+    event.seq = seq;
+    event.startNs = sinceOrigin(start);
+    event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    event.gpuNs = -1;
+    return seq;
+}
+
+void PassProfiler::onGpuResult(uint64_t seq, int64_t ns)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // clear() 之前发起的段可能晚到：它们的事件已被清除
+    ProfileEvent& event = events_[seq % events_.size()];
+    if (seq >= firstSeq_ && event.seq == seq) {
+        event.gpuNs = ns;
+    }
+}
+
+void PassProfiler::collectGpuResults()
+{
+#if GLEX_ENABLE_PROFILER
+    gpuTimer_->collect();
+#endif
+}
+
+void PassProfiler::releaseGpu()
+{
+    ownTimer_.release();
+}
+
+void PassProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 序号不回退：仍在途的 GPU 段以旧序号回报，不能落到清空后的新事件上
+    firstSeq_ = nextSeq_;
+    for (auto& event : events_) {
+        event = ProfileEvent();
+    }
+}
+
+std::string PassProfiler::exportChromeTrace() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t capacity = events_.size();
+    uint64_t first = nextSeq_ > capacity ? nextSeq_ - capacity : 0;
+    first = first > firstSeq_ ? first : firstSeq_;
+
+    std::string out;
+    out.reserve(static_cast<size_t>(nextSeq_ - first) * 160 + 256);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    out.append("{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"GPU\"}}");
+
+    char buf[192];
+    for (uint64_t seq = first; seq < nextSeq_; seq++) {
+        const ProfileEvent& event = events_[seq % capacity];
+        const char* cat = GetProfileScopeName(event.scope);
+        out.append(",{\"ph\":\"X\",\"pid\":1,\"name\":");
+        AppendJsonString(out, event.name);
+        std::snprintf(buf, sizeof(buf),
+                      ",\"cat\":\"%s\",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%" PRIu64 "}}",
+                      cat, event.threadId, event.startNs / 1000.0, event.durationNs / 1000.0, event.frame);
+        out.append(buf);
+
+        if (event.gpuNs >= 0) {
+            // GPU 查询只给出时长：以 CPU 提交时刻为起点画在 GPU 轨道上
+            out.append(",{\"ph\":\"X\",\"pid\":1,\"name\":");
+            AppendJsonString(out, event.name);
+            std::snprintf(buf, sizeof(buf),
+                          ",\"cat\":\"gpu\",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%" PRIu64 "}}",
+                          kGpuTrackId, event.startNs / 1000.0, event.gpuNs / 1000.0, event.frame);
+            out.append(buf);
+        }
+    }
+    out.append("]}");
+    return out;
+}
+
+bool PassProfiler::WriteTraceFile(const std::string& path, const std::string& json)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        GLEX_LOGE("PassProfiler: cannot open %{public}s", path.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (ok) {
+        GLEX_LOGI("PassProfiler: trace written to %{public}s (%{public}zu bytes)", path.c_str(), json.size());
+    }
+    return ok;
+}
+
+PassProfiler::Marker::Marker(PassProfiler* profiler, const char* name, ProfileScope scope, bool gpu)
+{
+    if (!profiler || !profiler->isEnabled()) {
+        return;
+    }
+    profiler_ = profiler;
+    name_ = name;
+    scope_ = scope;
+    if (gpu) {
+        gpu_ = profiler->gpuTimer_->beginSegment();
+    }
+    start_ = Clock::now();
+}
+
+PassProfiler::Marker::~Marker()
+{
+    if (!profiler_) {
+        return;
+    }
+    uint64_t seq = profiler_->record(name_, scope_, start_, Clock::now());
+    if (gpu_) {
+        profiler_->gpuTimer_->endSegment(seq);
+    }
+}
+
+} // namespace glex
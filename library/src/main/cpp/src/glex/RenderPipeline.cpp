@@ -1,7 +1,9 @@
 #include "glex/RenderPipeline.h"
+#include "glex/JobSystem.h"
 #include "glex/Log.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace glex {
 
@@ -10,11 +12,54 @@ RenderPipeline::~RenderPipeline()
     destroy();
 }
 
+void RenderPipeline::setPipelined(bool enabled)
+{
+    if (pipelined_ == enabled) {
+        return;
+    }
+    waitForUpdate();
+    pipelined_ = enabled;
+    GLEX_LOGI("Pipeline: pipelined update %{public}s", enabled ? "on" : "off");
+}
+
+void RenderPipeline::setFixedTimestep(float step, int maxSteps)
+{
+    float newStep = step > 0.0f ? step : 0.0f;
+    int newMax = std::max(maxSteps, 1);
+    if (newStep == fixedStep_ && newMax == maxFixedSteps_) {
+        return;
+    }
+    fixedStep_ = newStep;
+    maxFixedSteps_ = newMax;
+    accumulator_ = 0.0f;
+    lastFixedSteps_ = 0;
+    interpolationAlpha_ = 1.0f;
+    if (fixedStep_ > 0.0f) {
+        GLEX_LOGI("Pipeline: fixed timestep %{public}.2f ms, max %{public}d steps/frame",
+                  fixedStep_ * 1000.0f, maxFixedSteps_);
+    } else {
+        GLEX_LOGI("Pipeline: fixed timestep off");
+    }
+}
+
+void RenderPipeline::waitForUpdate()
+{
+    if (inFlight_.empty()) {
+        return;
+    }
+    JobSystem::Get().waitAll(inFlight_);
+    inFlight_.clear();
+}
+
 void RenderPipeline::addPass(std::shared_ptr<RenderPass> pass)
 {
     if (!pass) {
         return;
     }
+    waitForUpdate();
+
+    pass->setShareGroup(shareGroup_);
+    pass->setTouchState(&touchState_);
 
     // 如果管线已初始化，自动初始化新添加的 Pass
     if (initialized_) {
@@ -22,12 +67,14 @@ void RenderPipeline::addPass(std::shared_ptr<RenderPass> pass)
     }
 
     passes_.push_back(std::move(pass));
+    fullDamage_ = true;
     GLEX_LOGI("Pipeline: added pass '%{public}s' (total: %{public}d)",
               passes_.back()->getName().c_str(), static_cast<int>(passes_.size()));
 }
 
 bool RenderPipeline::removePass(const std::string& name)
 {
+    waitForUpdate();
     auto it = std::find_if(passes_.begin(), passes_.end(),
         [&name](const std::shared_ptr<RenderPass>& p) {
             return p->getName() == name;
@@ -35,7 +82,11 @@ bool RenderPipeline::removePass(const std::string& name)
 
     if (it != passes_.end()) {
         (*it)->destroy();
+        (*it)->setTouchState(nullptr);
+        prepared_.erase(std::remove(prepared_.begin(), prepared_.end(), it->get()), prepared_.end());
+        lagging_.erase(std::remove(lagging_.begin(), lagging_.end(), it->get()), lagging_.end());
         passes_.erase(it);
+        fullDamage_ = true;
         GLEX_LOGI("Pipeline: removed pass '%{public}s'", name.c_str());
         return true;
     }
@@ -53,59 +104,286 @@ RenderPass* RenderPipeline::getPass(const std::string& name) const
     return nullptr;
 }
 
+void RenderPipeline::setShareGroup(std::shared_ptr<ShareGroup> group)
+{
+    shareGroup_ = std::move(group);
+    for (auto& pass : passes_) {
+        if (!pass->isInitialized()) {
+            pass->setShareGroup(shareGroup_);
+        }
+    }
+}
+
 void RenderPipeline::initialize(int width, int height)
 {
+    waitForUpdate();
     width_ = width;
     height_ = height;
 
     for (auto& pass : passes_) {
+        if (!pass->isInitialized()) {
+            pass->setShareGroup(shareGroup_);
+        }
         pass->initialize(width, height);
     }
 
     initialized_ = true;
+    fullDamage_ = true;
     GLEX_LOGI("Pipeline initialized: %{public}dx%{public}d, %{public}d passes",
               width, height, static_cast<int>(passes_.size()));
 }
 
 void RenderPipeline::resize(int width, int height)
 {
+    waitForUpdate();
     width_ = width;
     height_ = height;
 
     for (auto& pass : passes_) {
         pass->resize(width, height);
     }
+    fullDamage_ = true;
 
     GLEX_LOGI("Pipeline resized: %{public}dx%{public}d", width, height);
 }
 
+void RenderPipeline::step(RenderPass* pass, const SimStep& sim)
+{
+    const char* name = pass->getName().c_str();
+    if (sim.fixed) {
+        GLEX_PROFILE_SCOPE(&profiler_, name, ProfileScope::FixedUpdate);
+        for (int i = 0; i < sim.count; i++) {
+            pass->fixedUpdate(sim.dt);
+        }
+    } else {
+        GLEX_PROFILE_SCOPE(&profiler_, name, ProfileScope::Update);
+        pass->update(sim.dt);
+    }
+    GLEX_PROFILE_SCOPE(&profiler_, name, ProfileScope::PrepareRender);
+    pass->prepareRender();
+    (void)name;
+}
+
+RenderPipeline::SimStep RenderPipeline::advance(float deltaTime)
+{
+    SimStep sim;
+    if (fixedStep_ <= 0.0f) {
+        sim.dt = deltaTime;
+        interpolationAlpha_ = 1.0f;
+        return sim;
+    }
+
+    accumulator_ += std::max(deltaTime, 0.0f);
+    float steps = std::floor(accumulator_ / fixedStep_);
+    if (steps > static_cast<float>(maxFixedSteps_)) {
+        // 卡顿后只追 maxSteps 步，其余时间丢弃，保留不足一步的余量以免插值跳变
+        droppedFixedSteps_ += static_cast<uint64_t>(steps) - static_cast<uint64_t>(maxFixedSteps_);
+        steps = static_cast<float>(maxFixedSteps_);
+        accumulator_ = std::fmod(accumulator_, fixedStep_);
+    } else {
+        accumulator_ -= steps * fixedStep_;
+    }
+
+    sim.dt = fixedStep_;
+    sim.count = static_cast<int>(steps);
+    sim.fixed = true;
+    lastFixedSteps_ = sim.count;
+    interpolationAlpha_ = std::min(std::max(accumulator_ / fixedStep_, 0.0f), 1.0f);
+    return sim;
+}
+
+void RenderPipeline::simulate(const std::vector<RenderPass*>& passes, const SimStep& sim, bool async,
+                              std::vector<JobHandle>& handles)
+{
+    // 可并行的 Pass 各自作为一个任务；其余 Pass 按顺序执行（异步时打包为一个任务）
+    JobSystem& jobs = JobSystem::Get();
+    bool parallel = parallelUpdate_ && passes.size() > 1;
+    std::vector<RenderPass*> ordered;
+    for (RenderPass* pass : passes) {
+        if (parallel && pass->isParallelUpdateSafe() && pass->isEnabled()) {
+            handles.push_back(jobs.submit([this, pass, sim]() { step(pass, sim); }));
+        } else {
+            ordered.push_back(pass);
+        }
+    }
+    if (ordered.empty()) {
+        return;
+    }
+    if (async) {
+        handles.push_back(jobs.submit([this, ordered = std::move(ordered), sim]() {
+            for (RenderPass* pass : ordered) {
+                step(pass, sim);
+            }
+        }));
+        return;
+    }
+    for (RenderPass* pass : ordered) {
+        step(pass, sim);
+    }
+}
+
 void RenderPipeline::update(float deltaTime)
 {
+    profiler_.nextFrame();
+    GLEX_PROFILE_SCOPE(&profiler_, "RenderPipeline.update", ProfileScope::Pipeline);
+    SimStep sim = advance(deltaTime);
+
+    // 关闭流水线后，已准备好的一帧仍按双缓冲发布一次，不再重新模拟
+    std::vector<RenderPass*> buffered;
+    std::vector<RenderPass*> serial;
     for (auto& pass : passes_) {
-        pass->update(deltaTime);
+        bool isBuffered = pass->isDoubleBuffered() &&
+            (pipelined_ || std::find(prepared_.begin(), prepared_.end(), pass.get()) != prepared_.end());
+        (isBuffered ? buffered : serial).push_back(pass.get());
+    }
+
+    if (!buffered.empty()) {
+        // 双缓冲 Pass 的本帧数据已由上一帧投递的模拟准备好（即使中途被 waitForUpdate 等待完成）；
+        // 只有首帧或新加入的 Pass 同步准备
+        std::vector<RenderPass*> unprepared;
+        for (RenderPass* pass : buffered) {
+            if (std::find(prepared_.begin(), prepared_.end(), pass) == prepared_.end()) {
+                unprepared.push_back(pass);
+            }
+        }
+        simulate(unprepared, sim, false, inFlight_);
+        waitForUpdate();
+        for (RenderPass* pass : buffered) {
+            pass->publish();
+        }
+    }
+    // 上一帧准备的数据对应上一帧推进后的累积时间，插值系数随之滞后一帧
+    lagging_.clear();
+    for (RenderPass* pass : prepared_) {
+        if (std::find(buffered.begin(), buffered.end(), pass) != buffered.end()) {
+            lagging_.push_back(pass);
+        }
+    }
+    laggingAlpha_ = preparedAlpha_;
+    prepared_.clear();
+
+    std::vector<JobHandle> handles;
+    simulate(serial, sim, false, handles);
+    JobSystem::Get().waitAll(handles);
+    for (RenderPass* pass : serial) {
+        pass->publish();
+    }
+
+    // 投递下一帧模拟，与本帧 render 重叠（沿用本帧的步数，同样滞后一帧）
+    if (pipelined_ && !buffered.empty()) {
+        simulate(buffered, sim, true, inFlight_);
+        prepared_ = buffered;
+        preparedAlpha_ = interpolationAlpha_;
     }
 }
 
 void RenderPipeline::render()
 {
+    // 取回几帧前发起的 GPU 查询结果（不等待）
+    profiler_.collectGpuResults();
+    GLEX_PROFILE_SCOPE(&profiler_, "RenderPipeline.render", ProfileScope::Pipeline);
+    for (auto& pass : passes_) {
+        bool lagging = std::find(lagging_.begin(), lagging_.end(), pass.get()) != lagging_.end();
+        float alpha = lagging ? laggingAlpha_ : interpolationAlpha_;
+        if (!pass->isEnabled()) {
+            // 禁用的 Pass 只同步插值系数，不记录
+            pass->render(alpha);
+            continue;
+        }
+        GLEX_PROFILE_GPU_SCOPE(&profiler_, pass->getName().c_str(), ProfileScope::Render);
+        pass->render(alpha);
+    }
+}
+
+bool RenderPipeline::consumeRedrawRequests()
+{
+    bool requested = false;
     for (auto& pass : passes_) {
-        pass->render();
+        // 逐个 consume，避免短路导致后续 Pass 的请求残留
+        if (pass->consumeRedrawRequest() && pass->isEnabled()) {
+            requested = true;
+        }
+    }
+    // 固定步长下本帧可能一步也没执行（帧率高于模拟频率），沿用上一帧的请求，避免动画中途挂起
+    if (fixedStep_ > 0.0f && lastFixedSteps_ == 0 && redrawPending_) {
+        requested = true;
+    }
+    redrawPending_ = requested;
+    return requested;
+}
+
+bool RenderPipeline::collectDamage(std::vector<DamageRect>& rects)
+{
+    rects.clear();
+    bool partial = !fullDamage_;
+    fullDamage_ = false;
+
+    // 启用状态变化时被禁用的 Pass 上一帧画的内容需要擦除，按整帧处理
+    if (damageEnabledState_.size() != passes_.size()) {
+        damageEnabledState_.assign(passes_.size(), false);
+        partial = false;
+    }
+    for (size_t i = 0; i < passes_.size(); i++) {
+        RenderPass* pass = passes_[i].get();
+        bool active = pass->isEnabled() && pass->isInitialized();
+        if (damageEnabledState_[i] != active) {
+            damageEnabledState_[i] = active;
+            partial = false;
+        }
+        if (!active) {
+            continue;
+        }
+        if (!pass->reportsDamage()) {
+            partial = false;
+            continue;
+        }
+        // 整帧时也要收集：Pass 借此记录本帧范围，供下一帧擦除
+        pass->collectDamage(rects);
+    }
+
+    if (!partial) {
+        rects.clear();
+        return false;
     }
+    MergeDamage(rects, width_, height_, kMaxDamageRects);
+    return true;
 }
 
 void RenderPipeline::dispatchTouch(float x, float y, int action, int pointerId)
 {
+    TouchEvent event;
+    event.x = x;
+    event.y = y;
+    event.action = action;
+    event.pointerId = pointerId;
+    event.timestampNs = TouchQueue::Now();
+    dispatchTouch(event);
+}
+
+void RenderPipeline::dispatchTouch(const TouchEvent& event)
+{
+    waitForUpdate();
+    // 先更新状态表，Pass 在 onTouchEvent 中读到的即包含本事件
+    touchState_.apply(event);
     for (auto& pass : passes_) {
-        pass->touch(x, y, action, pointerId);
+        pass->touch(event);
     }
 }
 
 void RenderPipeline::destroy()
 {
+    waitForUpdate();
     for (auto& pass : passes_) {
         pass->destroy();
+        pass->setTouchState(nullptr);
     }
     passes_.clear();
+    prepared_.clear();
+    lagging_.clear();
+    touchState_.reset();
+    if (initialized_) {
+        profiler_.releaseGpu();
+    }
     initialized_ = false;
     GLEX_LOGI("Pipeline destroyed");
 }
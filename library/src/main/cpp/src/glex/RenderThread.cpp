@@ -1,6 +1,7 @@
 #include "glex/RenderThread.h"
 #include "glex/GLContext.h"
 #include "glex/Log.h"
+#include "glex/SharedRenderScheduler.h"
 
 #include <chrono>
 
@@ -25,19 +26,60 @@ void RenderThread::start(GLContext* context, FrameCallback callback)
 
     context_ = context;
     callback_ = std::move(callback);
+    frameStats_.reset();
+    dirty_.store(true);
+    currentCpu_.store(-1, std::memory_order_relaxed);
+    migrations_.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(policyMutex_);
+        policyDirty_.store(hasPolicy_);
+    }
+    sharedMissedFrames_.store(0, std::memory_order_relaxed);
+    sharedGpuBusyTicks_.store(0, std::memory_order_relaxed);
+    acceptingTasks_.store(true);
     running_.store(true);
 
+    startedShared_ = shared_.load();
+    if (startedShared_) {
+        SharedRenderScheduler::Get().attach(this);
+        GLEX_LOGI("RenderThread started on shared scheduler (target %{public}d FPS)", targetFPS_.load());
+        return;
+    }
+
     thread_ = std::thread([this]() { loop(); });
     GLEX_LOGI("RenderThread started (target %{public}d FPS)", targetFPS_.load());
 }
 
+void RenderThread::setShared(bool shared)
+{
+    if (running_.load()) {
+        GLEX_LOGW("RenderThread: setShared ignored while running");
+        return;
+    }
+    shared_.store(shared);
+}
+
 void RenderThread::stop()
 {
-    if (!running_.load()) {
+    // 渲染循环可能已自行退出（swapBuffers 失败）：仍需等待调度器释放本实例或 join 线程
+    if (!running_.load() && !startedShared_ && !thread_.joinable()) {
         return;
     }
 
     running_.store(false);
+    if (startedShared_) {
+        SharedRenderScheduler::Get().detach(this);
+        startedShared_ = false;
+        context_ = nullptr;
+        callback_ = nullptr;
+        currentFPS_.store(0.0f);
+        GLEX_LOGI("RenderThread stopped (shared)");
+        return;
+    }
+    wake();
+    if (scheduler_.getVsyncSource()) {
+        scheduler_.getVsyncSource()->interrupt();
+    }
     if (thread_.joinable()) {
         thread_.join();
     }
@@ -53,13 +95,111 @@ void RenderThread::setTargetFPS(int fps)
     targetFPS_.store(fps > 0 ? fps : 1);
 }
 
-void RenderThread::post(std::function<void()> task)
+void RenderThread::setRenderMode(RenderMode mode)
 {
-    if (!task) {
+    renderMode_.store(static_cast<int>(mode));
+    requestRender();
+}
+
+void RenderThread::requestRender()
+{
+    dirty_.store(true, std::memory_order_release);
+    wake();
+}
+
+void RenderThread::setThreadPolicy(const ThreadPolicy& policy)
+{
+    {
+        std::lock_guard<std::mutex> lock(policyMutex_);
+        policy_ = policy;
+        hasPolicy_ = true;
+    }
+    policyDirty_.store(true, std::memory_order_release);
+    requestRender();
+}
+
+std::string RenderThread::getThreadPolicyError() const
+{
+    std::lock_guard<std::mutex> lock(policyMutex_);
+    return policyError_;
+}
+
+void RenderThread::applyThreadPolicy()
+{
+    ThreadPolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(policyMutex_);
+        policy = policy_;
+    }
+    std::string error;
+    bool ok = ApplyThreadPolicy(policy, &error);
+    if (ok) {
+        GLEX_LOGI("RenderThread: thread policy applied");
+    } else {
+        GLEX_LOGW("RenderThread: thread policy partially applied: %{public}s", error.c_str());
+    }
+    std::lock_guard<std::mutex> lock(policyMutex_);
+    policyError_ = error;
+}
+
+void RenderThread::sampleCpu()
+{
+    int cpu = GetCurrentCpu();
+    int last = currentCpu_.exchange(cpu, std::memory_order_relaxed);
+    if (last >= 0 && cpu >= 0 && cpu != last) {
+        migrations_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RenderThread::setVsyncSource(std::shared_ptr<VsyncSource> source)
+{
+    if (running_.load()) {
+        GLEX_LOGW("RenderThread: setVsyncSource ignored while running");
         return;
     }
-    std::lock_guard<std::mutex> lock(taskMutex_);
-    tasks_.push_back(std::move(task));
+    scheduler_.setVsyncSource(std::move(source));
+}
+
+void RenderThread::setTaskBudget(float budgetMs)
+{
+    taskBudgetMs_.store(budgetMs > 0.0f ? budgetMs : 0.0f, std::memory_order_relaxed);
+}
+
+bool RenderThread::post(Task task, TaskPriority priority, float estimatedCostMs)
+{
+    if (!task) {
+        return false;
+    }
+    // 与 closeTasks 配对（均为 seq_cst）：要么这里看到投递已关闭，要么 closeTasks 等到本次入队完成
+    activePosts_.fetch_add(1);
+    if (!acceptingTasks_.load()) {
+        activePosts_.fetch_sub(1);
+        return false;
+    }
+    QueuedTask entry;
+    entry.task = std::move(task);
+    entry.priority = priority < TaskPriority::Count ? priority : TaskPriority::Normal;
+    entry.costMs = estimatedCostMs > 0.0f ? estimatedCostMs : 0.0f;
+
+    // 已有溢出任务时继续走溢出列表，保证同一线程投递的任务顺序
+    if (hasOverflow_.load(std::memory_order_acquire) || !tasks_.tryPush(entry)) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflowTasks_.push_back(std::move(entry));
+        hasOverflow_.store(true, std::memory_order_release);
+    }
+    activePosts_.fetch_sub(1);
+    // 挂起中的渲染线程需要被唤醒来执行任务（如 RunOnRenderThreadSync）
+    wake();
+    return true;
+}
+
+void RenderThread::closeTasks()
+{
+    acceptingTasks_.store(false);
+    // 只需等待已越过开关检查的 post 完成入队（不含任务执行），时间极短
+    while (activePosts_.load() > 0) {
+        std::this_thread::yield();
+    }
 }
 
 void RenderThread::loop()
@@ -67,69 +207,217 @@ void RenderThread::loop()
     if (!context_ || !context_->makeCurrent()) {
         GLEX_LOGE("RenderThread: failed to make context current");
         running_.store(false);
+        // 上下文未绑定，任务仍需执行完（同步等待者依赖它们完成）
+        closeTasks();
+        drainTasks(true);
         return;
     }
 
     GLEX_LOGI("RenderThread: GL context bound to render thread");
 
-    auto prev = std::chrono::steady_clock::now();
-    int frameCount = 0;
-    auto fpsTimer = prev;
+    beginFrames(Clock::now());
+    scheduler_.setTargetFPS(scheduledFPS_);
+    scheduler_.reset(prevFrame_);
 
     while (running_.load()) {
-        auto now = std::chrono::steady_clock::now();
-        float deltaTime = std::chrono::duration<float>(now - prev).count();
-        prev = now;
-
-        drainTasks();
-
-        // 调用用户渲染回调
-        if (callback_) {
-            callback_(deltaTime);
+        if (policyDirty_.exchange(false, std::memory_order_acq_rel)) {
+            applyThreadPolicy();
         }
 
-        // 交换缓冲区
-        if (!context_->swapBuffers()) {
-            GLEX_LOGE("RenderThread: swapBuffers failed");
-            running_.store(false);
-            break;
+        if (getRenderMode() == RenderMode::OnDemand && !dirty_.exchange(false, std::memory_order_acq_rel)) {
+            // 画面未变化：只执行任务，没有任务时挂起直到被标脏或投递任务
+            if (hasPendingTasks()) {
+                drainTasks();
+            } else {
+                park();
+            }
+            prevFrame_ = Clock::now();
+            scheduler_.resync(prevFrame_);
+            continue;
         }
 
-        // 统计 FPS
-        frameCount++;
-        auto elapsed = std::chrono::duration<float>(now - fpsTimer).count();
-        if (elapsed >= 1.0f) {
-            currentFPS_.store(static_cast<float>(frameCount) / elapsed);
-            frameCount = 0;
-            fpsTimer = now;
+        Clock::duration workTime{};
+        if (!runFrame(Clock::now(), &workTime)) {
+            break;
         }
 
-        // 帧率控制
-        int fps = targetFPS_.load();
-        int frameIntervalMs = 1000 / fps;
-        auto end = std::chrono::steady_clock::now();
-        auto renderTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - now);
-        if (renderTime.count() < frameIntervalMs) {
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(frameIntervalMs - renderTime.count()));
-        }
+        // 帧率控制：按绝对截止时间等待下一帧
+        scheduler_.setTargetFPS(scheduledFPS_);
+        uint64_t missedBefore = scheduler_.getMissedFrames();
+        scheduler_.waitForNextFrame();
+        bool missed = scheduler_.getMissedFrames() != missedBefore;
+        scheduledFPS_ = governor_.onFrame(targetFPS_.load(), workTime, missed);
     }
 
-    drainTasks();
+    // 退出前关闭投递并执行全部剩余任务（同步等待者依赖它们完成）
+    closeTasks();
+    drainTasks(true);
     context_->clearCurrent();
     GLEX_LOGI("RenderThread: render loop exited");
 }
 
-void RenderThread::drainTasks()
+void RenderThread::beginFrames(Clock::time_point now)
+{
+    prevFrame_ = now;
+    fpsTimer_ = now;
+    nextDue_ = now;
+    fpsFrames_ = 0;
+    scheduledFPS_ = targetFPS_.load();
+}
+
+bool RenderThread::runFrame(Clock::time_point now, Clock::duration* workTime)
 {
-    std::vector<std::function<void()>> tasks;
+    float deltaTime = std::chrono::duration<float>(now - prevFrame_).count();
+    prevFrame_ = now;
+
+    sampleCpu();
+    frameStats_.beginFrame();
+    {
+        // 帧在途上限：在读取输入（任务与帧回调）之前等待 GPU 追上
+        ScopedFramePhase phase(frameStats_, FramePhase::GpuWait);
+        context_->waitForFrameSlot();
+    }
+    {
+        ScopedFramePhase phase(frameStats_, FramePhase::TaskDrain);
+        drainTasks();
+    }
+
+    // 调用用户渲染回调
+    if (callback_) {
+        callback_(deltaTime);
+    }
+
+    // 工作耗时不含 swapBuffers：交换可能阻塞到下一个 vsync，不代表跟不上预算
+    *workTime = Clock::now() - now;
+
+    // 交换缓冲区
+    bool swapped = false;
     {
-        std::lock_guard<std::mutex> lock(taskMutex_);
-        tasks.swap(tasks_);
+        ScopedFramePhase phase(frameStats_, FramePhase::Swap);
+        swapped = context_->swapBuffers();
+    }
+    if (!swapped) {
+        GLEX_LOGE("RenderThread: swapBuffers failed");
+        running_.store(false);
+        return false;
+    }
+    frameStats_.endFrame();
+
+    // 统计 FPS
+    fpsFrames_++;
+    auto elapsed = std::chrono::duration<float>(now - fpsTimer_).count();
+    if (elapsed >= 1.0f) {
+        currentFPS_.store(static_cast<float>(fpsFrames_) / elapsed);
+        fpsFrames_ = 0;
+        fpsTimer_ = now;
     }
-    for (auto& task : tasks) {
-        task();
+    return true;
+}
+
+bool RenderThread::hasPendingTasks() const
+{
+    return tasks_.sizeApprox() > 0 || hasOverflow_.load(std::memory_order_acquire) ||
+           deferredTasks_.load(std::memory_order_relaxed) > 0;
+}
+
+void RenderThread::park()
+{
+    parked_.store(true, std::memory_order_relaxed);
+    // 与 wake() 中的 fence 配对：要么这里看到新任务/脏标记，要么 wake() 看到 parked_
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(parkMutex_);
+        parkCv_.wait(lock, [this]() {
+            return !running_.load() || dirty_.load(std::memory_order_acquire) || hasPendingTasks() ||
+                   getRenderMode() != RenderMode::OnDemand;
+        });
+    }
+    parked_.store(false, std::memory_order_relaxed);
+}
+
+void RenderThread::wake()
+{
+    if (SharedRenderWorker* worker = sharedWorker_.load(std::memory_order_acquire)) {
+        SharedRenderScheduler::WakeWorker(worker);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(parkMutex_);
+        }
+        parkCv_.notify_one();
+    }
+}
+
+void RenderThread::collectTasks()
+{
+    // 只取进入本次 drain 时已在队列中的任务，任务内再次 post 的留到下一帧
+    size_t pending = tasks_.sizeApprox();
+    QueuedTask entry;
+    while (pending > 0 && tasks_.tryPop(entry)) {
+        ready_[static_cast<int>(entry.priority)].push_back(std::move(entry));
+        pending--;
+    }
+
+    if (hasOverflow_.load(std::memory_order_acquire)) {
+        std::vector<QueuedTask> overflow;
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            overflow.swap(overflowTasks_);
+            hasOverflow_.store(false, std::memory_order_release);
+        }
+        for (auto& t : overflow) {
+            ready_[static_cast<int>(t.priority)].push_back(std::move(t));
+        }
+    }
+}
+
+void RenderThread::drainTasks(bool unbounded)
+{
+    collectTasks();
+
+    // 紧急任务不受预算限制
+    const int urgent = static_cast<int>(TaskPriority::Urgent);
+    while (readyHead_[urgent] < ready_[urgent].size()) {
+        QueuedTask entry = std::move(ready_[urgent][readyHead_[urgent]++]);
+        entry.task();
+    }
+
+    using Ms = std::chrono::duration<float, std::milli>;
+    const float budgetMs = taskBudgetMs_.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    float spentMs = 0.0f;
+    bool ranAny = false;
+    bool exhausted = false;
+    for (int p = static_cast<int>(TaskPriority::High); p < kTaskPriorityCount && !exhausted; p++) {
+        auto& bucket = ready_[p];
+        size_t& head = readyHead_[p];
+        while (head < bucket.size()) {
+            // 至少执行一个任务，保证大任务也能推进；顺延后不再执行更低优先级的任务，避免优先级反转
+            if (!unbounded && ranAny && spentMs + bucket[head].costMs > budgetMs) {
+                exhausted = true;
+                break;
+            }
+            QueuedTask entry = std::move(bucket[head++]);
+            entry.task();
+            ranAny = true;
+            spentMs = Ms(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    // 回收已执行的槽位：全部执行完时清空（保留容量），否则把剩余任务移到前部
+    size_t deferred = 0;
+    for (int p = 0; p < kTaskPriorityCount; p++) {
+        auto& bucket = ready_[p];
+        size_t& head = readyHead_[p];
+        if (head > 0) {
+            bucket.erase(bucket.begin(), bucket.begin() + static_cast<std::ptrdiff_t>(head));
+            head = 0;
+        }
+        deferred += bucket.size();
     }
+    deferredTasks_.store(deferred, std::memory_order_relaxed);
 }
 
 } // namespace glex
@@ -0,0 +1,199 @@
+#include "glex/ResolutionScaler.h"
+#include "glex/Log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace glex {
+
+ResolutionScaler::ResolutionScaler()
+{
+    gpuTimer_.setFrameSink([this](uint64_t frame, int64_t ns) { onGpuFrame(frame, ns); });
+}
+
+void ResolutionScaler::setConfig(const Config& config)
+{
+    config_ = config;
+    config_.minScale = std::min(std::max(config_.minScale, kMinScale), 1.0f);
+    config_.maxScale = std::min(std::max(config_.maxScale, config_.minScale), 1.0f);
+    config_.scale = std::min(std::max(config_.scale, kMinScale), 1.0f);
+    config_.windowFrames = std::max(config_.windowFrames, 1);
+
+    scale_ = quantize(config_.automatic ? config_.maxScale : config_.scale);
+    samples_.clear();
+    firstValidFrame_ = nextFrame_;
+    GLEX_LOGI("ResolutionScaler: %{public}s, scale %{public}.2f (range %{public}.2f - %{public}.2f)",
+              config_.automatic ? "auto" : "fixed", scale_, config_.minScale, config_.maxScale);
+}
+
+float ResolutionScaler::quantize(float scale) const
+{
+    // 向下取整到步长，容忍浮点误差
+    float steps = std::floor(scale / kScaleStep + 1e-3f);
+    return std::min(std::max(steps * kScaleStep, kMinScale), 1.0f);
+}
+
+void ResolutionScaler::computeSize(int width, int height, int* scaledWidth, int* scaledHeight) const
+{
+    if (scale_ >= 1.0f) {
+        *scaledWidth = width;
+        *scaledHeight = height;
+        return;
+    }
+    *scaledWidth = std::max(static_cast<int>(std::lround(width * scale_)), 1);
+    *scaledHeight = std::max(static_cast<int>(std::lround(height * scale_)), 1);
+}
+
+bool ResolutionScaler::update()
+{
+    if (!config_.automatic) {
+        return false;
+    }
+    gpuTimer_.collect();
+    if (static_cast<int>(samples_.size()) < config_.windowFrames) {
+        return false;
+    }
+
+    float sum = 0.0f;
+    for (float ms : samples_) {
+        sum += ms;
+    }
+    float average = sum / static_cast<float>(samples_.size());
+    samples_.clear();
+
+    float target = budgetMs_ * config_.headroom;
+    float next = scale_;
+    if (average > target) {
+        // 耗时近似与像素数（s^2）成正比：一次降到预计满足预算的系数
+        next = quantize(scale_ * std::sqrt(target / average));
+        if (next >= scale_) {
+            next = scale_ - kScaleStep;
+        }
+    } else if (average < target * config_.upThreshold) {
+        next = scale_ + kScaleStep;
+    }
+    next = std::min(std::max(next, config_.minScale), config_.maxScale);
+    if (std::fabs(next - scale_) < 1e-4f) {
+        return false;
+    }
+
+    GLEX_LOGI("ResolutionScaler: %{public}.2f -> %{public}.2f (avg %{public}.2f ms, target %{public}.2f ms)",
+              scale_, next, average, target);
+    scale_ = next;
+    // 已提交的帧测的是旧尺寸
+    firstValidFrame_ = nextFrame_;
+    return true;
+}
+
+bool ResolutionScaler::ensureTarget(int width, int height)
+{
+    if (fbo_ != 0 && width == targetWidth_ && height == targetHeight_) {
+        return true;
+    }
+    if (fbo_ == 0) {
+        glGenFramebuffers(1, &fbo_);
+        glGenRenderbuffers(1, &colorRb_);
+        glGenRenderbuffers(1, &depthRb_);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLint drawFbo = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb_);
+    glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRb_);
+    GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFbo));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        GLEX_LOGE("ResolutionScaler: target framebuffer incomplete, status=0x%{public}X", status);
+        targetWidth_ = 0;
+        targetHeight_ = 0;
+        return false;
+    }
+    targetWidth_ = width;
+    targetHeight_ = height;
+    return true;
+}
+
+void ResolutionScaler::onGpuFrame(uint64_t frame, int64_t ns)
+{
+    if (frame >= firstValidFrame_) {
+        addSample(static_cast<float>(static_cast<double>(ns) / 1e6));
+    }
+}
+
+void ResolutionScaler::addSample(float ms)
+{
+    if (static_cast<int>(samples_.size()) < config_.windowFrames) {
+        samples_.push_back(ms);
+    }
+}
+
+bool ResolutionScaler::beginFrame(int width, int height)
+{
+    frameWidth_ = width;
+    frameHeight_ = height;
+    computeSize(width, height, &scaledWidth_, &scaledHeight_);
+
+    gpuSampled_ = config_.automatic && gpuTimer_.beginFrame(nextFrame_++);
+
+    frameScaled_ = false;
+    if (isScaled() && ensureTarget(scaledWidth_, scaledHeight_)) {
+        GLint drawFbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+        windowFbo_ = static_cast<GLuint>(drawFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        frameScaled_ = true;
+    }
+    return frameScaled_;
+}
+
+void ResolutionScaler::endFrame()
+{
+    if (frameScaled_) {
+        glDisable(GL_SCISSOR_TEST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, windowFbo_);
+        glBlitFramebuffer(0, 0, scaledWidth_, scaledHeight_, 0, 0, frameWidth_, frameHeight_,
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        // 深度 / 模板只在本帧内使用：提示驱动不必写回（分块 GPU 上省带宽）
+        const GLenum discard = GL_DEPTH_STENCIL_ATTACHMENT;
+        glInvalidateFramebuffer(GL_READ_FRAMEBUFFER, 1, &discard);
+        glBindFramebuffer(GL_FRAMEBUFFER, windowFbo_);
+        frameScaled_ = false;
+    }
+    gpuTimer_.endFrame();
+}
+
+void ResolutionScaler::reportCpuTime(float ms)
+{
+    if (config_.automatic && !gpuSampled_) {
+        addSample(ms);
+    }
+}
+
+void ResolutionScaler::releaseGpu()
+{
+    gpuTimer_.release();
+    if (colorRb_) {
+        glDeleteRenderbuffers(1, &colorRb_);
+        colorRb_ = 0;
+    }
+    if (depthRb_) {
+        glDeleteRenderbuffers(1, &depthRb_);
+        depthRb_ = 0;
+    }
+    if (fbo_) {
+        glDeleteFramebuffers(1, &fbo_);
+        fbo_ = 0;
+    }
+    targetWidth_ = 0;
+    targetHeight_ = 0;
+    frameScaled_ = false;
+}
+
+} // namespace glex
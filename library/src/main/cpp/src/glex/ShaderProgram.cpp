@@ -66,7 +66,7 @@ bool ShaderProgram::build(const std::string& vertexSource, const std::string& fr
     glDeleteShader(fragment);
     GLResourceTracker::Get().OnDeleteShader();
 
-    uniformCache_.clear();
+    cacheActiveUniforms();
     GLEX_LOGI("Shader program built: id=%{public}u", program_);
     return true;
 }
@@ -86,6 +86,7 @@ void ShaderProgram::destroy()
         program_ = 0;
     }
     uniformCache_.clear();
+    uniformInfo_.clear();
 }
 
 // ============================================================
@@ -99,7 +100,10 @@ GLint ShaderProgram::getUniformLocation(const std::string& name)
         return it->second;
     }
     GLint loc = glGetUniformLocation(program_, name.c_str());
-    uniformCache_[name] = loc;
+    // 共享程序可能被多个线程同时查询，缓存保持只读
+    if (!shared_) {
+        uniformCache_[name] = loc;
+    }
     return loc;
 }
 
@@ -151,6 +155,53 @@ void ShaderProgram::setUniformMatrix4fv(const std::string& name, const float* va
     }
 }
 
+bool ShaderProgram::getUniformInfo(const std::string& name, UniformInfo* info) const
+{
+    auto it = uniformInfo_.find(name);
+    if (it == uniformInfo_.end()) {
+        *info = UniformInfo();
+        return false;
+    }
+    *info = it->second;
+    return true;
+}
+
+bool ShaderProgram::setUniformfv(const UniformInfo& info, const float* values, size_t count)
+{
+    if (info.location < 0 || !values || count == 0) {
+        return false;
+    }
+    size_t components = 0;
+    switch (info.type) {
+        case GL_FLOAT: components = 1; break;
+        case GL_FLOAT_VEC2: components = 2; break;
+        case GL_FLOAT_VEC3: components = 3; break;
+        case GL_FLOAT_VEC4:
+        case GL_FLOAT_MAT2: components = 4; break;
+        case GL_FLOAT_MAT3: components = 9; break;
+        case GL_FLOAT_MAT4: components = 16; break;
+        default: return false;
+    }
+    size_t elements = count / components;
+    if (elements > static_cast<size_t>(info.size)) {
+        elements = static_cast<size_t>(info.size);
+    }
+    if (elements == 0) {
+        return false;
+    }
+    GLsizei n = static_cast<GLsizei>(elements);
+    switch (info.type) {
+        case GL_FLOAT: glUniform1fv(info.location, n, values); break;
+        case GL_FLOAT_VEC2: glUniform2fv(info.location, n, values); break;
+        case GL_FLOAT_VEC3: glUniform3fv(info.location, n, values); break;
+        case GL_FLOAT_VEC4: glUniform4fv(info.location, n, values); break;
+        case GL_FLOAT_MAT2: glUniformMatrix2fv(info.location, n, GL_FALSE, values); break;
+        case GL_FLOAT_MAT3: glUniformMatrix3fv(info.location, n, GL_FALSE, values); break;
+        default: glUniformMatrix4fv(info.location, n, GL_FALSE, values); break;
+    }
+    return true;
+}
+
 GLint ShaderProgram::getAttribLocation(const std::string& name) const
 {
     return glGetAttribLocation(program_, name.c_str());
@@ -160,6 +211,46 @@ GLint ShaderProgram::getAttribLocation(const std::string& name) const
 // 内部方法
 // ============================================================
 
+void ShaderProgram::cacheActiveUniforms()
+{
+    uniformCache_.clear();
+    uniformInfo_.clear();
+    GLint count = 0;
+    GLint maxLen = 0;
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+    if (count <= 0 || maxLen <= 0) {
+        return;
+    }
+
+    std::string name(static_cast<size_t>(maxLen), '\0');
+    for (GLint i = 0; i < count; i++) {
+        GLsizei len = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program_, static_cast<GLuint>(i), maxLen, &len, &size, &type, name.data());
+        std::string uniform(name.data(), static_cast<size_t>(len));
+        GLint loc = glGetUniformLocation(program_, uniform.c_str());
+        if (loc < 0) {
+            continue;   // uniform block 成员
+        }
+        UniformInfo info;
+        info.location = loc;
+        info.type = type;
+        info.size = size;
+        uniformCache_[uniform] = loc;
+        uniformInfo_[uniform] = info;
+        // 数组同时以不带 [0] 的名字登记
+        const std::string suffix = "[0]";
+        if (uniform.size() > suffix.size() &&
+            uniform.compare(uniform.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            std::string base = uniform.substr(0, uniform.size() - suffix.size());
+            uniformCache_[base] = loc;
+            uniformInfo_[base] = info;
+        }
+    }
+}
+
 GLuint ShaderProgram::compileShader(GLenum type, const std::string& source)
 {
     if (source.empty()) {
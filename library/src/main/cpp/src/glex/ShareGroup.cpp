@@ -0,0 +1,210 @@
+#include "glex/ShareGroup.h"
+#include "glex/GLResourceTracker.h"
+#include "glex/Log.h"
+
+namespace glex {
+
+namespace {
+
+std::mutex g_groupMutex;
+std::weak_ptr<ShareGroup> g_group;
+
+/**
+ * 在根上下文上执行 GL 调用，结束后恢复调用线程原有的绑定
+ * 共享对象的创建与删除都走根上下文：调用方无需已绑定组内上下文，
+ * 也不会因为调用方绑定的是组外上下文而把对象建错地方
+ */
+class RootBinding {
+public:
+    RootBinding(std::mutex& mutex, GLContext& root)
+        : lock_(mutex),
+          root_(root),
+          display_(eglGetCurrentDisplay()),
+          draw_(eglGetCurrentSurface(EGL_DRAW)),
+          read_(eglGetCurrentSurface(EGL_READ)),
+          context_(eglGetCurrentContext())
+    {
+        bound_ = root_.makeCurrent();
+        if (!bound_) {
+            GLEX_LOGE("ShareGroup: failed to bind root context, error=0x%{public}X", eglGetError());
+        }
+    }
+
+    ~RootBinding()
+    {
+        if (context_ != EGL_NO_CONTEXT) {
+            eglMakeCurrent(display_, draw_, read_, context_);
+        } else {
+            root_.clearCurrent();
+        }
+    }
+
+    bool isBound() const { return bound_; }
+
+private:
+    std::lock_guard<std::mutex> lock_;
+    GLContext& root_;
+    EGLDisplay display_;
+    EGLSurface draw_;
+    EGLSurface read_;
+    EGLContext context_;
+    bool bound_ = false;
+};
+
+} // namespace
+
+std::shared_ptr<ShareGroup> ShareGroup::Acquire()
+{
+    std::lock_guard<std::mutex> lock(g_groupMutex);
+    std::shared_ptr<ShareGroup> group = g_group.lock();
+    if (group) {
+        return group;
+    }
+    group.reset(new ShareGroup());
+    if (!group->initialize()) {
+        return nullptr;
+    }
+    g_group = group;
+    return group;
+}
+
+ShareGroup::~ShareGroup()
+{
+    root_.destroy();
+    GLEX_LOGI("ShareGroup destroyed");
+}
+
+bool ShareGroup::initialize()
+{
+    // 初始化会把根上下文绑定到调用线程，结束后恢复原绑定
+    EGLDisplay display = eglGetCurrentDisplay();
+    EGLSurface draw = eglGetCurrentSurface(EGL_DRAW);
+    EGLSurface read = eglGetCurrentSurface(EGL_READ);
+    EGLContext context = eglGetCurrentContext();
+
+    bool ok = root_.initializeOffscreen(1, 1);
+    if (context != EGL_NO_CONTEXT) {
+        eglMakeCurrent(display, draw, read, context);
+    } else {
+        root_.clearCurrent();
+    }
+    if (!ok) {
+        GLEX_LOGE("ShareGroup: failed to create root context");
+        return false;
+    }
+    GLEX_LOGI("ShareGroup created (%{public}s)", root_.isSurfaceless() ? "surfaceless" : "pbuffer");
+    return true;
+}
+
+std::shared_ptr<ShaderProgram> ShareGroup::acquireProgram(const std::string& vertexSource,
+                                                          const std::string& fragmentSource)
+{
+    std::string key;
+    key.reserve(vertexSource.size() + fragmentSource.size() + 1);
+    key.append(vertexSource).append(1, '\0').append(fragmentSource);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = programs_.find(key);
+    if (it != programs_.end()) {
+        if (std::shared_ptr<ShaderProgram> program = it->second.lock()) {
+            return program;
+        }
+        programs_.erase(it);
+    }
+
+    std::unique_ptr<ShaderProgram> program(new ShaderProgram());
+    {
+        RootBinding binding(rootMutex_, root_);
+        if (!binding.isBound() || !program->build(vertexSource, fragmentSource)) {
+            return nullptr;
+        }
+        program->setShared(true);
+        // 其他上下文要在创建方完成后才能看到对象
+        glFinish();
+    }
+
+    std::shared_ptr<ShareGroup> self = shared_from_this();
+    std::shared_ptr<ShaderProgram> shared(program.release(), [self](ShaderProgram* p) {
+        // 根上下文绑定失败时程序只能随上下文一起释放
+        RootBinding binding(self->rootMutex_, self->root_);
+        delete p;
+    });
+    programs_[key] = shared;
+    return shared;
+}
+
+std::shared_ptr<const GLuint> ShareGroup::acquireStaticBuffer(const std::string& key, const void* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(key);
+    if (it != buffers_.end()) {
+        if (std::shared_ptr<const GLuint> buffer = it->second.lock()) {
+            return buffer;
+        }
+        buffers_.erase(it);
+    }
+
+    GLuint id = 0;
+    {
+        RootBinding binding(rootMutex_, root_);
+        if (!binding.isBound()) {
+            return nullptr;
+        }
+        glGenBuffers(1, &id);
+        GLResourceTracker::Get().OnCreateBuffer();
+        glBindBuffer(GL_ARRAY_BUFFER, id);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glFinish();
+    }
+
+    std::shared_ptr<ShareGroup> self = shared_from_this();
+    std::shared_ptr<const GLuint> shared(new GLuint(id), [self](const GLuint* buffer) {
+        {
+            RootBinding binding(self->rootMutex_, self->root_);
+            if (binding.isBound()) {
+                glDeleteBuffers(1, buffer);
+                GLResourceTracker::Get().OnDeleteBuffer();
+            }
+        }
+        delete buffer;
+    });
+    buffers_[key] = shared;
+    return shared;
+}
+
+std::shared_ptr<ShaderProgram> ShareGroup::BuildProgram(const std::shared_ptr<ShareGroup>& group,
+                                                        const std::string& vertexSource,
+                                                        const std::string& fragmentSource)
+{
+    if (group) {
+        return group->acquireProgram(vertexSource, fragmentSource);
+    }
+    auto program = std::make_shared<ShaderProgram>();
+    if (!program->build(vertexSource, fragmentSource)) {
+        return nullptr;
+    }
+    return program;
+}
+
+size_t ShareGroup::getProgramCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& item : programs_) {
+        count += item.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+size_t ShareGroup::getBufferCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& item : buffers_) {
+        count += item.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+} // namespace glex
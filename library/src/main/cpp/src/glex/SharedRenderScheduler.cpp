@@ -0,0 +1,416 @@
+#include "glex/SharedRenderScheduler.h"
+#include "glex/FrameScheduler.h"
+#include "glex/GLContext.h"
+#include "glex/Log.h"
+#include "glex/RenderThread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <string>
+#include <thread>
+
+namespace glex {
+
+struct SharedRenderWorker {
+    int index = 0;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;      // 挂起 / 唤醒
+    std::condition_variable doneCv;  // detach 完成
+    std::atomic<bool> parked{false};
+    std::atomic<bool> stopping{false};
+
+    // mutex 保护；clients 只由工作线程增删
+    std::vector<RenderThread*> clients;
+    std::vector<RenderThread*> attaching;
+    std::vector<RenderThread*> detaching;
+
+    // 仅工作线程访问
+    RenderThread* current = nullptr;  // 上下文已绑定到本线程的实例
+    size_t cursor = 0;                // 下一节拍从哪个实例开始
+    uint64_t appliedPolicy = 0;
+    FrameScheduler scheduler;
+
+    size_t load()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return clients.size() + attaching.size() - std::min(detaching.size(), clients.size());
+    }
+};
+
+namespace {
+
+bool NeedsWork(const RenderThread* client)
+{
+    return !client->isRunning() || client->getRenderMode() != RenderMode::OnDemand;
+}
+
+} // namespace
+
+SharedRenderScheduler& SharedRenderScheduler::Get()
+{
+    static SharedRenderScheduler instance;
+    return instance;
+}
+
+SharedRenderScheduler::~SharedRenderScheduler()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& worker : workers_) {
+        worker->stopping.store(true);
+        {
+            std::lock_guard<std::mutex> workerLock(worker->mutex);
+        }
+        worker->cv.notify_all();
+        if (worker->scheduler.getVsyncSource()) {
+            worker->scheduler.getVsyncSource()->interrupt();
+        }
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void SharedRenderScheduler::setThreadCount(int count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    threadCount_ = std::max(count, 1);
+}
+
+int SharedRenderScheduler::getThreadCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threadCount_;
+}
+
+void SharedRenderScheduler::setThreadPolicy(const ThreadPolicy& policy)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+    policyVersion_.fetch_add(1, std::memory_order_release);
+    for (auto& worker : workers_) {
+        WakeWorker(worker.get());
+    }
+}
+
+size_t SharedRenderScheduler::getClientCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (auto& worker : workers_) {
+        count += worker->load();
+    }
+    return count;
+}
+
+void SharedRenderScheduler::WakeWorker(SharedRenderWorker* worker)
+{
+    // 与 park() 中的 fence 配对：要么工作线程看到新状态，要么这里看到 parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (worker->parked.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+        }
+        worker->cv.notify_all();
+    }
+}
+
+void SharedRenderScheduler::attach(RenderThread* client)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 选负载最低的工作线程；都已有实例且未达上限时新建
+    SharedRenderWorker* target = nullptr;
+    size_t bestLoad = 0;
+    size_t limit = std::min(workers_.size(), static_cast<size_t>(threadCount_));
+    for (size_t i = 0; i < limit; i++) {
+        size_t load = workers_[i]->load();
+        if (!target || load < bestLoad) {
+            target = workers_[i].get();
+            bestLoad = load;
+        }
+    }
+    if (!target || (bestLoad > 0 && workers_.size() < static_cast<size_t>(threadCount_))) {
+        auto worker = std::make_unique<SharedRenderWorker>();
+        worker->index = static_cast<int>(workers_.size());
+        target = worker.get();
+        workers_.push_back(std::move(worker));
+        target->thread = std::thread([this, target]() { workerLoop(target); });
+        GLEX_LOGI("SharedRenderScheduler: worker %{public}d started", target->index);
+    }
+
+    {
+        std::lock_guard<std::mutex> workerLock(target->mutex);
+        target->attaching.push_back(client);
+    }
+    client->sharedWorker_.store(target, std::memory_order_release);
+    WakeWorker(target);
+}
+
+void SharedRenderScheduler::detach(RenderThread* client)
+{
+    SharedRenderWorker* worker = client->sharedWorker_.load(std::memory_order_acquire);
+    if (!worker) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    auto pending = std::find(worker->attaching.begin(), worker->attaching.end(), client);
+    if (pending != worker->attaching.end()) {
+        // 工作线程还没接手：直接撤销
+        worker->attaching.erase(pending);
+    } else if (std::find(worker->clients.begin(), worker->clients.end(), client) != worker->clients.end()) {
+        worker->detaching.push_back(client);
+        lock.unlock();
+        WakeWorker(worker);
+        lock.lock();
+        worker->doneCv.wait(lock, [worker, client]() {
+            return std::find(worker->clients.begin(), worker->clients.end(), client) == worker->clients.end();
+        });
+    }
+    client->sharedWorker_.store(nullptr, std::memory_order_release);
+}
+
+void SharedRenderScheduler::workerLoop(SharedRenderWorker* worker)
+{
+    SharedRenderWorker& w = *worker;
+    w.scheduler.setVsyncSource(CreateDefaultVsyncSource());
+    // 只命名：调度策略由 setThreadPolicy 设置后在 applyPolicy 中应用，未设置时保持线程默认状态
+    SetCurrentThreadName("GLEXShared" + std::to_string(w.index));
+    w.scheduler.reset(FrameScheduler::Clock::now());
+
+    while (!w.stopping.load()) {
+        applyPolicy(w);
+        updateMembership(w);
+
+        int fps = renderTick(w);
+        if (fps <= 0) {
+            park(w);
+            w.scheduler.resync(FrameScheduler::Clock::now());
+            continue;
+        }
+        w.scheduler.setTargetFPS(fps);
+        w.scheduler.waitForNextFrame();
+    }
+
+    // 进程退出：释放仍在本线程上的实例
+    std::vector<RenderThread*> remaining;
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        remaining = w.clients;
+    }
+    for (RenderThread* client : remaining) {
+        release(w, client);
+    }
+}
+
+void SharedRenderScheduler::applyPolicy(SharedRenderWorker& w)
+{
+    uint64_t version = policyVersion_.load(std::memory_order_acquire);
+    if (version == w.appliedPolicy) {
+        return;
+    }
+    ThreadPolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        policy = policy_;
+    }
+    if (policy.name.empty()) {
+        policy.name = "GLEXShared" + std::to_string(w.index);
+    }
+    std::string error;
+    if (!ApplyThreadPolicy(policy, &error)) {
+        GLEX_LOGW("SharedRenderScheduler: worker %{public}d policy partially applied: %{public}s",
+                  w.index, error.c_str());
+    }
+    w.appliedPolicy = version;
+}
+
+void SharedRenderScheduler::updateMembership(SharedRenderWorker& w)
+{
+    std::vector<RenderThread*> leaving;
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        auto now = RenderThread::Clock::now();
+        for (RenderThread* client : w.attaching) {
+            client->beginFrames(now);
+            w.clients.push_back(client);
+        }
+        w.attaching.clear();
+
+        for (RenderThread* client : w.detaching) {
+            if (std::find(w.clients.begin(), w.clients.end(), client) != w.clients.end()) {
+                leaving.push_back(client);
+            }
+        }
+        w.detaching.clear();
+        // swapBuffers 失败等原因自行停止的实例
+        for (RenderThread* client : w.clients) {
+            if (!client->isRunning() && std::find(leaving.begin(), leaving.end(), client) == leaving.end()) {
+                leaving.push_back(client);
+            }
+        }
+    }
+
+    for (RenderThread* client : leaving) {
+        release(w, client);
+    }
+}
+
+void SharedRenderScheduler::release(SharedRenderWorker& w, RenderThread* client)
+{
+    // 关闭投递后在持有上下文的线程上执行剩余任务（同步等待者依赖它们完成）并解绑上下文
+    client->closeTasks();
+    if (bind(w, client)) {
+        client->drainTasks(true);
+        client->context_->clearCurrent();
+    } else {
+        client->drainTasks(true);
+    }
+    w.current = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        w.clients.erase(std::remove(w.clients.begin(), w.clients.end(), client), w.clients.end());
+        w.cursor = 0;
+    }
+    w.doneCv.notify_all();
+}
+
+bool SharedRenderScheduler::bind(SharedRenderWorker& w, RenderThread* client)
+{
+    if (w.current == client) {
+        return true;
+    }
+    if (!client->context_ || !client->context_->makeCurrent()) {
+        w.current = nullptr;
+        return false;
+    }
+    w.current = client;
+    return true;
+}
+
+int SharedRenderScheduler::renderTick(SharedRenderWorker& w)
+{
+    using Clock = RenderThread::Clock;
+
+    std::vector<RenderThread*> clients;
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        clients = w.clients;
+    }
+    size_t count = clients.size();
+    if (count == 0) {
+        return 0;
+    }
+
+    Clock::time_point tickStart = Clock::now();
+    Clock::duration tickPeriod = w.scheduler.getPeriod();
+    size_t start = w.cursor % count;
+    size_t nextCursor = (start + 1) % count;
+    bool rendered = false;
+    bool yielded = false;
+    int fps = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t index = (start + i) % count;
+        RenderThread* client = clients[index];
+        if (!client->isRunning()) {
+            continue;
+        }
+        Clock::time_point now = Clock::now();
+
+        bool onDemand = client->getRenderMode() == RenderMode::OnDemand;
+        if (onDemand && !client->dirty_.load(std::memory_order_acquire)) {
+            // 画面未变化：只执行任务；恢复绘制时 dt 不计入空闲时长
+            if (client->hasPendingTasks()) {
+                if (!bind(w, client)) {
+                    // 任务留在队列里会让 park 一直不挂起：与绘制路径一样停止该实例，由 updateMembership 释放
+                    GLEX_LOGE("SharedRenderScheduler: failed to make context current");
+                    client->running_.store(false);
+                    continue;
+                }
+                client->drainTasks();
+                fps = std::max(fps, client->getTargetFPS());
+            }
+            client->prevFrame_ = now;
+            client->nextDue_ = now;
+            continue;
+        }
+
+        fps = std::max(fps, client->scheduledFPS_);
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(client->scheduledFPS_, 1)));
+        // 目标帧率低于节拍频率时隔拍绘制；半个节拍的容差吸收 vsync 抖动
+        if (now + tickPeriod / 2 < client->nextDue_) {
+            continue;
+        }
+        // 本节拍预算已用完：顺延到下一节拍，并让它排在最前
+        if (rendered && now - tickStart >= tickPeriod) {
+            if (!yielded) {
+                nextCursor = index;
+                yielded = true;
+            }
+            continue;
+        }
+
+        if (!bind(w, client)) {
+            GLEX_LOGE("SharedRenderScheduler: failed to make context current");
+            client->running_.store(false);
+            continue;
+        }
+        // GPU 尚未追上该实例的帧在途上限：本节拍跳过它，不阻塞其他实例（到期时间不变，下一节拍重试）
+        if (!client->context_->pollFrameSlot()) {
+            client->sharedGpuBusyTicks_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (onDemand) {
+            client->dirty_.store(false, std::memory_order_release);
+        }
+
+        Clock::duration workTime{};
+        if (!client->runFrame(now, &workTime)) {
+            // runFrame 已停止该实例；失败的帧不计入本节拍预算
+            continue;
+        }
+        rendered = true;
+
+        bool missed = now - client->nextDue_ > period / 2;
+        if (missed) {
+            client->sharedMissedFrames_.fetch_add(1, std::memory_order_relaxed);
+        }
+        client->nextDue_ = (missed ? now : client->nextDue_) + period;
+        client->scheduledFPS_ = client->governor_.onFrame(client->getTargetFPS(), workTime, missed);
+    }
+
+    w.cursor = nextCursor;
+    return fps;
+}
+
+void SharedRenderScheduler::park(SharedRenderWorker& w)
+{
+    w.parked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(w.mutex);
+        w.cv.wait(lock, [this, &w]() {
+            if (w.stopping.load() || !w.attaching.empty() || !w.detaching.empty() ||
+                policyVersion_.load(std::memory_order_acquire) != w.appliedPolicy) {
+                return true;
+            }
+            for (RenderThread* client : w.clients) {
+                if (NeedsWork(client) || client->dirty_.load(std::memory_order_acquire) ||
+                    client->hasPendingTasks()) {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+    w.parked.store(false, std::memory_order_relaxed);
+}
+
+} // namespace glex
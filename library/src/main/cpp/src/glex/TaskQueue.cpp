@@ -0,0 +1,73 @@
+#include "glex/TaskQueue.h"
+
+#include <cstdint>
+
+namespace glex {
+
+static size_t RoundUpPow2(size_t value)
+{
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+TaskQueue::TaskQueue(size_t capacity)
+{
+    size_t size = RoundUpPow2(capacity);
+    cells_.reset(new Cell[size]);
+    mask_ = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+TaskQueue::~TaskQueue() = default;
+
+bool TaskQueue::tryPush(QueuedTask& task)
+{
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+        cell = &cells_[pos & mask_];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 槽位尚未被消费者释放：队列已满
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->task = std::move(task);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool TaskQueue::tryPop(QueuedTask& out)
+{
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Cell* cell = &cells_[pos & mask_];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+        return false;
+    }
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    out = std::move(cell->task);
+    cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+size_t TaskQueue::sizeApprox() const
+{
+    size_t enq = enqueuePos_.load(std::memory_order_relaxed);
+    size_t deq = dequeuePos_.load(std::memory_order_relaxed);
+    return enq > deq ? enq - deq : 0;
+}
+
+} // namespace glex
@@ -0,0 +1,203 @@
+#include "glex/ThreadPolicy.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace glex {
+
+namespace {
+
+#ifdef __linux__
+long ReadSysfsLong(const char* path)
+{
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    long value = -1;
+    if (std::fscanf(file, "%ld", &value) != 1) {
+        value = -1;
+    }
+    std::fclose(file);
+    return value;
+}
+
+long ReadCpuCapacity(int cpu)
+{
+    char path[128];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+    long capacity = ReadSysfsLong(path);
+    if (capacity > 0) {
+        return capacity;
+    }
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    return ReadSysfsLong(path);
+}
+
+void AppendError(std::string* error, const std::string& msg)
+{
+    if (!error) {
+        return;
+    }
+    if (!error->empty()) {
+        error->append("; ");
+    }
+    error->append(msg);
+}
+#endif
+
+} // namespace
+
+std::vector<int> GetPerformanceCores()
+{
+    std::vector<int> cores;
+#ifdef __linux__
+    long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+    std::vector<std::pair<int, long>> capacities;
+    for (int cpu = 0; cpu < cpuCount; cpu++) {
+        capacities.emplace_back(cpu, ReadCpuCapacity(cpu));
+    }
+    long minCapacity = -1;
+    long maxCapacity = -1;
+    for (const auto& item : capacities) {
+        if (item.second <= 0) {
+            continue;
+        }
+        minCapacity = minCapacity < 0 ? item.second : std::min(minCapacity, item.second);
+        maxCapacity = std::max(maxCapacity, item.second);
+    }
+    // 同构或无法读取容量：返回全部 CPU
+    bool heterogeneous = minCapacity > 0 && maxCapacity > minCapacity;
+    for (const auto& item : capacities) {
+        if (!heterogeneous || item.second > minCapacity) {
+            cores.push_back(item.first);
+        }
+    }
+#endif
+    return cores;
+}
+
+int GetCurrentCpu()
+{
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+bool SetCurrentThreadName(const std::string& name, std::string* error)
+{
+#ifdef __linux__
+    int rc = pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    if (rc != 0) {
+        AppendError(error, std::string("pthread_setname_np: ") + std::strerror(rc));
+        return false;
+    }
+    return true;
+#else
+    (void)name;
+    (void)error;
+    return true;
+#endif
+}
+
+bool ApplyThreadPolicy(const ThreadPolicy& policy, std::string* error)
+{
+#ifdef __linux__
+    bool ok = true;
+
+    std::vector<int> cpus = policy.cpus;
+    if (cpus.empty() && policy.performanceCores) {
+        cpus = GetPerformanceCores();
+    }
+    // 策略是完整描述而非增量：未指定的项恢复默认，之前应用过的设置不会残留
+    if (cpus.empty()) {
+        // 恢复到全部 CPU（内核只在其中在线且 cpuset 允许的 CPU 上调度）
+        long cpuCount = std::min<long>(sysconf(_SC_NPROCESSORS_CONF), CPU_SETSIZE);
+        for (int cpu = 0; cpu < cpuCount; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        cpu_set_t current;
+        CPU_ZERO(&current);
+        bool unchanged = sched_getaffinity(0, sizeof(current), &current) == 0 && CPU_EQUAL(&current, &set);
+        if (!unchanged && sched_setaffinity(0, sizeof(set), &set) != 0) {
+            AppendError(error, std::string("sched_setaffinity: ") + std::strerror(errno));
+            ok = false;
+        }
+    }
+
+    bool realtimeApplied = false;
+    if (policy.realtime) {
+        sched_param param {};
+        param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO),
+                                        std::min(policy.realtimePriority, sched_get_priority_max(SCHED_FIFO)));
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) {
+            realtimeApplied = true;
+        } else {
+            // 普通应用通常没有 CAP_SYS_NICE，回退到 nice
+            AppendError(error, std::string("SCHED_FIFO: ") + std::strerror(rc));
+            ok = false;
+        }
+    }
+    if (!realtimeApplied) {
+        // 之前应用过实时策略（或未能提升）时回到 SCHED_OTHER
+        int currentPolicy = SCHED_OTHER;
+        sched_param current {};
+        if (pthread_getschedparam(pthread_self(), &currentPolicy, &current) == 0 &&
+            (currentPolicy == SCHED_FIFO || currentPolicy == SCHED_RR)) {
+            sched_param param {};
+            int rc = pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+            if (rc != 0) {
+                AppendError(error, std::string("SCHED_OTHER: ") + std::strerror(rc));
+                ok = false;
+            }
+        }
+    }
+
+    if (!realtimeApplied) {
+        // Linux 上 nice 值是线程级的：以 tid 调用 setpriority 只影响当前线程。
+        // 未设置 nice 时恢复为 0
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        int nice = policy.setNice ? std::max(-20, std::min(policy.nice, 19)) : 0;
+        errno = 0;
+        int currentNice = getpriority(PRIO_PROCESS, static_cast<id_t>(tid));
+        bool unchanged = errno == 0 && currentNice == nice;
+        if (!unchanged && setpriority(PRIO_PROCESS, static_cast<id_t>(tid), nice) != 0) {
+            AppendError(error, std::string("setpriority: ") + std::strerror(errno));
+            ok = false;
+        }
+    }
+
+    if (!policy.name.empty() && !SetCurrentThreadName(policy.name, error)) {
+        ok = false;
+    }
+    return ok;
+#else
+    (void)policy;
+    (void)error;
+    return true;
+#endif
+}
+
+} // namespace glex
@@ -0,0 +1,148 @@
+#include "glex/TouchInput.h"
+
+#include <chrono>
+
+namespace glex {
+
+// ============================================================
+// TouchState
+// ============================================================
+
+void TouchState::apply(const TouchEvent& event)
+{
+    PointerState* slot = nullptr;
+    PointerState* reuse = nullptr;
+    for (auto& pointer : pointers_) {
+        if (pointer.pointerId == event.pointerId) {
+            slot = &pointer;
+            break;
+        }
+        // 新手指优先占用空槽，其次是最久未更新的已抬起手指
+        if (!pointer.down && (!reuse || pointer.pointerId < 0 ||
+                              (reuse->pointerId >= 0 && pointer.timestampNs < reuse->timestampNs))) {
+            reuse = &pointer;
+        }
+    }
+    bool fresh = false;
+    if (!slot) {
+        if (!reuse) {
+            return;   // 超过 kMaxPointers 根手指同时按下
+        }
+        slot = reuse;
+        *slot = PointerState();
+        slot->pointerId = event.pointerId;
+        fresh = true;
+    }
+
+    TouchAction action = static_cast<TouchAction>(event.action);
+    // 漏掉按下事件（如按下发生在 Pass 创建之前）时以第一个移动事件作为起点
+    if (action == TouchAction::Down || (action == TouchAction::Move && (fresh || !slot->down))) {
+        slot->down = true;
+        slot->startX = event.x;
+        slot->startY = event.y;
+        slot->prevX = event.x;
+        slot->prevY = event.y;
+        slot->velocityX = 0.0f;
+        slot->velocityY = 0.0f;
+        slot->downTimeNs = event.timestampNs;
+    } else {
+        slot->prevX = slot->x;
+        slot->prevY = slot->y;
+        int64_t dt = event.timestampNs - slot->timestampNs;
+        if (dt > 0) {
+            float seconds = static_cast<float>(dt) * 1e-9f;
+            slot->velocityX = (event.x - slot->x) / seconds;
+            slot->velocityY = (event.y - slot->y) / seconds;
+        }
+        if (action == TouchAction::Up || action == TouchAction::Cancel) {
+            slot->down = false;
+        }
+    }
+    slot->x = event.x;
+    slot->y = event.y;
+    slot->timestampNs = event.timestampNs;
+}
+
+const PointerState* TouchState::find(int pointerId) const
+{
+    for (const auto& pointer : pointers_) {
+        if (pointer.pointerId == pointerId) {
+            return &pointer;
+        }
+    }
+    return nullptr;
+}
+
+int TouchState::getActiveCount() const
+{
+    int count = 0;
+    for (const auto& pointer : pointers_) {
+        if (pointer.down) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TouchState::reset()
+{
+    for (auto& pointer : pointers_) {
+        pointer = PointerState();
+    }
+}
+
+// ============================================================
+// TouchQueue
+// ============================================================
+
+TouchQueue::TouchQueue(size_t capacity)
+    : ring_(capacity)
+{
+}
+
+int64_t TouchQueue::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TouchQueue::push(TouchEvent event)
+{
+    if (event.timestampNs <= 0) {
+        event.timestampNs = Now();
+    }
+    if (event.timestampNs < lastTimestampNs_) {
+        event.timestampNs = lastTimestampNs_;
+    }
+    lastTimestampNs_ = event.timestampNs;
+
+    // 溢出列表非空时后续事件也排在其后，保证顺序
+    if (!hasOverflow_.load(std::memory_order_acquire) && ring_.tryPush(event)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    overflow_.push_back(event);
+    hasOverflow_.store(true, std::memory_order_release);
+    overflowCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t TouchQueue::drain(std::vector<TouchEvent>& out)
+{
+    size_t before = out.size();
+    // 先读标志再取环：标志已置位时生产者不再写环，此刻环中的事件都早于溢出列表；
+    // 反之本轮不取溢出列表，留到下一轮（届时环中剩余的事件同样更早）
+    bool overflow = hasOverflow_.load(std::memory_order_acquire);
+    TouchEvent event;
+    while (ring_.tryPop(event)) {
+        out.push_back(event);
+    }
+    if (overflow) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        out.insert(out.end(), overflow_.begin(), overflow_.end());
+        overflow_.clear();
+        hasOverflow_.store(false, std::memory_order_release);
+    }
+    return out.size() - before;
+}
+
+} // namespace glex
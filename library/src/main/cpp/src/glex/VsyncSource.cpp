@@ -0,0 +1,241 @@
+#include "glex/VsyncSource.h"
+#include "glex/FrameScheduler.h"
+#include "glex/Log.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#ifdef OHOS_PLATFORM
+#include <native_vsync/native_vsync.h>
+#endif
+
+namespace glex {
+
+// ============================================================
+// TimerVsyncSource
+// ============================================================
+
+TimerVsyncSource::TimerVsyncSource(std::chrono::nanoseconds period)
+    : period_(period.count() > 0 ? period : std::chrono::nanoseconds(16666667))
+{
+}
+
+bool TimerVsyncSource::waitForVsync(Clock::time_point* timestamp)
+{
+    if (interrupted_.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    auto period = std::chrono::duration_cast<Clock::duration>(period_);
+    auto now = Clock::now();
+    if (!anchored_) {
+        next_ = now + period;
+        anchored_ = true;
+    } else if (next_ <= now) {
+        // 落后时按整周期跳过，保持节拍相位
+        auto behind = (now - next_) / period + 1;
+        next_ += period * behind;
+    }
+
+    FrameScheduler::SleepUntil(next_);
+    if (timestamp) {
+        *timestamp = next_;
+    }
+    next_ += period;
+    return true;
+}
+
+void TimerVsyncSource::interrupt()
+{
+    interrupted_.store(true, std::memory_order_release);
+}
+
+void TimerVsyncSource::clearInterrupt()
+{
+    interrupted_.store(false, std::memory_order_release);
+}
+
+// ============================================================
+// NativeVsyncSource
+// ============================================================
+
+#ifdef OHOS_PLATFORM
+
+namespace {
+constexpr char kVsyncName[] = "GLEXRender";
+constexpr auto kVsyncTimeout = std::chrono::milliseconds(100);
+} // namespace
+
+struct NativeVsyncSource::CallbackState {
+    // 一次 RequestFrame：回调以它为参数，按序号判断是否属于当前的等待
+    struct Request {
+        CallbackState* owner = nullptr;
+        uint64_t seq = 0;
+        bool inFlight = false;
+    };
+
+    // 超时后无法撤销的请求最多保留这么多个；全部在途时退回计时
+    static constexpr int kMaxRequests = 4;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t nextSeq = 0;
+    uint64_t currentSeq = 0;     // 正在等待的请求序号，0 表示没有等待
+    bool signaled = false;
+    bool interrupted = false;
+    long long timestampNs = 0;
+    Request requests[kMaxRequests];
+    std::atomic<int> refs{1};
+
+    CallbackState()
+    {
+        for (Request& request : requests) {
+            request.owner = this;
+        }
+    }
+
+    Request* acquireRequest()
+    {
+        for (Request& request : requests) {
+            if (!request.inFlight) {
+                return &request;
+            }
+        }
+        return nullptr;
+    }
+
+    void retain() { refs.fetch_add(1, std::memory_order_relaxed); }
+
+    void release()
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+NativeVsyncSource::NativeVsyncSource()
+    : state_(new CallbackState())
+{
+    vsync_ = OH_NativeVSync_Create(kVsyncName, sizeof(kVsyncName) - 1);
+    if (!vsync_) {
+        GLEX_LOGW("NativeVsyncSource: OH_NativeVSync_Create failed");
+    }
+}
+
+NativeVsyncSource::~NativeVsyncSource()
+{
+    interrupt();
+    if (vsync_) {
+        OH_NativeVSync_Destroy(vsync_);
+        vsync_ = nullptr;
+    }
+    // 未完成请求的回调持有各自的引用：此后回调仍可安全执行，状态由最后一个引用释放
+    state_->release();
+    state_ = nullptr;
+}
+
+void NativeVsyncSource::OnVsync(long long timestamp, void* data)
+{
+    auto* request = static_cast<CallbackState::Request*>(data);
+    if (!request) {
+        return;
+    }
+    CallbackState* state = request->owner;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        request->inFlight = false;
+        // 超时后迟到的回调不属于当前等待：丢弃，避免以过期时间戳满足下一次等待
+        if (request->seq == state->currentSeq) {
+            state->timestampNs = timestamp;
+            state->signaled = true;
+        }
+    }
+    state->cv.notify_one();
+    state->release();
+}
+
+bool NativeVsyncSource::waitForVsync(Clock::time_point* timestamp)
+{
+    if (!vsync_) {
+        return false;
+    }
+
+    CallbackState* state = state_;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->interrupted) {
+        state->interrupted = false;
+        return false;
+    }
+    CallbackState::Request* request = state->acquireRequest();
+    if (!request) {
+        // 之前超时的请求都还没有回调：本次退回计时，不再累积请求
+        return false;
+    }
+    request->seq = ++state->nextSeq;
+    request->inFlight = true;
+    state->currentSeq = request->seq;
+    state->signaled = false;
+    // 引用归本次请求，由回调释放
+    state->retain();
+    if (OH_NativeVSync_RequestFrame(vsync_, &NativeVsyncSource::OnVsync, request) != 0) {
+        request->inFlight = false;
+        state->currentSeq = 0;
+        state->refs.fetch_sub(1, std::memory_order_acq_rel);   // 信号源仍持有引用，不会归零
+        return false;
+    }
+    state->cv.wait_for(lock, kVsyncTimeout, [state]() {
+        return state->signaled || state->interrupted;
+    });
+    // 不论结果如何本次等待都已结束，此后到达的回调一律丢弃
+    state->currentSeq = 0;
+    if (!state->signaled) {
+        state->interrupted = false;
+        return false;
+    }
+    if (timestamp) {
+        *timestamp = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(state->timestampNs)));
+    }
+    return true;
+}
+
+std::chrono::nanoseconds NativeVsyncSource::getPeriod() const
+{
+    long long period = 0;
+    if (vsync_ && OH_NativeVSync_GetPeriod(vsync_, &period) == 0 && period > 0) {
+        return std::chrono::nanoseconds(period);
+    }
+    return std::chrono::nanoseconds(16666667);
+}
+
+void NativeVsyncSource::interrupt()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->interrupted = true;
+    }
+    state_->cv.notify_all();
+}
+
+void NativeVsyncSource::clearInterrupt()
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->interrupted = false;
+}
+
+#endif
+
+std::shared_ptr<VsyncSource> CreateDefaultVsyncSource()
+{
+#ifdef OHOS_PLATFORM
+    auto native = std::make_shared<NativeVsyncSource>();
+    if (native->isValid()) {
+        return native;
+    }
+#endif
+    return std::make_shared<TimerVsyncSource>();
+}
+
+} // namespace glex
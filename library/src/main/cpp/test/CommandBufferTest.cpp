@@ -0,0 +1,217 @@
+/**
+ * CommandBuffer 测试：submitCommands 的二进制解码与整批校验，格式错误的批次整体拒绝
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "UniformTable.h"
+#include "TestCheck.h"
+
+namespace {
+
+using glex::bridge::Command;
+using glex::bridge::CommandOp;
+using glex::bridge::CommandReader;
+using glex::bridge::UniformTable;
+using glex::bridge::ValidateCommands;
+
+// 与 GlexCommandEncoder 相同的编码（小端）
+class Encoder {
+public:
+    template <typename T>
+    void put(T value)
+    {
+        uint8_t raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+
+    void header(CommandOp op, size_t payloadBytes)
+    {
+        put<uint8_t>(static_cast<uint8_t>(op));
+        put<uint8_t>(0);
+        put<uint16_t>(static_cast<uint16_t>(payloadBytes));
+    }
+
+    void setUniform(const std::string& name, const std::vector<float>& values)
+    {
+        header(CommandOp::SetUniform, 1 + name.size() + values.size() * sizeof(float));
+        put<uint8_t>(static_cast<uint8_t>(name.size()));
+        bytes.insert(bytes.end(), name.begin(), name.end());
+        for (float v : values) {
+            put<float>(v);
+        }
+    }
+
+    void setUniformByHandle(int32_t handle, size_t count)
+    {
+        header(CommandOp::SetUniformByHandle, sizeof(int32_t) + count * sizeof(float));
+        put<int32_t>(handle);
+        for (size_t i = 0; i < count; i++) {
+            put<float>(1.0f);
+        }
+    }
+
+    void touch(float x, float y, int32_t action)
+    {
+        header(CommandOp::Touch, 24);
+        put<float>(x);
+        put<float>(y);
+        put<int32_t>(action);
+        put<int32_t>(0);
+        put<double>(0.0);
+    }
+
+    void setClearColor(float r, float g, float b, float a)
+    {
+        header(CommandOp::SetClearColor, 16);
+        put<float>(r);
+        put<float>(g);
+        put<float>(b);
+        put<float>(a);
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+bool Validate(const std::vector<uint8_t>& bytes, size_t* count = nullptr, std::string* error = nullptr)
+{
+    size_t n = 0;
+    std::string message;
+    bool ok = ValidateCommands(bytes.data(), bytes.size(), &n, &message);
+    if (ok && count) {
+        *count = n;
+    }
+    if (error) {
+        *error = message;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // 合法批次：逐条解码
+    {
+        Encoder enc;
+        enc.setUniform("u_color", { 1.0f, 0.5f, 0.25f, 1.0f });
+        enc.touch(10.0f, 20.0f, 1);
+        enc.setClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+        enc.setUniformByHandle(3, 2);
+        size_t count = 0;
+        GLEX_CHECK(Validate(enc.bytes, &count));
+        GLEX_CHECK(count == 4);
+
+        CommandReader reader(enc.bytes.data(), enc.bytes.size());
+        Command command;
+        GLEX_CHECK(reader.next(command) && command.op == CommandOp::SetUniform);
+        GLEX_CHECK(command.getName() == "u_color" && command.valueCount == 4 && command.readValue(1) == 0.5f);
+        GLEX_CHECK(reader.next(command) && command.op == CommandOp::Touch);
+        GLEX_CHECK(command.touch.x == 10.0f && command.touch.y == 20.0f && command.touch.action == 1);
+        GLEX_CHECK(reader.next(command) && command.op == CommandOp::SetClearColor && command.color[2] == 0.3f);
+        GLEX_CHECK(reader.next(command) && command.op == CommandOp::SetUniformByHandle);
+        GLEX_CHECK(command.handle == 3 && command.valueCount == 2);
+        GLEX_CHECK(!reader.next(command) && !reader.hasError());
+    }
+
+    // 截断的头部
+    {
+        Encoder enc;
+        enc.setClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        enc.bytes.push_back(static_cast<uint8_t>(CommandOp::SetClearColor));
+        enc.bytes.push_back(0);
+        std::string error;
+        GLEX_CHECK(!Validate(enc.bytes, nullptr, &error));
+        GLEX_CHECK(error.find("truncated command header") != std::string::npos);
+    }
+
+    // 截断的负载
+    {
+        Encoder enc;
+        enc.setClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        enc.bytes.resize(enc.bytes.size() - 1);
+        std::string error;
+        GLEX_CHECK(!Validate(enc.bytes, nullptr, &error));
+        GLEX_CHECK(error.find("truncated payload") != std::string::npos);
+    }
+
+    // 未知命令
+    {
+        Encoder enc;
+        enc.header(static_cast<CommandOp>(0x7F), 0);
+        std::string error;
+        GLEX_CHECK(!Validate(enc.bytes, nullptr, &error));
+        GLEX_CHECK(error.find("unknown command") != std::string::npos);
+    }
+
+    // 非有限值
+    {
+        Encoder uniform;
+        uniform.setUniform("u_value", { 1.0f, nan });
+        GLEX_CHECK(!Validate(uniform.bytes));
+
+        Encoder byHandle;
+        byHandle.header(CommandOp::SetUniformByHandle, 8);
+        byHandle.put<int32_t>(0);
+        byHandle.put<float>(inf);
+        GLEX_CHECK(!Validate(byHandle.bytes));
+
+        Encoder touch;
+        touch.touch(nan, 0.0f, 0);
+        GLEX_CHECK(!Validate(touch.bytes));
+
+        Encoder color;
+        color.setClearColor(0.0f, -inf, 0.0f, 1.0f);
+        GLEX_CHECK(!Validate(color.bytes));
+    }
+
+    // 超过 UniformTable::kMaxValues 个 float
+    {
+        Encoder atLimit;
+        atLimit.setUniformByHandle(0, UniformTable::kMaxValues);
+        GLEX_CHECK(Validate(atLimit.bytes));
+
+        Encoder byHandle;
+        byHandle.setUniformByHandle(0, UniformTable::kMaxValues + 1);
+        GLEX_CHECK(!Validate(byHandle.bytes));
+
+        Encoder byName;
+        byName.setUniform("u_big", std::vector<float>(UniformTable::kMaxValues + 1, 0.0f));
+        GLEX_CHECK(!Validate(byName.bytes));
+    }
+
+    // 批次中间的一条错误命令使整批被拒绝
+    {
+        Encoder enc;
+        enc.setUniform("u_first", { 1.0f });
+        enc.touch(1.0f, 2.0f, 0);
+        enc.touch(1.0f, 2.0f, 9);   // 无效 action
+        enc.setClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        size_t count = 123;
+        std::string error;
+        GLEX_CHECK(!ValidateCommands(enc.bytes.data(), enc.bytes.size(), &count, &error));
+        GLEX_CHECK(count == 123);   // 失败时不输出条数
+        GLEX_CHECK(error.find("touch: invalid action") != std::string::npos);
+    }
+
+    // 空批次合法
+    {
+        size_t count = 1;
+        GLEX_CHECK(Validate({}, &count));
+        GLEX_CHECK(count == 0);
+    }
+
+    std::printf("CommandBuffer: %d failures\n", ::glex::test::FailureCount());
+    return GLEX_TEST_RESULT();
+}
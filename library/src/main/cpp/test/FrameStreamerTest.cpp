@@ -0,0 +1,167 @@
+/**
+ * FrameStreamer 测试：离屏画面经 PBO 异步读取后由工作线程交给消费回调，停止时工作线程及时退出，
+ * 消费阻塞时队列恰好容纳 queueCapacity 帧
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+
+#include <GLES3/gl3.h>
+
+#include "glex/FrameStreamer.h"
+#include "glex/GLContext.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 64;
+constexpr int kFrames = 8;
+
+struct Delivery {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int frames = 0;
+    bool sizeOk = true;
+    uint8_t firstRed = 0;
+};
+
+void CaptureFrames(glex::GLContext& ctx, glex::FrameStreamer& streamer, int frames)
+{
+    for (int i = 0; i < frames; i++) {
+        ctx.makeCurrent();
+        glViewport(0, 0, kWidth, kHeight);
+        glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        streamer.captureFrame(kWidth, kHeight);
+        // 读取完成后下一次 captureFrame 把它推给工作线程
+        glFinish();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    glex::GLContext ctx;
+    if (!ctx.initializeOffscreen(kWidth, kHeight)) {
+        std::fprintf(stderr, "initializeOffscreen failed\n");
+        return 1;
+    }
+
+    Delivery delivery;
+    glex::FrameStreamer streamer;
+    glex::StreamConfig config;
+    config.width = kWidth / 2;
+    config.height = kHeight / 2;
+    config.queueCapacity = 16;   // 单核上工作线程可能迟迟得不到调度：容量足够时不丢帧
+    config.readbackSlots = 2;
+    GLEX_CHECK(streamer.start(config, [&delivery](glex::StreamFrame&& frame) {
+        std::lock_guard<std::mutex> lock(delivery.mutex);
+        if (frame.width != kWidth / 2 || frame.height != kHeight / 2 || !frame.pixels) {
+            delivery.sizeOk = false;
+        } else if (delivery.frames == 0) {
+            delivery.firstRed = frame.pixels[0];
+        }
+        delivery.frames++;
+        delivery.cv.notify_all();
+        return true;
+    }));
+
+    CaptureFrames(ctx, streamer, kFrames);
+    {
+        // 工作线程无超时等待：推入后的通知必须能唤醒它
+        std::unique_lock<std::mutex> lock(delivery.mutex);
+        delivery.cv.wait_for(lock, std::chrono::seconds(2), [&delivery]() {
+            return delivery.frames >= kFrames - 1;
+        });
+        GLEX_CHECK(delivery.frames >= kFrames - 1);
+        GLEX_CHECK(delivery.sizeOk);
+        GLEX_CHECK(delivery.firstRed == 255);
+    }
+
+    // 本帧之前无关代码留下的 GL 错误不应使采集失败
+    {
+        std::unique_lock<std::mutex> lock(delivery.mutex);
+        int before = delivery.frames;
+        lock.unlock();
+        uint64_t capturedBefore = streamer.getStats().captured;
+        glEnable(0xFFFF);   // GL_INVALID_ENUM
+        CaptureFrames(ctx, streamer, 2);
+        GLEX_CHECK(streamer.getStats().captured == capturedBefore + 2);
+        lock.lock();
+        delivery.cv.wait_for(lock, std::chrono::seconds(2), [&delivery, before]() {
+            return delivery.frames > before;
+        });
+        GLEX_CHECK(delivery.frames > before);
+    }
+
+    // 空闲的工作线程停在条件变量上，stop 必须能唤醒并合并它
+    auto stopStart = std::chrono::steady_clock::now();
+    streamer.stop();
+    double stopMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stopStart).count();
+    GLEX_CHECK(stopMs < 1000.0);
+    glex::StreamStats stats = streamer.getStats();
+    GLEX_CHECK(stats.captured >= static_cast<uint64_t>(kFrames - 1));
+    GLEX_CHECK(stats.delivered == static_cast<uint64_t>(delivery.frames));
+
+    // 消费回调阻塞时队列恰好容纳 queueCapacity 帧（不取整为 2 的幂），其余计入 droppedQueueFull
+    {
+        constexpr size_t kQueueCapacity = 3;
+        struct Gate {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool entered = false;
+            bool open = false;
+            int frames = 0;
+        } gate;
+        glex::FrameStreamer blocked;
+        glex::StreamConfig blockedConfig = config;
+        blockedConfig.queueCapacity = kQueueCapacity;
+        GLEX_CHECK(blocked.start(blockedConfig, [&gate](glex::StreamFrame&&) {
+            std::unique_lock<std::mutex> lock(gate.mutex);
+            gate.frames++;
+            gate.entered = true;
+            gate.cv.notify_all();
+            gate.cv.wait(lock, [&gate]() { return gate.open; });
+            return true;
+        }));
+        // 先让工作线程取走一帧并卡在回调里，之后推入的帧只能留在队列中
+        std::unique_lock<std::mutex> lock(gate.mutex);
+        for (int i = 0; i < 2 * kFrames && !gate.entered; i++) {
+            lock.unlock();
+            CaptureFrames(ctx, blocked, 1);
+            lock.lock();
+            gate.cv.wait_for(lock, std::chrono::milliseconds(50), [&gate]() { return gate.entered; });
+        }
+        GLEX_CHECK(gate.entered);
+        lock.unlock();
+        CaptureFrames(ctx, blocked, static_cast<int>(kQueueCapacity) + 3);
+        GLEX_CHECK(blocked.getStats().droppedQueueFull >= 1);
+
+        lock.lock();
+        gate.open = true;
+        gate.cv.notify_all();
+        gate.cv.wait_for(lock, std::chrono::seconds(2), [&gate]() {
+            return gate.frames >= static_cast<int>(kQueueCapacity) + 1;
+        });
+        lock.unlock();
+        blocked.stop();
+        GLEX_CHECK(gate.frames == static_cast<int>(kQueueCapacity) + 1);
+        glex::StreamStats blockedStats = blocked.getStats();
+        GLEX_CHECK(blockedStats.delivered == kQueueCapacity + 1);
+        blocked.releaseGpu();
+    }
+
+    streamer.releaseGpu();
+    GLEX_CHECK(glGetError() == GL_NO_ERROR);
+    ctx.destroy();
+    std::printf("FrameStreamer: captured %llu, delivered %llu, stop %.2f ms\n",
+                static_cast<unsigned long long>(stats.captured), static_cast<unsigned long long>(stats.delivered),
+                stopMs);
+    return GLEX_TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+/**
+ * GpuTimer 测试：一帧切成首尾相接的段，标记段与整帧结果都能取回；
+ * PassProfiler 与 ResolutionScaler 共用同一条查询流时，动态分辨率仍按 GPU 耗时调节
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glex/GLContext.h"
+#include "glex/GpuTimer.h"
+#include "glex/PassProfiler.h"
+#include "glex/RenderPipeline.h"
+#include "glex/ResolutionScaler.h"
+#include "DemoPass.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr int kWidth = 160;
+constexpr int kHeight = 120;
+
+void Draw()
+{
+    glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+// 渲染若干帧：整帧由 scaler 计时，剖析器的逐 Pass 段落在帧内
+void RenderFrames(glex::ResolutionScaler& scaler, glex::RenderPipeline& pipeline, int frames, float cpuMs)
+{
+    for (int i = 0; i < frames; i++) {
+        if (scaler.update()) {
+            int sw = 0;
+            int sh = 0;
+            scaler.computeSize(kWidth, kHeight, &sw, &sh);
+            pipeline.resize(sw, sh);
+        }
+        scaler.beginFrame(kWidth, kHeight);
+        Draw();
+        pipeline.update(1.0f / 60.0f);
+        pipeline.render();
+        scaler.endFrame();
+        scaler.reportCpuTime(cpuMs);
+        glFinish();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    glex::GLContext ctx;
+    if (!ctx.initializeOffscreen(kWidth, kHeight)) {
+        std::fprintf(stderr, "initializeOffscreen failed\n");
+        return 1;
+    }
+
+    glex::GpuTimer timer;
+    if (!timer.isSupported()) {
+        std::printf("GpuTimer: GL_EXT_disjoint_timer_query unavailable, skipped\n");
+        ctx.destroy();
+        return 0;
+    }
+
+    // 一帧两个标记段：段按提交顺序回调，整帧只回调一次
+    std::vector<uint64_t> tags;
+    std::vector<uint64_t> frames;
+    int64_t frameNs = -1;
+    timer.setSegmentSink([&](uint64_t tag, int64_t) { tags.push_back(tag); });
+    timer.setFrameSink([&](uint64_t frame, int64_t ns) {
+        frames.push_back(frame);
+        frameNs = ns;
+    });
+    GLEX_CHECK(timer.beginFrame(5));
+    Draw();
+    GLEX_CHECK(timer.beginSegment());
+    GLEX_CHECK(!timer.beginSegment());   // 不能嵌套
+    Draw();
+    timer.endSegment(7);
+    Draw();
+    GLEX_CHECK(timer.beginSegment());
+    Draw();
+    timer.endSegment(8);
+    timer.endFrame();
+    // 没有进行中的帧：单独的一段只回调段结果
+    GLEX_CHECK(timer.beginSegment());
+    Draw();
+    timer.endSegment(9);
+    glFinish();
+    timer.collect();
+    GLEX_CHECK((tags == std::vector<uint64_t>{ 7, 8, 9 }));
+    GLEX_CHECK((frames == std::vector<uint64_t>{ 5 }));
+    GLEX_CHECK(frameNs >= 0);
+
+    // 丢弃已提交的结果
+    GLEX_CHECK(timer.beginFrame(6));
+    timer.endFrame();
+    timer.discardPending();
+    glFinish();
+    timer.collect();
+    GLEX_CHECK(frames.size() == 1);
+    timer.release();
+
+    // 剖析器与动态分辨率共用 scaler 的查询流
+    glex::ResolutionScaler scaler;
+    glex::ResolutionScaler::Config config;
+    config.automatic = true;
+    config.windowFrames = 5;
+    scaler.setConfig(config);
+    glex::RenderPipeline pipeline;
+    pipeline.addPass(std::make_shared<glex::DemoPass>());
+    pipeline.initialize(kWidth, kHeight);
+    pipeline.getProfiler().setEnabled(true);
+    pipeline.getProfiler().setGpuTimer(&scaler.getGpuTimer());
+
+    // 预算充足而 CPU 耗时远超预算：按 GPU 耗时调节，系数保持不变
+    scaler.setFrameBudget(1000.0f);
+    RenderFrames(scaler, pipeline, 30, 5000.0f);
+    GLEX_CHECK(scaler.getScale() == 1.0f);
+    // 剖析器拿到了逐 Pass 的 GPU 耗时（GLEX_ENABLE_PROFILER=OFF 时剖析器为空实现，不产生记录）
+    if (glex::PassProfiler::IsCompiledIn()) {
+        std::string trace = pipeline.getProfiler().exportChromeTrace();
+        GLEX_CHECK(trace.find("\"cat\":\"gpu\"") != std::string::npos);
+    }
+
+    // 预算极小：GPU 样本照常到达，系数下降
+    scaler.setFrameBudget(0.0001f);
+    RenderFrames(scaler, pipeline, 30, 0.0f);
+    GLEX_CHECK(scaler.getScale() < 1.0f);
+    GLEX_CHECK(glGetError() == GL_NO_ERROR);
+
+    pipeline.getProfiler().setGpuTimer(nullptr);
+    pipeline.destroy();
+    scaler.releaseGpu();
+    ctx.destroy();
+    std::printf("GpuTimer: %zu segments, %zu frames, scale %.2f\n", tags.size(), frames.size(), scaler.getScale());
+    return GLEX_TEST_RESULT();
+}
@@ -0,0 +1,127 @@
+/**
+ * 离屏冒烟测试：initializeOffscreen → DemoPass + AttackPass 跑 N 帧 → readPixels 校验画面
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <GLES3/gl3.h>
+
+#include "glex/GLContext.h"
+#include "glex/RenderPipeline.h"
+#include "glex/RenderThread.h"
+#include "AttackPass.h"
+#include "DemoPass.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+constexpr int kFrames = 60;
+constexpr float kFrameDelta = 1.0f / 60.0f;
+
+// 不同颜色的像素数（粗略衡量画面是否有内容）
+size_t CountDistinctColors(const std::vector<uint8_t>& rgba)
+{
+    std::vector<uint32_t> colors;
+    for (size_t i = 0; i + 3 < rgba.size(); i += 4) {
+        uint32_t c = rgba[i] | (rgba[i + 1] << 8) | (rgba[i + 2] << 16);
+        bool seen = false;
+        for (uint32_t known : colors) {
+            if (known == c) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            colors.push_back(c);
+            if (colors.size() >= 64) {
+                break;
+            }
+        }
+    }
+    return colors.size();
+}
+
+void RenderFrames(glex::GLContext& ctx, glex::RenderPipeline& pipeline, int frames)
+{
+    for (int i = 0; i < frames; i++) {
+        ctx.makeCurrent();
+        glViewport(0, 0, kWidth, kHeight);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        pipeline.update(kFrameDelta);
+        pipeline.render();
+        ctx.swapBuffers();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    glex::GLContext ctx;
+    if (!ctx.initializeOffscreen(kWidth, kHeight)) {
+        std::fprintf(stderr, "initializeOffscreen failed\n");
+        return 1;
+    }
+    GLEX_CHECK(ctx.isOffscreen());
+    GLEX_CHECK(ctx.getFramebuffer() != 0);
+
+    for (bool pipelined : { false, true }) {
+        glex::RenderPipeline pipeline;
+        pipeline.setParallelUpdate(pipelined);
+        pipeline.setPipelined(pipelined);
+        pipeline.addPass(std::make_shared<glex::DemoPass>());
+        pipeline.addPass(std::make_shared<glex::AttackPass>());
+        pipeline.initialize(kWidth, kHeight);
+        GLEX_CHECK(pipeline.isInitialized());
+
+        RenderFrames(ctx, pipeline, kFrames);
+        // 触摸：按下 → 移动 → 抬起，AttackPass 产生斩击
+        pipeline.dispatchTouch(kWidth * 0.25f, kHeight * 0.5f, 0, 0);
+        pipeline.dispatchTouch(kWidth * 0.75f, kHeight * 0.5f, 1, 0);
+        pipeline.dispatchTouch(kWidth * 0.75f, kHeight * 0.5f, 2, 0);
+        RenderFrames(ctx, pipeline, kFrames);
+        GLEX_CHECK(glGetError() == GL_NO_ERROR);
+
+        std::vector<uint8_t> rgba;
+        GLEX_CHECK(ctx.readPixels(rgba));
+        GLEX_CHECK(rgba.size() == static_cast<size_t>(kWidth) * kHeight * 4);
+        // DemoPass 绘制渐变背景与星星：画面不应是单一的清屏色
+        GLEX_CHECK(CountDistinctColors(rgba) > 8);
+
+        pipeline.destroy();
+    }
+
+    // 帧在途上限：GPU 完成后非阻塞轮询即可取得槽位，等待不再阻塞
+    ctx.setMaxFramesInFlight(1);
+    glClear(GL_COLOR_BUFFER_BIT);
+    GLEX_CHECK(ctx.swapBuffers());
+    glFinish();
+    GLEX_CHECK(ctx.pollFrameSlot());
+    GLEX_CHECK(ctx.waitForFrameSlot() == 0);
+    ctx.setMaxFramesInFlight(0);
+    GLEX_CHECK(ctx.pollFrameSlot());
+
+    // 渲染线程停止后关闭投递：post 返回 false 而不是让任务悄悄丢失（同步等待者据此回退到调用方执行）
+    {
+        ctx.clearCurrent();
+        glex::RenderThread thread;
+        thread.start(&ctx, [](float) {});
+        std::atomic<int> ran{0};
+        GLEX_CHECK(thread.post([&ran]() { ran.fetch_add(1); }, glex::TaskPriority::Urgent));
+        thread.stop();
+        GLEX_CHECK(ran.load() == 1);
+        GLEX_CHECK(!thread.post([&ran]() { ran.fetch_add(1); }));
+        GLEX_CHECK(ran.load() == 1);
+        ctx.makeCurrent();
+    }
+
+    ctx.destroy();
+    return GLEX_TEST_RESULT();
+}
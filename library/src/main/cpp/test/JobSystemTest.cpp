@@ -0,0 +1,80 @@
+/**
+ * JobSystem 测试：parallelFor 覆盖每个元素恰好一次；grainFor 让调用方与每个工作线程都分到块；
+ * 任务依赖按顺序执行；等待其他线程上的长任务时调用方挂起而不是空转
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+#include "glex/JobSystem.h"
+#include "TestCheck.h"
+
+int main()
+{
+    glex::JobSystem& jobs = glex::JobSystem::Get();
+    const size_t lanes = jobs.getWorkerCount() + 1;
+
+    // 每个元素恰好被访问一次（块大小不整除区间长度）
+    std::vector<std::atomic<int>> hits(1000);
+    jobs.parallelFor(0, hits.size(), 7, [&hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    int wrong = 0;
+    for (auto& h : hits) {
+        wrong += h.load() != 1 ? 1 : 0;
+    }
+    GLEX_CHECK(wrong == 0);
+
+    // AttackPass 的规模：块数等于可用线程数（受最小块大小限制）
+    const size_t particles = 1800;
+    const size_t minGrain = 128;
+    size_t grain = jobs.grainFor(particles, minGrain);
+    size_t chunks = (particles + grain - 1) / grain;
+    size_t maxChunks = (particles + minGrain - 1) / minGrain;
+    GLEX_CHECK(grain >= minGrain);
+    GLEX_CHECK(chunks == (lanes < maxChunks ? lanes : maxChunks));
+    // 元素太少时不切分
+    GLEX_CHECK(jobs.grainFor(100, minGrain) >= 100);
+
+    // 依赖：b 在 a 之后执行
+    std::atomic<int> order{0};
+    int aSeen = -1;
+    int bSeen = -1;
+    glex::JobHandle a = jobs.submit([&]() { aSeen = order.fetch_add(1); });
+    glex::JobHandle b = jobs.submit([&]() { bSeen = order.fetch_add(1); }, { a });
+    jobs.wait(b);
+    GLEX_CHECK(aSeen == 0);
+    GLEX_CHECK(bSeen == 1);
+
+    // 目标任务在工作线程上执行时，调用方短暂自旋后挂起：等待 200ms 只占用少量 CPU 时间
+    double waitCpuMs = 0.0;
+    if (jobs.getWorkerCount() > 0) {
+        std::atomic<bool> started{false};
+        glex::JobHandle slow = jobs.submit([&started]() {
+            started.store(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        });
+        while (!started.load()) {
+            std::this_thread::yield();
+        }
+        timespec before {};
+        timespec after {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &before);
+        jobs.wait(slow);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &after);
+        waitCpuMs = (after.tv_sec - before.tv_sec) * 1000.0 + (after.tv_nsec - before.tv_nsec) / 1e6;
+        GLEX_CHECK(slow.isDone());
+        GLEX_CHECK(waitCpuMs < 50.0);
+    }
+
+    std::printf("JobSystem: wait cpu %.2f ms\n", waitCpuMs);
+    std::printf("JobSystem: %zu lanes, grain %zu -> %zu chunks\n", lanes, grain, chunks);
+    return GLEX_TEST_RESULT();
+}
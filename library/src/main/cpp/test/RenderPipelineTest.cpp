@@ -0,0 +1,149 @@
+/**
+ * RenderPipeline 流水线测试：触摸、尺寸变化、增删 Pass、切换流水线时等待进行中的模拟，
+ * 但已完成的模拟必须在下一次 update 发布而不是重新模拟——双缓冲 Pass 每帧恰好推进一次；
+ * 固定步长下流水线 Pass 拿到的插值系数与其发布的数据属于同一帧
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "glex/GLContext.h"
+#include "glex/RenderPipeline.h"
+#include "TestCheck.h"
+
+namespace {
+
+constexpr float kDt = 0.01f;
+
+// 记录模拟时间：update 推进，prepareRender 写入后缓冲，publish 交换到前缓冲
+class CountingPass : public glex::RenderPass {
+public:
+    explicit CountingPass(const char* name) : RenderPass(name)
+    {
+        parallelUpdateSafe_ = true;
+        doubleBuffered_ = true;
+    }
+
+    int simulatedSteps() const { return steps_; }
+    int publishedSteps() const { return front_; }
+    float renderedAlpha() const { return alpha_; }
+
+protected:
+    void onInitialize(int, int) override {}
+    void onUpdate(float) override { steps_++; }
+    void onPrepareRender() override { back_ = steps_; }
+    void onPublish() override { front_ = back_; }
+    void onRender() override { alpha_ = getInterpolationAlpha(); }
+    void onDestroy() override {}
+
+private:
+    float alpha_ = -1.0f;
+    int steps_ = 0;
+    int back_ = 0;
+    int front_ = 0;
+};
+
+// 一帧：update 之后、下一次 update 之前发生的事件都会 waitForUpdate
+void Frame(glex::RenderPipeline& pipeline, bool touch)
+{
+    pipeline.update(kDt);
+    if (touch) {
+        pipeline.dispatchTouch(10.0f, 10.0f, 1, 0);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    glex::GLContext ctx;
+    if (!ctx.initializeOffscreen(64, 64)) {
+        std::fprintf(stderr, "initializeOffscreen failed\n");
+        return 1;
+    }
+
+    for (bool parallel : { false, true }) {
+        glex::RenderPipeline pipeline;
+        pipeline.setParallelUpdate(parallel);
+        pipeline.setPipelined(true);
+        auto a = std::make_shared<CountingPass>("A");
+        pipeline.addPass(a);
+        pipeline.initialize(64, 64);
+
+        // 每帧都有触摸（拖动）：仍然每帧只推进一步，模拟领先发布一帧
+        for (int i = 0; i < 100; i++) {
+            Frame(pipeline, true);
+        }
+        GLEX_CHECK(a->publishedSteps() == 100);
+        GLEX_CHECK(a->simulatedSteps() == 101);
+
+        // 尺寸变化、中途加入的 Pass
+        pipeline.resize(32, 32);
+        auto b = std::make_shared<CountingPass>("B");
+        pipeline.addPass(b);
+        for (int i = 0; i < 50; i++) {
+            Frame(pipeline, i % 2 == 0);
+        }
+        GLEX_CHECK(a->publishedSteps() == 150);
+        GLEX_CHECK(b->publishedSteps() == 50);
+
+        // 关闭流水线：已准备好的一帧照常发布，之后串行，仍是每帧一步
+        pipeline.setPipelined(false);
+        for (int i = 0; i < 10; i++) {
+            Frame(pipeline, true);
+        }
+        GLEX_CHECK(a->publishedSteps() == 160);
+        GLEX_CHECK(a->simulatedSteps() == 160);
+        GLEX_CHECK(b->publishedSteps() == 60);
+
+        // 再次开启
+        pipeline.setPipelined(true);
+        for (int i = 0; i < 10; i++) {
+            Frame(pipeline, true);
+        }
+        GLEX_CHECK(a->publishedSteps() == 170);
+        GLEX_CHECK(a->simulatedSteps() == 171);
+
+        pipeline.removePass("B");
+        Frame(pipeline, true);
+        GLEX_CHECK(a->publishedSteps() == 171);
+        pipeline.destroy();
+    }
+
+    // 固定步长 60Hz、帧间隔 1/90 s：流水线 Pass 第 N 帧的插值系数等于串行时第 N-1 帧的
+    {
+        glex::RenderPipeline serial;
+        glex::RenderPipeline pipelined;
+        auto s = std::make_shared<CountingPass>("S");
+        auto p = std::make_shared<CountingPass>("P");
+        serial.addPass(s);
+        pipelined.addPass(p);
+        pipelined.setPipelined(true);
+        for (glex::RenderPipeline* pipeline : { &serial, &pipelined }) {
+            pipeline->setFixedTimestep(1.0f / 60.0f);
+            pipeline->initialize(64, 64);
+        }
+        float previousAlpha = -1.0f;
+        int previousSteps = 0;
+        int mismatches = 0;
+        for (int i = 0; i < 30; i++) {
+            serial.update(1.0f / 90.0f);
+            serial.render();
+            pipelined.update(1.0f / 90.0f);
+            pipelined.render();
+            if (i > 0 && (std::fabs(p->renderedAlpha() - previousAlpha) > 1e-5f ||
+                          p->publishedSteps() != previousSteps)) {
+                mismatches++;
+            }
+            previousAlpha = s->renderedAlpha();
+            previousSteps = s->publishedSteps();
+        }
+        GLEX_CHECK(mismatches == 0);
+        serial.destroy();
+        pipelined.destroy();
+    }
+
+    ctx.destroy();
+    return GLEX_TEST_RESULT();
+}
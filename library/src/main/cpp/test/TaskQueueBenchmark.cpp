@@ -0,0 +1,124 @@
+/**
+ * TaskQueue 微基准：N 个生产者并发投递、单消费者取出执行的吞吐，
+ * 与此前的 mutex + std::vector<std::function<void()>> 方案对比。
+ *
+ *   ./glex_task_queue_benchmark [tasksPerProducer]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "glex/TaskQueue.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 此前 RenderThread 的实现：加锁 push_back，消费者整体 swap 出来执行
+class MutexVectorQueue {
+public:
+    void post(std::function<void()> fn)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(fn));
+    }
+
+    size_t drain()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            local_.swap(tasks_);
+        }
+        size_t n = local_.size();
+        for (auto& fn : local_) {
+            fn();
+        }
+        local_.clear();
+        return n;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::function<void()>> tasks_;
+    std::vector<std::function<void()>> local_;
+};
+
+template <typename Post, typename Drain>
+double Run(int producers, int tasksPerProducer, Post post, Drain drain)
+{
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < tasksPerProducer; i++) {
+                post(p, i);
+            }
+        });
+    }
+    const uint64_t total = static_cast<uint64_t>(producers) * tasksPerProducer;
+    uint64_t done = 0;
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    while (done < total) {
+        size_t n = drain();
+        done += n;
+        if (n == 0) {
+            std::this_thread::yield();   // 空闲时让出 CPU（渲染线程在帧间同样不会空转）
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& t : threads) {
+        t.join();
+    }
+    return static_cast<double>(total) / seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int tasksPerProducer = argc > 1 ? std::atoi(argv[1]) : 500000;
+    if (tasksPerProducer <= 0) {
+        tasksPerProducer = 500000;
+    }
+    std::atomic<uint64_t> sink{0};
+
+    std::printf("%-10s %16s %16s\n", "producers", "TaskQueue M/s", "mutex+vector M/s");
+    for (int producers : { 1, 2, 4, 8 }) {
+        glex::TaskQueue queue(1024);
+        double lockFree = Run(producers, tasksPerProducer,
+            [&](int p, int i) {
+                glex::QueuedTask item;
+                item.task = glex::Task([&sink, p, i]() { sink.fetch_add(p + i, std::memory_order_relaxed); });
+                while (!queue.tryPush(item)) {
+                    std::this_thread::yield();
+                }
+            },
+            [&]() {
+                size_t n = 0;
+                glex::QueuedTask item;
+                while (queue.tryPop(item)) {
+                    item.task();
+                    n++;
+                }
+                return n;
+            });
+
+        MutexVectorQueue locked;
+        double mutexVector = Run(producers, tasksPerProducer,
+            [&](int p, int i) { locked.post([&sink, p, i]() { sink.fetch_add(p + i, std::memory_order_relaxed); }); },
+            [&]() { return locked.drain(); });
+
+        std::printf("%-10d %16.2f %16.2f\n", producers, lockFree, mutexVector);
+    }
+    return sink.load() == 0 ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * TaskQueue 压力测试：多生产者并发入队，单消费者出队执行
+ *   - 每个任务恰好执行一次，且同一生产者的任务按入队顺序执行
+ *   - 内联任务的入队 / 出队 / 执行不分配堆内存
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "glex/TaskQueue.h"
+#include "TestCheck.h"
+
+namespace {
+
+std::atomic<bool> g_countAllocations{false};
+std::atomic<uint64_t> g_allocations{0};
+
+constexpr int kProducers = 4;
+constexpr int kTasksPerProducer = 200000;
+
+struct Record {
+    std::vector<int> lastSeq = std::vector<int>(kProducers, -1);
+    uint64_t executed = 0;
+    uint64_t outOfOrder = 0;
+};
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    glex::TaskQueue queue(256);   // 容量远小于任务总数，反复经历队满
+    Record record;
+    std::atomic<int> started{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([&queue, &record, &started, p]() {
+            started.fetch_add(1);
+            while (started.load() < kProducers) {
+                std::this_thread::yield();
+            }
+            for (int seq = 0; seq < kTasksPerProducer; seq++) {
+                glex::QueuedTask item;
+                item.task = glex::Task([&record, p, seq]() {
+                    if (record.lastSeq[p] + 1 != seq) {
+                        record.outOfOrder++;
+                    }
+                    record.lastSeq[p] = seq;
+                    record.executed++;
+                });
+                while (!queue.tryPush(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // 入队前已创建好线程：此后的任务构造、入队、出队、执行都不应分配
+    g_countAllocations.store(true);
+    const uint64_t total = static_cast<uint64_t>(kProducers) * kTasksPerProducer;
+    glex::QueuedTask item;
+    while (record.executed < total) {
+        if (queue.tryPop(item)) {
+            item.task();
+            item.task.reset();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    g_countAllocations.store(false);
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    GLEX_CHECK(record.executed == total);
+    GLEX_CHECK(record.outOfOrder == 0);
+    for (int p = 0; p < kProducers; p++) {
+        GLEX_CHECK(record.lastSeq[p] == kTasksPerProducer - 1);
+    }
+    GLEX_CHECK(!queue.tryPop(item));
+    GLEX_CHECK(g_allocations.load() == 0);
+    std::printf("TaskQueue stress: %llu tasks, %llu allocations\n",
+                static_cast<unsigned long long>(record.executed),
+                static_cast<unsigned long long>(g_allocations.load()));
+    return GLEX_TEST_RESULT();
+}
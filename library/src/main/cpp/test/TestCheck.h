@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @file TestCheck.h
+ * @brief 离屏回归测试共用的断言宏（失败时打印位置并计数，main 以失败数作为返回码）
+ */
+
+#include <cstdio>
+
+namespace glex {
+namespace test {
+
+inline int& FailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+} // namespace test
+} // namespace glex
+
+#define GLEX_CHECK(cond)                                                                \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ::glex::test::FailureCount()++;                                             \
+        }                                                                               \
+    } while (0)
+
+#define GLEX_TEST_RESULT() (::glex::test::FailureCount() == 0 ? 0 : 1)
@@ -0,0 +1,98 @@
+/**
+ * ThreadPolicy 测试：策略是完整描述，重新应用默认策略会撤销之前的绑核、nice 与实时调度
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "glex/ThreadPolicy.h"
+#include "TestCheck.h"
+
+namespace {
+
+int CurrentNice()
+{
+    return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+}
+
+int CurrentAffinityCount()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return -1;
+    }
+    return CPU_COUNT(&set);
+}
+
+int CurrentSchedPolicy()
+{
+    int policy = SCHED_OTHER;
+    sched_param param {};
+    pthread_getschedparam(pthread_self(), &policy, &param);
+    return policy;
+}
+
+} // namespace
+
+int main()
+{
+    const int initialCpus = CurrentAffinityCount();
+    GLEX_CHECK(initialCpus > 0);
+
+    // 默认策略：已是默认状态时不报错
+    std::string error;
+    GLEX_CHECK(glex::ApplyThreadPolicy(glex::ThreadPolicy(), &error));
+    GLEX_CHECK(error.empty());
+
+    // 绑核后再应用默认策略：恢复到全部 CPU
+    glex::ThreadPolicy pinned;
+    pinned.cpus = {0};
+    GLEX_CHECK(glex::ApplyThreadPolicy(pinned));
+    GLEX_CHECK(CurrentAffinityCount() == 1);
+    GLEX_CHECK(glex::ApplyThreadPolicy(glex::ThreadPolicy()));
+    GLEX_CHECK(CurrentAffinityCount() == initialCpus);
+
+    // 调高 nice 后再应用默认策略：恢复为 0（降低 nice 需要权限，无权限时应报告失败）
+    glex::ThreadPolicy lowered;
+    lowered.setNice = true;
+    lowered.nice = 5;
+    GLEX_CHECK(glex::ApplyThreadPolicy(lowered));
+    GLEX_CHECK(CurrentNice() == 5);
+    error.clear();
+    bool restored = glex::ApplyThreadPolicy(glex::ThreadPolicy(), &error);
+    GLEX_CHECK(restored ? CurrentNice() == 0 : error.find("setpriority") != std::string::npos);
+
+    // 实时调度（有权限时）：应用默认策略后回到 SCHED_OTHER
+    glex::ThreadPolicy realtime;
+    realtime.realtime = true;
+    bool realtimeApplied = glex::ApplyThreadPolicy(realtime) && CurrentSchedPolicy() == SCHED_FIFO;
+    if (realtimeApplied) {
+        GLEX_CHECK(glex::ApplyThreadPolicy(glex::ThreadPolicy()));
+        GLEX_CHECK(CurrentSchedPolicy() == SCHED_OTHER);
+    }
+
+    // 只命名：不改变之前应用的绑核与 nice
+    glex::ThreadPolicy configured;
+    configured.cpus = {0};
+    configured.setNice = true;
+    configured.nice = 3;
+    GLEX_CHECK(glex::ApplyThreadPolicy(configured));
+    GLEX_CHECK(glex::SetCurrentThreadName("GLEXNameOnlyTest"));
+    char name[16] = {};
+    GLEX_CHECK(pthread_getname_np(pthread_self(), name, sizeof(name)) == 0);
+    GLEX_CHECK(std::string(name) == "GLEXNameOnlyTes");
+    GLEX_CHECK(CurrentAffinityCount() == 1);
+    GLEX_CHECK(CurrentNice() == 3);
+    glex::ApplyThreadPolicy(glex::ThreadPolicy());
+
+    std::printf("ThreadPolicy: %d cpus, nice restored %d, realtime %d\n", initialCpus, restored ? 1 : 0,
+                realtimeApplied ? 1 : 0);
+    return GLEX_TEST_RESULT();
+}
@@ -6,6 +6,7 @@ declare module '@yunshen1933/ohos_glex' {
     renderer: string;
     width: number;
     height: number;
+    shareGroup: boolean;
   }
 
   export interface GpuStats {
@@ -16,8 +17,117 @@ declare module '@yunshen1933/ohos_glex' {
     textures: number;
   }
 
+  export interface CaptureResult {
+    id: number;
+    width: number;
+    height: number;
+    pixels: ArrayBuffer;
+  }
+
+  export interface RenderResolution {
+    scale: number;
+    width: number;
+    height: number;
+    dynamic: boolean;
+  }
+
+  export interface StreamOptions {
+    width?: number;
+    height?: number;
+    queueSize?: number;
+  }
+
+  export interface StreamFrame {
+    seq: number;
+    timestamp: number;
+    width: number;
+    height: number;
+    pixels: ArrayBuffer;
+  }
+
+  export interface StreamStats {
+    running: boolean;
+    captured: number;
+    delivered: number;
+    dropped: number;
+    droppedGpuBusy: number;
+    droppedQueueFull: number;
+    droppedByConsumer: number;
+  }
+
+  export interface TouchSourceStats {
+    events: number;
+    avgDelayMs: number;
+    maxDelayMs: number;
+  }
+
+  export interface TouchStats {
+    nativeActive: boolean;
+    native: TouchSourceStats;
+    arkts: TouchSourceStats;
+    avgDispatchDelayMs: number;
+    delivered: number;
+    overflows: number;
+  }
+
+  export interface FramePhaseStats {
+    p50: number;
+    p90: number;
+    p99: number;
+    max: number;
+  }
+
+  export interface FramePhaseTimings {
+    taskDrain: FramePhaseStats;
+    passChanges: FramePhaseStats;
+    update: FramePhaseStats;
+    render: FramePhaseStats;
+    swap: FramePhaseStats;
+    gpuWait: FramePhaseStats;
+    frame: FramePhaseStats;
+  }
+
+  export interface FrameStats {
+    samples: number;
+    fps: number;
+    missedFrames: number;
+    cpu: number;
+    migrations: number;
+    partialFrames: number;
+    skippedSwaps: number;
+    maxFramesInFlight: number;
+    gpuWaitMs: number;
+    gpuWaitFrames: number;
+    gpuBusySkips: number;
+    touchEvents: number;
+    touchOverflows: number;
+    phases: FramePhaseTimings;
+  }
+
+  export interface FrameRateStep {
+    timeMs: number;
+    fromFps: number;
+    toFps: number;
+    workP90Ms: number;
+    overBudgetRatio: number;
+  }
+
+  export interface RenderThreadPolicy {
+    cpus?: number[];
+    performanceCores?: boolean;
+    nice?: number;
+    realtime?: boolean;
+    realtimePriority?: number;
+    name?: string;
+  }
+  
   export interface ResourceManagerHandle {}
 
+  export enum RenderMode {
+    Continuous = 0,
+    OnDemand = 1
+  }
+
   export interface GLEXComponentParams {
     targetFPS?: number;
     clearColor?: number[];
@@ -52,6 +162,20 @@ declare module '@yunshen1933/ohos_glex' {
     unbindXComponent(): void;
     setSurfaceId(surfaceId: string | number | bigint): void;
     setTargetFPS(fps: number): void;
+    setRenderMode(mode: RenderMode): void;
+    requestRender(): void;
+    setAdaptiveFrameRate(enabled: boolean, ladder?: number[]): void;
+    setParallelUpdate(enabled: boolean): void;
+    setPipelinedUpdate(enabled: boolean): void;
+    setFixedTimestep(updatesPerSecond: number, maxStepsPerFrame?: number): void;
+    setSharedRenderThread(enabled: boolean, threadCount?: number): void;
+    setShareGroup(enabled: boolean): void;
+    setPartialPresent(enabled: boolean): void;
+    setMaxFramesInFlight(frames: number): void;
+    setResolutionScale(scale: number): void;
+    setDynamicResolution(enabled: boolean, minScale?: number, maxScale?: number): void;
+    getRenderResolution(): RenderResolution;
+    setRenderThreadPolicy(policy: RenderThreadPolicy): void;
     resize(width: number, height: number): void;
     setBackgroundColor(r: number, g: number, b: number, a?: number): void;
     startRender(): void;
@@ -60,18 +184,47 @@ declare module '@yunshen1933/ohos_glex' {
     setShaderSources(vertexShader: string, fragmentShader: string): void;
     loadShaderFromRawfile(resourceManager: ResourceManagerHandle, vertexPath: string, fragmentPath: string): void;
     loadRawfileBytes(resourceManager: ResourceManagerHandle, path: string): ArrayBuffer;
-    setUniform(name: string, value: number | number[]): void;
+    setUniform(name: string, value: number | number[] | Float32Array): void;
+    getUniformHandle(name: string): number;
+    setUniformByHandle(handle: number, value: Float32Array | number): boolean;
+    submitCommands(commands: ArrayBuffer | Uint8Array): number;
     setPasses(passes: string[]): void;
     addPass(name: string): void;
     removePass(name: string): void;
     getPasses(): string[];
-    setTouchEvent(x: number, y: number, action: number, pointerId?: number): void;
+    setTouchEvent(x: number, y: number, action: number, pointerId?: number, timestamp?: number): boolean;
+    setNativeTouch(enabled: boolean): void;
+    getTouchStats(): TouchStats;
     getCurrentFPS(): number;
+    getMissedFrames(): number;
+    getFrameStats(): FrameStats;
+    getFrameRateSteps(): FrameRateStep[];
     getGLInfo(): GLInfo;
     getGpuStats(): GpuStats;
+    setProfilerEnabled(enabled: boolean): void;
+    getProfilerTrace(): string;
+    saveProfilerTrace(path: string): boolean;
+    requestCapture(x?: number, y?: number, width?: number, height?: number): number;
+    takeCapture(id: number): CaptureResult | null | undefined;
+    startStreamCapture(options: StreamOptions, callback: (frame: StreamFrame) => void): void;
+    stopStreamCapture(): void;
+    getStreamStats(): StreamStats;
     getLastError(): string;
     clearLastError(): void;
   }
 
   export function createGlexRenderer(): GlexNativeInstance;
+
+  export class GlexCommandEncoder {
+    constructor(initialCapacity?: number);
+    readonly commandCount: number;
+    readonly byteLength: number;
+    setUniform(name: string, value: number | number[] | Float32Array): GlexCommandEncoder;
+    setUniformByHandle(handle: number, value: number | number[] | Float32Array): GlexCommandEncoder;
+    touch(x: number, y: number, action: number, pointerId?: number, timestamp?: number): GlexCommandEncoder;
+    setPassEnabled(name: string, enabled: boolean): GlexCommandEncoder;
+    setClearColor(r: number, g: number, b: number, a?: number): GlexCommandEncoder;
+    finish(): Uint8Array;
+    reset(): void;
+  }
 }
@@ -35,6 +35,94 @@ declare module 'libglex.so' {
     /** 设置目标帧率 */
     setTargetFPS(fps: number): void;
 
+    /**
+     * 设置渲染模式
+     * @param mode 0 = 持续渲染（默认），1 = 按需渲染：仅在 Pass/Uniform/触摸/尺寸变化或 requestRender() 后绘制，
+     *             画面静止时渲染线程挂起
+     */
+    setRenderMode(mode: number): void;
+
+    /** 按需渲染模式下请求绘制一帧 */
+    requestRender(): void;
+
+    /**
+     * 启用/禁用自适应帧率
+     * 跟不上预算时以 setTargetFPS 为上限沿阶梯降档，稳定后逐档回升
+     * @param ladder 帧率阶梯，默认 [120, 90, 60, 45, 30]
+     */
+    setAdaptiveFrameRate(enabled: boolean, ladder?: number[]): void;
+
+    /** 启用/禁用 Pass 并行更新（相互独立的 Pass 在工作线程上同时执行 onUpdate） */
+    setParallelUpdate(enabled: boolean): void;
+
+    /**
+     * 启用/禁用流水线更新：下一帧的模拟在工作线程上与本帧渲染重叠执行
+     * 仅对双缓冲的 Pass（DemoPass、AttackPass）生效，画面延迟增加一帧
+     */
+    setPipelinedUpdate(enabled: boolean): void;
+
+    /**
+     * 固定步长模拟：每帧按 1 / updatesPerSecond 秒的步长执行 0 到 maxStepsPerFrame 次更新
+     * 卡顿后超出上限的时间直接丢弃；updatesPerSecond 为 0 时恢复按帧间隔更新
+     * @param maxStepsPerFrame 默认 4
+     */
+    setFixedTimestep(updatesPerSecond: number, maxStepsPerFrame?: number): void;
+
+    /**
+     * 由进程级共享渲染线程驱动本实例（多个 GLEX 视图同屏时减少线程数与上下文切换）
+     * 运行中切换会重启渲染循环，Pass 与 GL 资源保留
+     * @param threadCount 共享工作线程数上限（进程级，默认 1，只影响之后加入的实例）
+     */
+    setSharedRenderThread(enabled: boolean, threadCount?: number): void;
+
+    /**
+     * 加入进程级 EGL 共享组：内置 Pass 的着色器程序与静态缓冲在实例间复用，
+     * 视图增加时编译次数与显存占用不再线性增长（下一次创建 Surface 时生效）
+     */
+    setShareGroup(enabled: boolean): void;
+
+    /**
+     * 局部呈现：按缓冲区年龄只重绘损坏区域，支持时以 eglSwapBuffersWithDamage 提交，
+     * 画面无变化时跳过交换（默认关闭；存在不上报损坏的 Pass 时仍整帧重绘）
+     */
+    setPartialPresent(enabled: boolean): void;
+
+    /**
+     * 帧在途上限：每帧交换前插入 glFenceSync，下一帧开始（读取输入）前等待 N 帧前的栅栏，
+     * 限制 CPU 领先 GPU 的帧数。N 为 1 - 3，越小输入延迟越低、吞吐越低；0 表示不限制（默认）
+     * 等待耗时见 getFrameStats() 的 phases.gpuWait 与 gpuWaitMs
+     */
+    setMaxFramesInFlight(frames: number): void;
+
+    /**
+     * 固定渲染缩放系数 (0, 1]（关闭动态分辨率）：小于 1 时渲染到缩小的离屏目标，
+     * 再线性放大到窗口；Pass 的 getWidth()/getHeight() 与触摸坐标随之缩放
+     */
+    setResolutionScale(scale: number): void;
+
+    /**
+     * 动态分辨率：按 GPU 帧耗时（不支持计时查询时按渲染 CPU 耗时）在 [minScale, maxScale]
+     * 内自动调节缩放系数（默认 0.5 - 1），超出帧预算时降低、富余时逐级回升
+     */
+    setDynamicResolution(enabled: boolean, minScale?: number, maxScale?: number): void;
+
+    /** 获取当前渲染分辨率（缩放系数与 Pass 看到的尺寸） */
+    getRenderResolution(): { scale: number; width: number; height: number; dynamic: boolean };
+
+    /**
+     * 设置渲染线程调度策略（下一帧生效，重启渲染后保留）
+     * cpus 指定绑定的 CPU；performanceCores 自动绑定到非小核；
+     * nice 范围 [-20, 19]；realtime 尝试 SCHED_FIFO，无权限时回退到 nice；name 最长 15 字节
+     */
+    setRenderThreadPolicy(policy: {
+      cpus?: number[];
+      performanceCores?: boolean;
+      nice?: number;
+      realtime?: boolean;
+      realtimePriority?: number;
+      name?: string;
+    }): void;
+
     /** 设置自定义着色器源码（仅支持 ES 3.0+） */
     setShaderSources(vertexShader: string, fragmentShader: string): void;
 
@@ -44,8 +132,28 @@ declare module 'libglex.so' {
     /** 从 Rawfile 加载二进制数据（优先 mmap 零拷贝） */
     loadRawfileBytes(resourceManager: object, path: string): ArrayBuffer;
 
-    /** 设置自定义 Uniform（number 或 number[]） */
-    setUniform(name: string, value: number | number[]): void;
+    /** 设置自定义 Uniform（number、number[] 或 Float32Array；数组 uniform 传全部分量） */
+    setUniform(name: string, value: number | number[] | Float32Array): void;
+
+    /**
+     * 获取 Uniform 句柄（同名返回同一句柄，着色器重新编译后仍有效）
+     * @returns 句柄，失败时为 -1
+     */
+    getUniformHandle(name: string): number;
+
+    /**
+     * 按句柄设置 Uniform：直接读取 Float32Array 的底层存储，不做名字查找与逐元素转换，
+     * 适合每帧更新的大数组（如 mat4[]、vec4[64]）
+     * @returns 句柄无效或分量数超过上限（4096）时为 false
+     */
+    setUniformByHandle(handle: number, value: Float32Array | number): boolean;
+
+    /**
+     * 批量提交命令（set-uniform / touch / pass 开关 / 清屏颜色），由 GlexCommandEncoder 编码
+     * 整批校验后在下一帧开始时一次性应用；格式错误时整批拒绝
+     * @returns 接受的命令数，拒绝时为 -1（原因见 getLastError）
+     */
+    submitCommands(commands: ArrayBuffer | Uint8Array): number;
 
     /** 设置 Pass 列表（按顺序） */
     setPasses(passes: string[]): void;
@@ -59,8 +167,29 @@ declare module 'libglex.so' {
     /** 获取当前 Pass 列表（配置层面） */
     getPasses(): string[];
 
-    /** 传递触摸事件（由 ArkTS 调用） */
-    setTouchEvent(x: number, y: number, action: number, pointerId?: number): void;
+    /**
+     * 传递触摸事件（由 ArkTS 调用）
+     * 每个事件按到达顺序分发给 Pass，不会被下一个事件覆盖
+     * @param timestamp 事件时间戳（纳秒，单调时钟，即 TouchEvent.timestamp），缺省取当前时刻
+     * @returns false 表示 XComponent 原生触摸回调已在投递事件，本次调用只计入统计，可停止转发
+     */
+    setTouchEvent(x: number, y: number, action: number, pointerId?: number, timestamp?: number): boolean;
+
+    /**
+     * 是否由 XComponent 原生触摸回调直接投递事件（默认开启）
+     * 开启后收到第一个原生事件起忽略 setTouchEvent 转发的事件；关闭后回退到 ArkTS 转发
+     */
+    setNativeTouch(enabled: boolean): void;
+
+    /** 获取触摸输入统计：各来源的事件数与事件时间戳到入队的延迟（毫秒），以及入队到分发的平均延迟 */
+    getTouchStats(): {
+      nativeActive: boolean;
+      native: { events: number; avgDelayMs: number; maxDelayMs: number };
+      arkts: { events: number; avgDelayMs: number; maxDelayMs: number };
+      avgDispatchDelayMs: number;
+      delivered: number;
+      overflows: number;
+    };
 
     // ============================================================
     // 状态查询
@@ -69,12 +198,51 @@ declare module 'libglex.so' {
     /** 获取当前实际帧率 */
     getCurrentFPS(): number;
 
-    /** 获取 GL 信息（版本、渲染器、尺寸） */
+    /** 获取本次启动以来错过的帧截止时间数 */
+    getMissedFrames(): number;
+
+    /** 获取最近帧的分阶段耗时分位统计（毫秒） */
+    getFrameStats(): {
+      samples: number;
+      fps: number;
+      missedFrames: number;
+      cpu: number;
+      migrations: number;
+      partialFrames: number;
+      skippedSwaps: number;
+      maxFramesInFlight: number;
+      gpuWaitMs: number;
+      gpuWaitFrames: number;
+      gpuBusySkips: number;
+      touchEvents: number;
+      touchOverflows: number;
+      phases: {
+        taskDrain: { p50: number; p90: number; p99: number; max: number };
+        passChanges: { p50: number; p90: number; p99: number; max: number };
+        update: { p50: number; p90: number; p99: number; max: number };
+        render: { p50: number; p90: number; p99: number; max: number };
+        swap: { p50: number; p90: number; p99: number; max: number };
+        gpuWait: { p50: number; p90: number; p99: number; max: number };
+        frame: { p50: number; p90: number; p99: number; max: number };
+      };
+    };
+
+    /** 获取自适应帧率的档位切换记录（最近 64 次） */
+    getFrameRateSteps(): Array<{
+      timeMs: number;
+      fromFps: number;
+      toFps: number;
+      workP90Ms: number;
+      overBudgetRatio: number;
+    }>;
+
+    /** 获取 GL 信息（版本、渲染器、尺寸、是否在共享组中） */
     getGLInfo(): {
       version: string;
       renderer: string;
       width: number;
       height: number;
+      shareGroup: boolean;
     };
 
     /** 获取 GPU 资源统计（program/shader/buffer/vao/texture） */
@@ -86,6 +254,56 @@ declare module 'libglex.so' {
       textures: number;
     };
 
+    /**
+     * 开关逐 Pass 剖析：记录各 Pass update / prepareRender / render 的 CPU 耗时，
+     * render 另以 EXT_disjoint_timer_query 异步记录 GPU 耗时（不支持时只有 CPU）
+     * 以 GLEX_ENABLE_PROFILER=OFF 编译时开启会失败（getLastError 可查）
+     */
+    setProfilerEnabled(enabled: boolean): void;
+
+    /** 导出最近的剖析记录（Chrome Trace JSON，可在 chrome://tracing 或 Perfetto 中打开） */
+    getProfilerTrace(): string;
+
+    /** 把剖析记录写入文件（如应用沙箱 filesDir 下的路径），成功返回 true */
+    saveProfilerTrace(path: string): boolean;
+
+    /**
+     * 请求异步截图（下一次绘制完成后经 PBO 读取，几帧后取回，不阻塞渲染线程）
+     * 不传区域时截取整个画面；区域为左上原点的像素坐标，超出画面部分被裁掉
+     * @returns 截图 id；排队的请求过多时返回 -1
+     */
+    requestCapture(x?: number, y?: number, width?: number, height?: number): number;
+
+    /**
+     * 取回截图：未完成返回 undefined，失败或 id 无效返回 null
+     * pixels 为 RGBA8、行自上而下排列的外部 ArrayBuffer（原生内存，无额外拷贝）
+     */
+    takeCapture(id: number): { id: number; width: number; height: number; pixels: ArrayBuffer } | null | undefined;
+
+    /**
+     * 开始连续帧采集（录屏）：每帧绘制后在 GPU 上缩放到 width x height（省略一边时等比），
+     * 经 PBO 轮转异步读取，推入容量为 queueSize（默认 8）的无锁队列，由工作线程投递给 callback
+     * 渲染线程从不等待：跟不上的帧被丢弃并计入 getStreamStats() 的丢帧计数
+     */
+    startStreamCapture(
+      options: { width?: number; height?: number; queueSize?: number },
+      callback: (frame: { seq: number; timestamp: number; width: number; height: number; pixels: ArrayBuffer }) => void
+    ): void;
+
+    /** 停止连续帧采集（未投递的帧被丢弃） */
+    stopStreamCapture(): void;
+
+    /** 获取连续帧采集统计（停止后保留最后一次采集的计数） */
+    getStreamStats(): {
+      running: boolean;
+      captured: number;
+      delivered: number;
+      dropped: number;
+      droppedGpuBusy: number;
+      droppedQueueFull: number;
+      droppedByConsumer: number;
+    };
+
     /** 获取最近一次错误信息（空字符串表示无错误） */
     getLastError(): string;
 